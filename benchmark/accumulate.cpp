@@ -0,0 +1,54 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/accumulate.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename T, typename F>
+void measure_and_print(std::string const& name, size_t n, F f) {
+	volatile T res{};
+	auto t = measure_nullary<100>([]() {}, [&]() { res = f(); });
+	cout << '\t' << name << ";" << n << ";" << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << endl;
+}
+
+int main() {
+	using tao::algorithm::simd_isa;
+	char const* isa_names[] = {"scalar", "sse2", "avx2", "avx512"};
+
+	for (size_t n = 1024; n <= 4 * 1024 * 1024; n *= 16) {
+		vector<int32_t> a(n);
+		vector<double> d(n);
+		iota(begin(a), end(a), 0);
+		iota(begin(d), end(d), 0.0);
+
+		cout << "data size: " << n << ";" << endl;
+
+		measure_and_print<int32_t>("std::accumulate int32_t", n, [&]() {
+			return std::accumulate(begin(a), end(a), int32_t(0)); });
+		measure_and_print<double>("std::accumulate double", n, [&]() {
+			return std::accumulate(begin(d), end(d), 0.0); });
+
+		for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+			tao::algorithm::set_simd_isa_limit(isa);
+			if (tao::algorithm::simd_isa_level() != isa) continue;
+			string suffix = string(" ") + isa_names[int(isa)];
+
+			measure_and_print<int32_t>("accumulate int32_t" + suffix, n, [&]() {
+				return tao::algorithm::accumulate(begin(a), end(a), int32_t(0), std::plus<>()); });
+			measure_and_print<double>("accumulate_unordered double" + suffix, n, [&]() {
+				return tao::algorithm::accumulate_unordered(begin(d), end(d), 0.0, std::plus<>()); });
+		}
+	}
+	return 0;
+}
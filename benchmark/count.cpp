@@ -0,0 +1,90 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/count.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename F>
+void measure_and_print(std::string const& name, std::size_t n, F f) {
+	auto t = measure_nullary<5>([]() {}, f);
+	cout << name << ";" << n << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "ns/element;" << get<2>(t) / double(n) << endl;
+}
+
+std::string isa_name(tao::algorithm::simd_isa isa) {
+	using tao::algorithm::simd_isa;
+	return isa == simd_isa::scalar ? "scalar" : isa == simd_isa::sse2 ? "sse2" : isa == simd_isa::avx2 ? "avx2" : "avx512";
+}
+
+template <typename T>
+void run(std::string const& type, std::size_t n) {
+	using namespace tao::algorithm;
+	std::mt19937 gen(7);
+	std::uniform_int_distribution<int> dist(0, 99);
+	std::vector<T> v(n);
+	for (auto& x : v) x = T(dist(gen));
+	std::size_t volatile sink = 0;
+
+	measure_and_print("std::count " + type, n, [&]() {
+		sink = std::size_t(std::count(v.begin(), v.end(), T(42)));
+	});
+	measure_and_print("std::count_if less " + type, n, [&]() {
+		sink = std::size_t(std::count_if(v.begin(), v.end(), [](T x) { return x < T(50); }));
+	});
+	for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+		set_simd_isa_limit(isa);
+		measure_and_print("count " + type + " " + isa_name(isa), n, [&]() {
+			sink = std::size_t(tao::algorithm::count(v.begin(), v.end(), T(42)));
+		});
+		measure_and_print("count_if less " + type + " " + isa_name(isa), n, [&]() {
+			sink = std::size_t(tao::algorithm::count_if(v.begin(), v.end(), less_than_value<T>(T(50))));
+		});
+		measure_and_print("count_if within_range " + type + " " + isa_name(isa), n, [&]() {
+			sink = std::size_t(tao::algorithm::count_if(v.begin(), v.end(), within_range<T>(T(10), T(60))));
+		});
+	}
+	set_simd_isa_limit(simd_isa::avx512);
+}
+
+void run_bits(std::size_t n) {
+	using namespace tao::algorithm;
+	std::mt19937 gen(7);
+	std::vector<bool> bits(n);
+	for (std::size_t i = 0; i != n; ++i) bits[i] = (gen() & 1) != 0;
+	std::size_t volatile sink = 0;
+
+	measure_and_print("std::count vector<bool>", n, [&]() {
+		sink = std::size_t(std::count(bits.begin(), bits.end(), true));
+	});
+	for (auto isa : {simd_isa::scalar, simd_isa::avx2, simd_isa::avx512}) {
+		set_simd_isa_limit(isa);
+		measure_and_print("count vector<bool> " + isa_name(isa), n, [&]() {
+			sink = std::size_t(tao::algorithm::count(bits.begin(), bits.end(), true));
+		});
+	}
+	set_simd_isa_limit(simd_isa::avx512);
+}
+
+int main() {
+	std::size_t const n = 1 << 20;
+	run<std::uint8_t>("uint8", n);
+	run<std::int16_t>("int16", n);
+	run<std::int32_t>("int32", n);
+	run<std::int64_t>("int64", n);
+	run<float>("float", n);
+	run<double>("double", n);
+	run_bits(n * 8);
+	return 0;
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <forward_list>
+#include <iomanip>
+#include <iostream>
+#include <list>
+
+#include <tao/algorithm/bench/measurements.hpp>
+#include <tao/algorithm/sorting/counter_merge_sort.hpp>
+
+using namespace std;
+
+template <Container C>
+void measure_and_print_sort(C const& copy) {
+	C data;
+
+	auto t_std = tao::measure_nullary<20>(
+		[&]() { data = copy; },
+		[&]() { data.sort(); });
+
+	auto t_counter = tao::measure_nullary<20>(
+		[&]() { data = copy; },
+		[&]() { tao::algorithm::counter_merge_sort(data); });
+
+	cout << '\t' << '\t'
+		 << "member sort;" << get<0>(t_std) << ";" << get<1>(t_std) << ";" << get<2>(t_std) << ";"
+		 << "counter_merge_sort;" << get<0>(t_counter) << ";" << get<1>(t_counter) << ";" << get<2>(t_counter) << endl;
+}
+
+template <template <typename T, typename A = std::allocator<T>> class Cont>
+void run_measurements(size_t min_size, size_t max_size) {
+	using N = int64_t;
+	tao::random_int_generator<N> eng;
+
+	cout << "sort;" << tao::iterator_category_str<IteratorType<Cont<N>>>() << ";"
+		 << tao::builtin_type_name<N>() << ";" << endl;
+
+	for (size_t array_size = min_size; array_size <= max_size; array_size *= 4) {
+		auto cont = tao::random_container_creator<Cont>(array_size, eng);
+		cout << '\t' << "data size: " << array_size << ";" << endl;
+		measure_and_print_sort(cont);
+	}
+}
+
+int main() {
+	constexpr size_t min_size = 8;
+	constexpr size_t max_size = 1024 * 1024;
+
+	run_measurements<std::list>(min_size, max_size);
+	run_measurements<std::forward_list>(min_size, max_size);
+	return 0;
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/factorize.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+// count semiprimes p * q with p and q primes of about bits / 2 bits.
+std::vector<std::uint64_t> semiprimes(std::size_t count, int bits) {
+	std::mt19937_64 eng(42);
+	auto random_prime = [&](int b) {
+		std::uint64_t const lo = std::uint64_t(1) << (b - 1);
+		std::uniform_int_distribution<std::uint64_t> dis(lo, lo + (lo - 1));
+		std::uint64_t p = dis(eng) | 1;
+		while ( ! tao::algorithm::prime(p)) p += 2;
+		return p;
+	};
+	std::vector<std::uint64_t> v;
+	while (v.size() < count) v.push_back(random_prime(bits / 2) * random_prime(bits - bits / 2));
+	return v;
+}
+
+void measure_and_print(std::string const& name, std::vector<std::uint64_t> const& v) {
+	std::vector<std::uint64_t> f;
+	f.reserve(64);
+	auto t = measure_nullary<5>([]() {}, [&]() {
+		for (auto n : v) {
+			f.clear();
+			tao::algorithm::factorize(n, std::back_inserter(f));
+		}
+	});
+	cout << name << ";" << v.size() << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "us/number;" << get<2>(t) / 1e3 / double(v.size()) << endl;
+}
+
+// Per-number latency: every number is factored three times and the best
+// time is kept, then the mean and the maximum over the numbers.
+void measure_latency(std::string const& name, std::vector<std::uint64_t> const& v) {
+	std::vector<std::uint64_t> f;
+	f.reserve(64);
+	double sum = 0;
+	double worst = 0;
+	for (auto n : v) {
+		double best = 1e300;
+		for (int i = 0; i < 3; ++i) {
+			auto const start = std::chrono::steady_clock::now();
+			f.clear();
+			tao::algorithm::factorize(n, std::back_inserter(f));
+			auto const end = std::chrono::steady_clock::now();
+			best = (std::min)(best, std::chrono::duration<double, std::micro>(end - start).count());
+		}
+		sum += best;
+		worst = (std::max)(worst, best);
+	}
+	cout << name << " latency;" << v.size() << ";"
+		 << "us/number mean;" << sum / double(v.size()) << ";"
+		 << "us/number max;" << worst << endl;
+}
+
+int main() {
+	measure_and_print("semiprimes 32 bits", semiprimes(1000, 32));
+	measure_and_print("semiprimes 48 bits", semiprimes(200, 48));
+	measure_and_print("semiprimes 62 bits", semiprimes(50, 62));
+	measure_and_print("semiprimes 64 bits", semiprimes(50, 64));
+
+	std::mt19937_64 eng(7);
+	std::vector<std::uint64_t> random(1000);
+	for (auto& x : random) x = eng() | 1;
+	measure_and_print("random 64 bits", random);
+
+	measure_latency("semiprimes 48 bits", semiprimes(300, 48));
+	measure_latency("semiprimes 64 bits", semiprimes(300, 64));
+	measure_latency("random 64 bits", random);
+	return 0;
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/find.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename F>
+void measure_and_print(std::string const& name, std::size_t n, F f) {
+	auto t = measure_nullary<5>([]() {}, f);
+	cout << name << ";" << n << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "ns/element;" << get<2>(t) / double(n) << endl;
+}
+
+template <typename T>
+void run(std::string const& type, std::size_t n) {
+	using namespace tao::algorithm;
+	std::vector<T> v(n, T(1));
+	v[n - 1] = T(7);                    // the match is the last element
+	std::size_t volatile sink = 0;
+
+	measure_and_print("std::find " + type, n, [&]() {
+		sink = std::size_t(std::find(v.begin(), v.end(), T(7)) - v.begin());
+	});
+	for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+		set_simd_isa_limit(isa);
+		std::string const level = isa == simd_isa::scalar ? "scalar" : isa == simd_isa::sse2 ? "sse2" : isa == simd_isa::avx2 ? "avx2" : "avx512";
+		measure_and_print("find " + type + " " + level, n, [&]() {
+			sink = std::size_t(tao::algorithm::find(v.begin(), v.end(), T(7)) - v.begin());
+		});
+		measure_and_print("find_if within_range " + type + " " + level, n, [&]() {
+			sink = std::size_t(tao::algorithm::find_if(v.begin(), v.end(), within_range<T>(T(5), T(9))) - v.begin());
+		});
+	}
+	set_simd_isa_limit(simd_isa::avx512);
+}
+
+int main() {
+	std::size_t const n = 1 << 16;
+	{
+		std::vector<char> c(n, 'a');
+		c[n - 1] = 'z';
+		std::size_t volatile sink = 0;
+		measure_and_print("memchr", n, [&]() {
+			sink = std::size_t(static_cast<char const*>(std::memchr(c.data(), 'z', n)) - c.data());
+		});
+	}
+	run<std::uint8_t>("uint8", n);
+	run<std::int32_t>("int32", n);
+	run<std::uint64_t>("uint64", n);
+	run<float>("float", n);
+	run<double>("double", n);
+	return 0;
+}
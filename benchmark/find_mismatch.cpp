@@ -0,0 +1,58 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/find.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename F>
+void measure_and_print(std::string const& name, std::size_t bytes, F f) {
+	auto t = measure_nullary<5>([]() {}, f);
+	cout << name << ";" << bytes << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "bytes/ns;" << double(bytes) / get<2>(t) << endl;
+}
+
+template <typename T>
+void run(std::string const& type, std::size_t bytes) {
+	using namespace tao::algorithm;
+	std::size_t const n = bytes / sizeof(T);
+	std::vector<T> a(n);
+	for (std::size_t i = 0; i < n; ++i) a[i] = T(i % 100);
+	std::vector<T> b = a;
+	std::size_t volatile sink = 0;
+
+	measure_and_print("memcmp " + type, bytes, [&]() {
+		sink = std::size_t(std::memcmp(a.data(), b.data(), n * sizeof(T)));
+	});
+	measure_and_print("std::mismatch " + type, bytes, [&]() {
+		sink = std::size_t(std::mismatch(a.begin(), a.end(), b.begin(), b.end()).first - a.begin());
+	});
+	for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+		set_simd_isa_limit(isa);
+		std::string const level = isa == simd_isa::scalar ? "scalar" : isa == simd_isa::sse2 ? "sse2" : isa == simd_isa::avx2 ? "avx2" : "avx512";
+		measure_and_print("find_mismatch " + type + " " + level, bytes, [&]() {
+			sink = std::size_t(find_mismatch(a.begin(), a.end(), b.begin(), b.end()).first - a.begin());
+		});
+	}
+	set_simd_isa_limit(simd_isa::avx512);
+}
+
+int main() {
+	std::size_t const bytes = 1 << 20;
+	run<std::uint8_t>("uint8", bytes);
+	run<std::uint32_t>("uint32", bytes);
+	run<double>("double", bytes);
+	return 0;
+}
@@ -0,0 +1,46 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <iostream>
+
+#include <tao/benchmark/instrumented.hpp>
+#include <tao/algorithm/power.hpp>
+
+using namespace std;
+
+using T = instrumented<std::uint64_t>;
+
+// Every call to op constructs one value.
+T op(T const& a, T const& b) {
+	return T(a.value * b.value);
+}
+
+template <typename F>
+double constructions(F f) {
+	instrumented_base::initialize(0);
+	f();
+	return instrumented_base::counts[instrumented_base::construction] - 1;
+}
+
+template <std::uint64_t N>
+void measure_and_print() {
+	using namespace tao::algorithm;
+	double const chain = constructions([] { power<N>(T(3), op); });
+	double const binary = constructions([] { power_semigroup(T(3), N, op); });
+	cout << N << ";" << "power<N>;" << chain << ";" << "power_semigroup;" << binary << endl;
+}
+
+int main() {
+	measure_and_print<5>();
+	measure_and_print<15>();
+	measure_and_print<31>();
+	measure_and_print<63>();
+	measure_and_print<127>();
+	measure_and_print<1000>();
+	measure_and_print<65535>();
+	measure_and_print<1000000007>();
+	measure_and_print<0xffffffffffffffffull>();
+	return 0;
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/matrix.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename T, std::size_t N>
+void measure_product(std::string const& name) {
+	using M = tao::algorithm::matrix<T, N>;
+	M a;
+	M b;
+	for (std::size_t i = 0; i < N * N; ++i) {
+		a.data[i] = T(i % 7) / T(3);
+		b.data[i] = T(i % 5) / T(2);
+	}
+	M c;
+	auto t = measure_nullary<5>([]() {}, [&]() { c = a * b; });
+	volatile T sink = c.data[N];
+	(void)sink;
+	cout << name << ";" << N << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "GFLOP/s;" << 2.0 * N * N * N / get<2>(t) << endl;
+}
+
+template <std::size_t K>
+void measure_recurrence() {
+	using namespace tao::algorithm;
+	std::uint64_t const p = 998244353;
+	std::array<std::uint64_t, K> c;
+	std::array<std::uint64_t, K> x;
+	for (std::size_t i = 0; i < K; ++i) {
+		c[i] = (i * 31337 + 7) % p;
+		x[i] = (i * 1000003 + 1) % p;
+	}
+	std::vector<std::uint64_t> const cv(c.begin(), c.end());
+	std::vector<std::uint64_t> const xv(x.begin(), x.end());
+	std::uint64_t const n = 1000000000000000000ull;
+
+	volatile std::uint64_t r = 0;
+	auto tm = measure_nullary<5>([]() {}, [&]() { r = linear_recurrence_nth(c, x, n, p); });
+	auto tk = measure_nullary<5>([]() {}, [&]() { r = linear_recurrence_nth_kitamasa(cv, xv, n, p); });
+	cout << "linear_recurrence_nth;" << K << ";" << get<2>(tm) << ";"
+		 << "linear_recurrence_nth_kitamasa;" << K << ";" << get<2>(tk) << endl;
+}
+
+int main() {
+	measure_product<double, 8>("matrix<double> product");
+	measure_product<double, 32>("matrix<double> product");
+	measure_product<double, 64>("matrix<double> product");
+	measure_product<double, 128>("matrix<double> product");
+	measure_product<float, 128>("matrix<float> product");
+
+	measure_recurrence<2>();
+	measure_recurrence<8>();
+	measure_recurrence<32>();
+	measure_recurrence<64>();
+	return 0;
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/power.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+struct modulo_mult {
+	std::uint64_t operator()(std::uint64_t a, std::uint64_t b) const {
+		return std::uint64_t((unsigned __int128)a * b % m);
+	}
+	std::uint64_t m;
+};
+
+template <typename F>
+void measure_and_print(std::string const& name, std::size_t n, F f) {
+	auto t = measure_nullary<5>([]() {}, f);
+	cout << name << ";" << n << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "ns/query;" << get<2>(t) / double(n) << endl;
+}
+
+int main() {
+	using namespace tao::algorithm;
+	modulo_mult const op{18446744073709551557ull};
+	std::size_t const n = 10000;
+
+	std::mt19937_64 eng(42);
+	std::vector<std::uint64_t> e(n);
+	std::vector<std::uint64_t> g(n);
+	for (auto& x : e) x = eng();
+	for (auto& x : g) x = eng();
+	volatile std::uint64_t sink = 0;
+
+	measure_and_print("power_semigroup", n, [&]() {
+		for (auto x : e) sink = power_semigroup(std::uint64_t(3), x, op);
+	});
+	for (int w : {2, 4, 6, 8}) {
+		fixed_base_power<std::uint64_t, modulo_mult> p(3, op, 64, w);
+		measure_and_print("fixed_base_power w=" + std::to_string(w), n, [&]() {
+			for (auto x : e) sink = p(x);
+		});
+	}
+
+	measure_and_print("a^n * b^m separate", n, [&]() {
+		for (std::size_t i = 0; i < n; ++i) {
+			sink = op(power_semigroup(std::uint64_t(3), e[i], op), power_semigroup(std::uint64_t(5), g[i], op));
+		}
+	});
+	measure_and_print("power_product_semigroup", n, [&]() {
+		for (std::size_t i = 0; i < n; ++i) {
+			sink = power_product_semigroup(std::uint64_t(3), e[i], std::uint64_t(5), g[i], op);
+		}
+	});
+	std::uint64_t const bases[] = {3, 5};
+	measure_and_print("multi_power_semigroup k=2", n, [&]() {
+		for (std::size_t i = 0; i < n; ++i) {
+			std::uint64_t const x[] = {e[i], g[i]};
+			sink = multi_power_semigroup(bases, bases + 2, x, op);
+		}
+	});
+
+	std::vector<std::uint64_t> h(n);
+	std::vector<std::uint64_t> k(n);
+	for (auto& x : h) x = eng();
+	for (auto& x : k) x = eng();
+	measure_and_print("a^n * b^m * c^p * d^q separate", n, [&]() {
+		for (std::size_t i = 0; i < n; ++i) {
+			sink = op(op(power_semigroup(std::uint64_t(3), e[i], op), power_semigroup(std::uint64_t(5), g[i], op)),
+			          op(power_semigroup(std::uint64_t(7), h[i], op), power_semigroup(std::uint64_t(11), k[i], op)));
+		}
+	});
+	std::uint64_t const bases4[] = {3, 5, 7, 11};
+	measure_and_print("multi_power_semigroup k=4", n, [&]() {
+		for (std::size_t i = 0; i < n; ++i) {
+			std::uint64_t const x[] = {e[i], g[i], h[i], k[i]};
+			sink = multi_power_semigroup(bases4, bases4 + 4, x, op);
+		}
+	});
+	return 0;
+}
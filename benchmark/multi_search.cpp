@@ -0,0 +1,72 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/multi_search.hpp>
+#include <tao/algorithm/search.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename F>
+void measure_and_print(std::string const& name, std::size_t k, std::size_t n, F f) {
+	auto t = measure_nullary<5>([]() {}, f);
+	cout << name << ";" << k << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "ns/byte;" << get<2>(t) / double(n) << endl;
+}
+
+int main() {
+	using namespace tao::algorithm;
+	std::mt19937 eng(42);
+	std::size_t const n = 4 * 1024 * 1024;
+	std::string text(n, ' ');
+	for (auto& c : text) c = char(32 + eng() % 95);
+
+	for (std::size_t k : {8, 32, 64, 500}) {
+		std::vector<std::string> patterns(k);
+		for (auto& p : patterns) {
+			p.resize(4 + eng() % 12);
+			for (auto& c : p) c = char(32 + eng() % 95);
+		}
+		// A few occurrences of every pattern.
+		std::string t = text;
+		for (std::size_t i = 0; i < 4 * k; ++i) {
+			auto const& p = patterns[i % k];
+			t.replace(eng() % (n - 16), p.size(), p);
+		}
+		std::size_t volatile sink = 0;
+
+		measure_and_print("search per pattern", k, n, [&]() {
+			std::size_t c = 0;
+			for (auto const& p : patterns) {
+				auto f = t.begin();
+				while (true) {
+					auto r = tao::algorithm::search(f, t.end(), p.begin(), p.end());
+					if (r.first == t.end()) break;
+					++c;
+					f = r.first + 1;
+				}
+			}
+			sink = c;
+		});
+		multi_searcher const s(patterns.begin(), patterns.end());
+		for (auto isa : {simd_isa::scalar, simd_isa::avx2}) {
+			set_simd_isa_limit(isa);
+			measure_and_print(isa == simd_isa::scalar ? "multi_searcher (aho-corasick)" : "multi_searcher (teddy)", k, n, [&]() {
+				std::size_t c = 0;
+				s(t.begin(), t.end(), [&](std::size_t, std::ptrdiff_t) { ++c; });
+				sink = c;
+			});
+		}
+		set_simd_isa_limit(simd_isa::avx512);
+	}
+	return 0;
+}
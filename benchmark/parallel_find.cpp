@@ -0,0 +1,56 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/find.hpp>
+#include <tao/algorithm/parallel/find.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename F>
+void measure_and_print(std::string const& name, std::size_t n, F f) {
+	auto t = measure_nullary<5>([]() {}, f);
+	cout << name << ";" << n << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << endl;
+}
+
+int main() {
+	using namespace tao::algorithm;
+	cout << "workers: " << default_workers() << endl;
+
+	std::size_t const n = std::size_t(1) << 25;
+	std::vector<std::int32_t> v(n, 0);
+	std::size_t volatile sink = 0;
+
+	// The match early, in the middle and missing. The predicate is a
+	// lambda (scalar scan) and a comparison (vectorized scan).
+	for (std::size_t k : {std::size_t(1) << 18, n / 2, n}) {
+		if (k != n) v[k] = 1;
+		std::string const where = k == n ? "none" : std::to_string(k);
+
+		measure_and_print("find_if lambda hit " + where, n, [&]() {
+			sink = std::size_t(tao::algorithm::find_if(v.begin(), v.end(), [](std::int32_t x) { return x == 1; }) - v.begin());
+		});
+		measure_and_print("parallel_find_if lambda hit " + where, n, [&]() {
+			sink = std::size_t(parallel_find_if(v.begin(), v.end(), [](std::int32_t x) { return x == 1; }) - v.begin());
+		});
+		measure_and_print("find_if equal_to_value hit " + where, n, [&]() {
+			sink = std::size_t(tao::algorithm::find_if(v.begin(), v.end(), equal_to_value<std::int32_t>(1)) - v.begin());
+		});
+		measure_and_print("parallel_find_if equal_to_value hit " + where, n, [&]() {
+			sink = std::size_t(parallel_find_if(v.begin(), v.end(), equal_to_value<std::int32_t>(1)) - v.begin());
+		});
+		measure_and_print("parallel_some equal_to_value hit " + where, n, [&]() {
+			sink = std::size_t(parallel_some(v.begin(), v.end(), equal_to_value<std::int32_t>(1)));
+		});
+		if (k != n) v[k] = 0;
+	}
+	return 0;
+}
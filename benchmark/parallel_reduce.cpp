@@ -0,0 +1,54 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/accumulate.hpp>
+#include <tao/algorithm/parallel/reduce.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename T, typename Op>
+void measure_and_print_reduce(std::string const& name, vector<T> const& data, Op op, T const& e) {
+	volatile bool same = false;
+
+	auto t_acc = measure_nullary<50>(
+		[]() {},
+		[&]() { same = tao::algorithm::accumulate(begin(data), end(data), e, op) == e; });
+
+	auto t_par = measure_nullary<50>(
+		[]() {},
+		[&]() { same = tao::algorithm::parallel_reduce(begin(data), end(data), op, e) == e; });
+
+	cout << name << ";"
+		 << data.size() << ";"
+		 << "accumulate;" << get<0>(t_acc) << ";" << get<1>(t_acc) << ";" << get<2>(t_acc) << ";"
+		 << "parallel_reduce;" << get<0>(t_par) << ";" << get<1>(t_par) << ";" << get<2>(t_par) << endl;
+}
+
+int main() {
+	cout << "workers: " << tao::algorithm::default_workers() << endl;
+
+	for (size_t n = 1024; n <= 16 * 1024 * 1024; n *= 4) {
+		vector<uint64_t> data(n);
+		iota(begin(data), end(data), 1);
+		measure_and_print_reduce("plus<uint64_t>", data, std::plus<>(), uint64_t(0));
+	}
+
+	for (size_t n = 1024; n <= 256 * 1024; n *= 4) {
+		vector<string> data(n, "abcdefgh");
+		auto concat = [](string const& a, string const& b) { return a + b; };
+		measure_and_print_reduce("string concatenation", data, concat, string());
+	}
+
+	return 0;
+}
@@ -0,0 +1,42 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include <tao/algorithm/parallel/sieve.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+void measure_and_print(std::string const& name, std::uint64_t lo, std::uint64_t hi, std::size_t workers) {
+	volatile std::uint64_t count = 0;
+	auto t = measure_nullary<5>(
+		[]() {},
+		[&]() { count = tao::algorithm::parallel_count_primes(lo, hi, workers); });
+
+	double const seconds = double(get<2>(t)) / 1e9;
+	cout << name << ";"
+		 << workers << ";"
+		 << count << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "primes/s;" << double(count) / seconds << endl;
+}
+
+int main() {
+	auto const max_workers = tao::algorithm::default_workers();
+	cout << "workers: " << max_workers << endl;
+
+	for (std::size_t workers = 1; workers <= max_workers; workers *= 2) {
+		measure_and_print("[0, 2^32)", 0, std::uint64_t(1) << 32, workers);
+		measure_and_print("[10^12, 10^12 + 10^9)", 1000000000000ull, 1001000000000ull, workers);
+	}
+	if ((max_workers & (max_workers - 1)) != 0) {
+		measure_and_print("[0, 2^32)", 0, std::uint64_t(1) << 32, max_workers);
+		measure_and_print("[10^12, 10^12 + 10^9)", 1000000000000ull, 1001000000000ull, max_workers);
+	}
+	return 0;
+}
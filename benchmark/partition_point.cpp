@@ -0,0 +1,78 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/partition/partition_point.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename F>
+void measure_and_print(std::string const& name, std::size_t n, std::size_t queries, F f) {
+	auto t = measure_nullary<3>([]() {}, f);
+	cout << name << ";" << n << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "ns/query;" << get<2>(t) / double(queries) << endl;
+}
+
+int main(int argc, char** argv) {
+	using namespace tao::algorithm;
+	std::size_t const max_n = argc > 1 ? std::stoull(argv[1]) : 100000000;
+	std::size_t const queries = 1 << 20;
+	std::mt19937 gen(3);
+
+	for (std::size_t n = 1000; n <= max_n; n *= 10) {
+		std::vector<std::int32_t> v(n);
+		for (auto& x : v) x = std::int32_t(gen() >> 1);
+		std::sort(v.begin(), v.end());
+		std::vector<std::int32_t> q(queries);
+		for (auto& x : q) x = std::int32_t(gen() >> 1);
+		auto const m = std::ptrdiff_t(n);
+
+		std::size_t volatile sink = 0;
+		measure_and_print("std::lower_bound", n, queries, [&]() {
+			std::size_t s = 0;
+			for (auto x : q) s += std::size_t(std::lower_bound(v.begin(), v.end(), x) - v.begin());
+			sink = s;
+		});
+		// The forward iterator loop, branchy, on the same array.
+		measure_and_print("partition_point_n forward", n, queries, [&]() {
+			std::size_t s = 0;
+			for (auto x : q) {
+				auto i = v.begin();
+				auto k = m;
+				while (k != 0) {
+					auto h = half(k);
+					if ( ! (i[h] < x)) {
+						k = h;
+					} else {
+						k -= h + 1;
+						i += h + 1;
+					}
+				}
+				s += std::size_t(i - v.begin());
+			}
+			sink = s;
+		});
+		measure_and_print("partition_point_n", n, queries, [&]() {
+			std::size_t s = 0;
+			for (auto x : q) s += std::size_t(partition_point_n(v.begin(), m, [x](std::int32_t y) { return ! (y < x); }) - v.begin());
+			sink = s;
+		});
+		std::vector<std::vector<std::int32_t>::iterator> r(queries);
+		measure_and_print("lower_bound_batch", n, queries, [&]() {
+			lower_bound_batch(v.begin(), m, q.begin(), q.end(), r.begin());
+			sink = std::size_t(r.back() - v.begin());
+		});
+	}
+	return 0;
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/prime_batch.hpp>
+#include <tao/algorithm/primes.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+std::vector<std::uint64_t> random_odd(std::size_t n, std::uint64_t lo, std::uint64_t hi) {
+	std::mt19937_64 eng(42);
+	std::uniform_int_distribution<std::uint64_t> dis(lo, hi);
+	std::vector<std::uint64_t> v(n);
+	for (auto& x : v) x = dis(eng) | 1;
+	return v;
+}
+
+void print(std::string const& name, std::string const& isa, std::size_t n, std::tuple<double, double, double> const& t) {
+	cout << name << ";" << isa << ";" << n << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "ns/candidate;" << get<2>(t) / double(n) << endl;
+}
+
+void measure_and_print(std::string const& name, std::vector<std::uint64_t> const& v) {
+	using namespace tao::algorithm;
+	std::vector<char> res(v.size());
+
+	auto t = measure_nullary<5>([]() {}, [&]() {
+		for (std::size_t i = 0; i < v.size(); ++i) res[i] = prime(v[i]);
+	});
+	print(name, "prime", v.size(), t);
+
+	char const* names[] = {"scalar", "sse2", "avx2", "avx512"};
+	for (auto isa : {simd_isa::scalar, simd_isa::avx2, simd_isa::avx512}) {
+		if (int(isa) > int(simd_isa_supported())) continue;
+		set_simd_isa_limit(isa);
+		auto t = measure_nullary<5>([]() {}, [&]() {
+			prime_batch(v.begin(), v.end(), res.begin());
+		});
+		print(name, names[int(isa)], v.size(), t);
+	}
+	set_simd_isa_limit(simd_isa::avx512);
+}
+
+int main() {
+	std::size_t const n = 1 << 20;
+	measure_and_print("odd < 2^32", random_odd(n, 1u << 31, 0xffffffffull));
+	measure_and_print("odd < 2^52", random_odd(n, 1ull << 51, (1ull << 52) - 1));
+	measure_and_print("odd < 2^64", random_odd(n, 1ull << 63, ~0ull));
+	return 0;
+}
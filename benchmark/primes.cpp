@@ -0,0 +1,69 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include <tao/algorithm/primes.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename F>
+void measure_and_print(std::string const& name, std::uint64_t hi, F f) {
+	volatile std::uint64_t res = 0;
+	auto t = measure_nullary<5>([]() {}, [&]() { res = f(hi); });
+	cout << name << ";" << hi << ";" << res << ";" << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << endl;
+}
+
+int main() {
+	using namespace tao::algorithm;
+
+	for (int bits = 20; bits <= 32; bits += 4) {
+		std::uint64_t const hi = std::uint64_t(1) << bits;
+
+		measure_and_print("segmented_sieve count", hi, [](std::uint64_t hi) {
+			std::uint64_t c = 3;
+			segmented_sieve<> s(0, hi);
+			while (s.next()) c += s.count();
+			return c;
+		});
+
+		measure_and_print("for_each_prime", hi, [](std::uint64_t hi) {
+			std::uint64_t c = 0;
+			for_each_prime(0, hi, [&](std::uint64_t) { ++c; });
+			return c;
+		});
+
+		measure_and_print("sift_gen", hi, [](std::uint64_t hi) {
+			std::uint64_t c = 0;
+			sift_gen<std::uint64_t> gen(2);
+			while (*gen < hi) {
+				++c;
+				++gen;
+			}
+			return c;
+		});
+	}
+	for (std::uint64_t n = 1000000; n <= 1000000000; n *= 10) {
+		measure_and_print("prime_pi", n * 20, [](std::uint64_t x) { return prime_pi(x); });
+		measure_and_print("prime_nth", n, [](std::uint64_t n) { return prime_nth(n - 1); });
+	}
+
+	for (std::uint64_t lo : {std::uint64_t(1000000000), std::uint64_t(1000000000000000000)}) {
+		measure_and_print("prime(n) over [lo, lo + 10^5)", lo, [](std::uint64_t lo) {
+			std::uint64_t c = 0;
+			for (std::uint64_t n = lo; n < lo + 100000; ++n) c += prime(n);
+			return c;
+		});
+		measure_and_print("prime(n, 100) over [lo, lo + 10^5)", lo, [](std::uint64_t lo) {
+			std::uint64_t c = 0;
+			for (std::uint64_t n = lo; n < lo + 100000; ++n) c += prime(n, std::uint64_t(100));
+			return c;
+		});
+	}
+	return 0;
+}
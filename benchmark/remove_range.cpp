@@ -0,0 +1,64 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/remove_range.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename F>
+void measure_and_print(std::string const& name, std::size_t k, std::size_t n, F f) {
+	auto t = measure_nullary<5>([]() {}, f);
+	cout << name << ";" << k << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "ns/element;" << get<2>(t) / double(n) << endl;
+}
+
+// The search and rotate loop remove_range used to run.
+template <typename I1, typename I2>
+I1 remove_range_rotate(I1 f, I1 l, I2 fs, I2 ls) {
+	I1 fn;
+	std::tie(f, fn) = tao::algorithm::search(f, l, fs, ls);
+	while (f != l) {
+		l = std::rotate(f, fn, l);
+		std::tie(f, fn) = tao::algorithm::search(f, l, fs, ls);
+	}
+	return l;
+}
+
+template <typename C>
+void run(std::string const& type, C const& text, C const& pattern, std::size_t k) {
+	std::size_t volatile sink = 0;
+	C work;
+	measure_and_print("search + rotate " + type, k, text.size(), [&]() {
+		work = text;
+		sink = std::size_t(remove_range_rotate(work.begin(), work.end(), pattern.begin(), pattern.end()) - work.begin());
+	});
+	measure_and_print("remove_range " + type, k, text.size(), [&]() {
+		work = text;
+		sink = std::size_t(tao::algorithm::remove_range(work.begin(), work.end(), pattern.begin(), pattern.end()) - work.begin());
+	});
+}
+
+int main() {
+	std::mt19937 eng(42);
+	std::size_t const n = 1 << 20;
+	std::string const secret = "password=hunter2";
+	for (std::size_t k : {0, 16, 1024}) {
+		std::string text(n, ' ');
+		for (auto& c : text) c = char('a' + eng() % 26);
+		for (std::size_t i = 0; i < k; ++i) text.replace(eng() % (n - secret.size()), secret.size(), secret);
+		run("string", text, secret, k);
+		run("vector<int>", std::vector<int>(text.begin(), text.end()), std::vector<int>(secret.begin(), secret.end()), k);
+	}
+	return 0;
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <tao/algorithm/find.hpp>
+#include <tao/algorithm/run_length.hpp>
+#include <tao/algorithm/search.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename F>
+void measure_and_print(std::string const& name, std::size_t run, std::size_t n, F f) {
+	auto t = measure_nullary<5>([]() {}, f);
+	cout << name << ";" << run << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "ns/element;" << get<2>(t) / double(n) << endl;
+}
+
+int main() {
+	using namespace tao::algorithm;
+	std::size_t const n = 1 << 22;
+	std::mt19937 gen(50);
+
+	// Runs of random length, 1 to 2 * run - 1, of random values.
+	for (std::size_t run : {2, 16, 256, 4096}) {
+		std::vector<std::int32_t> v;
+		v.reserve(n + 2 * run);
+		while (v.size() < n) v.insert(v.end(), gen() % (2 * run - 1) + 1, std::int32_t(gen() % 4));
+		v.resize(n);
+		std::vector<std::pair<std::int32_t, std::ptrdiff_t>> out(n);
+
+		std::size_t volatile sink = 0;
+		auto const scalar_eq = [](std::int32_t x, std::int32_t y) { return x == y; };
+		measure_and_print("run_length_encode scalar", run, n, [&]() {
+			sink = std::size_t(run_length_encode(v.begin(), v.end(), out.begin(), scalar_eq) - out.begin());
+		});
+		for (auto isa : {simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+			set_simd_isa_limit(isa);
+			std::string const level = isa == simd_isa::sse2 ? "sse2" : isa == simd_isa::avx2 ? "avx2" : "avx512";
+			measure_and_print("run_length_encode " + level, run, n, [&]() {
+				sink = std::size_t(run_length_encode(v.begin(), v.end(), out.begin()) - out.begin());
+			});
+		}
+
+		// Sparse matches: a run of run 7s hidden at the end of a range of
+		// runs of 7s one shorter.
+		std::vector<std::int32_t> w;
+		w.reserve(n);
+		while (w.size() + run < n) {
+			w.insert(w.end(), run - 1, 7);
+			w.push_back(0);
+		}
+		w.insert(w.end(), run, 7);
+		auto const k = std::ptrdiff_t(run);
+		measure_and_print("std::search_n", run, w.size(), [&]() {
+			sink = std::size_t(std::search_n(w.begin(), w.end(), k, 7) - w.begin());
+		});
+		measure_and_print("search_n", run, w.size(), [&]() {
+			sink = std::size_t(tao::algorithm::search_n(w.begin(), w.end(), k, 7).first - w.begin());
+		});
+	}
+	return 0;
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/search.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+template <typename F>
+void measure_and_print(std::string const& name, std::size_t m, std::size_t n, F f) {
+	auto t = measure_nullary<5>([]() {}, f);
+	cout << name << ";" << m << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "ns/byte;" << get<2>(t) / double(n) << endl;
+}
+
+// Log-like text: lines of words over a small alphabet, the pattern is
+// placed only at the end.
+std::string make_text(std::size_t n, std::mt19937& eng) {
+	std::string const words[] = {"INFO", "WARN", "request", "id=", "user", "GET", "/api/v1/", "200", "ms", "session"};
+	std::string res;
+	res.reserve(n + 64);
+	while (res.size() < n) {
+		res += words[eng() % 10];
+		res += (eng() % 8 == 0) ? '\n' : ' ';
+		res += char('0' + eng() % 10);
+	}
+	return res;
+}
+
+int main() {
+	using namespace tao::algorithm;
+	using It = std::string::const_iterator;
+	std::mt19937 eng(42);
+	std::size_t const n = 16 * 1024 * 1024;
+	std::string text = make_text(n, eng);
+
+	for (std::size_t m : {4, 16, 64}) {
+		std::string pattern(m, ' ');
+		for (auto& c : pattern) c = "abcdefghijklmnopqrstuvwxyz"[eng() % 26];
+		std::string const t = text + pattern;
+		std::size_t volatile sink = 0;
+
+		measure_and_print("naive", m, t.size(), [&]() {
+			// The naive loop, as search() runs it on non-contiguous ranges.
+			auto f = t.begin();
+			auto const l = t.end();
+			while (true) {
+				auto it = f;
+				auto it_s = pattern.begin();
+				while (it_s != pattern.end() && it != l && *it == *it_s) { ++it; ++it_s; }
+				if (it_s == pattern.end() || it == l) break;
+				++f;
+			}
+			sink = std::size_t(f - t.begin());
+		});
+		measure_and_print("std::search", m, t.size(), [&]() {
+			sink = std::size_t(std::search(t.begin(), t.end(), pattern.begin(), pattern.end()) - t.begin());
+		});
+		horspool_searcher<It> const h(pattern.cbegin(), pattern.cend());
+		measure_and_print("horspool_searcher", m, t.size(), [&]() {
+			sink = std::size_t(h(t.begin(), t.end()).first - t.begin());
+		});
+		two_way_searcher<It> const w(pattern.cbegin(), pattern.cend());
+		measure_and_print("two_way_searcher", m, t.size(), [&]() {
+			sink = std::size_t(w(t.begin(), t.end()).first - t.begin());
+		});
+		measure_and_print("search (byte_searcher)", m, t.size(), [&]() {
+			sink = std::size_t(tao::algorithm::search(t.begin(), t.end(), pattern.begin(), pattern.end()).first - t.begin());
+		});
+	}
+	return 0;
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/partition/partition_point.hpp>
+#include <tao/algorithm/partition/static_index.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+
+// Keys of 12 and 24 bytes, ordered by their first member.
+template <std::size_t Bytes>
+struct wide_key {
+	std::int32_t x;
+	char payload[Bytes - sizeof(std::int32_t)];
+};
+
+template <std::size_t Bytes>
+bool operator<(wide_key<Bytes> const& a, wide_key<Bytes> const& b) { return a.x < b.x; }
+
+template <typename F>
+void measure_and_print(std::string const& name, std::size_t n, std::size_t queries, F f) {
+	auto t = measure_nullary<3>([]() {}, f);
+	cout << name << ";" << n << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "ns/query;" << get<2>(t) / double(queries) << endl;
+}
+
+template <std::size_t Bytes>
+void measure_wide_keys(std::vector<std::int32_t> const& v, std::vector<std::int32_t> const& q, std::size_t queries) {
+	using namespace tao::algorithm;
+	using K = wide_key<Bytes>;
+	std::vector<K> w(v.size());
+	for (std::size_t i = 0; i != v.size(); ++i) w[i].x = v[i];
+	std::string const suffix = " " + std::to_string(Bytes) + "-byte keys";
+
+	std::size_t volatile sink = 0;
+	measure_and_print("std::lower_bound" + suffix, v.size(), queries, [&]() {
+		std::size_t s = 0;
+		for (auto x : q) s += std::size_t(std::lower_bound(w.begin(), w.end(), K{x, {}}) - w.begin());
+		sink = s;
+	});
+	eytzinger_index<K> const e(w.begin(), w.end());
+	measure_and_print("eytzinger_index" + suffix, v.size(), queries, [&]() {
+		std::size_t s = 0;
+		for (auto x : q) s += e.lower_bound(K{x, {}});
+		sink = s;
+	});
+}
+
+int main(int argc, char** argv) {
+	using namespace tao::algorithm;
+	// 10^9 keys take 4 GB for the array plus as much for every index.
+	std::size_t const max_n = argc > 1 ? std::stoull(argv[1]) : 100000000;
+	std::size_t const queries = 1 << 20;
+	std::mt19937 gen(3);
+
+	for (std::size_t n = 1000; n <= max_n; n *= 10) {
+		std::vector<std::int32_t> v(n);
+		for (auto& x : v) x = std::int32_t(gen() >> 1);
+		std::sort(v.begin(), v.end());
+		std::vector<std::int32_t> q(queries);
+		for (auto& x : q) x = std::int32_t(gen() >> 1);
+
+		std::size_t volatile sink = 0;
+		measure_and_print("partition_point", n, queries, [&]() {
+			std::size_t s = 0;
+			for (auto x : q) s += std::size_t(tao::algorithm::partition_point(v.begin(), v.end(), [x](std::int32_t y) { return ! (y < x); }) - v.begin());
+			sink = s;
+		});
+		measure_and_print("std::lower_bound", n, queries, [&]() {
+			std::size_t s = 0;
+			for (auto x : q) s += std::size_t(std::lower_bound(v.begin(), v.end(), x) - v.begin());
+			sink = s;
+		});
+		{
+			eytzinger_index<std::int32_t> const e(v.begin(), v.end());
+			measure_and_print("eytzinger_index", n, queries, [&]() {
+				std::size_t s = 0;
+				for (auto x : q) s += e.lower_bound(x);
+				sink = s;
+			});
+		}
+		{
+			s_tree_index<std::int32_t> const t(v.begin(), v.end());
+			for (auto isa : {simd_isa::scalar, simd_isa::avx2, simd_isa::avx512}) {
+				set_simd_isa_limit(isa);
+				std::string const level = isa == simd_isa::scalar ? "scalar" : isa == simd_isa::avx2 ? "avx2" : "avx512";
+				measure_and_print("s_tree_index " + level, n, queries, [&]() {
+					std::size_t s = 0;
+					for (auto x : q) s += t.lower_bound(x);
+					sink = s;
+				});
+			}
+			set_simd_isa_limit(simd_isa::avx512);
+		}
+		measure_wide_keys<12>(v, q, queries);
+		measure_wide_keys<24>(v, q, queries);
+	}
+	return 0;
+}
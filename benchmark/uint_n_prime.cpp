@@ -0,0 +1,88 @@
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tao/algorithm/primes.hpp>
+#include <tao/algorithm/uint_n.hpp>
+
+#include "measurements.hpp"
+
+using namespace std;
+using namespace tao::algorithm;
+
+template <typename F>
+void measure_and_print(std::string const& name, std::size_t n, F f) {
+	auto t = measure_nullary<5>([]() {}, f);
+	cout << name << ";" << n << ";"
+		 << get<0>(t) << ";" << get<1>(t) << ";" << get<2>(t) << ";"
+		 << "ns/op;" << get<2>(t) / double(n) << endl;
+}
+
+template <std::size_t Bits>
+void run(std::mt19937_64& eng) {
+	using U = uint_n<Bits>;
+	std::string const bits = std::to_string(Bits);
+
+	auto random = [&]() {
+		U x;
+		for (auto& l : x.limb) l = eng();
+		return x;
+	};
+	U const n = random() | U(1) | (U(1) << int(Bits - 1));
+	std::size_t const k = 10000;
+	std::vector<U> a(k);
+	for (auto& x : a) x = random() % n;
+	volatile std::uint64_t sink = 0;
+
+	// Dependent chains of products, the latency of one modular multiplication.
+	measure_and_print("wide product and division " + bits, k, [&]() {
+		U x = a[0];
+		for (auto const& y : a) x = U(wide_multiply(x, y) % uint_n<2 * Bits>(n));
+		sink = std::uint64_t(x);
+	});
+	modulo_multiply<U> const barrett(n);
+	measure_and_print("barrett " + bits, k, [&]() {
+		U x = a[0];
+		for (auto const& y : a) x = barrett(x, y);
+		sink = std::uint64_t(x);
+	});
+	montgomery_multiply<U> const montgomery(n);
+	measure_and_print("montgomery " + bits, k, [&]() {
+		U x = a[0];
+		for (auto const& y : a) x = montgomery(x, y);
+		sink = std::uint64_t(x);
+	});
+
+	// prime() on random odd numbers (mostly rejected early) and on primes.
+	std::vector<U> odd(k);
+	for (auto& x : odd) x = random() | U(1);
+	measure_and_print("prime random odd " + bits, k, [&]() {
+		std::uint64_t c = 0;
+		for (auto const& x : odd) c += prime(x);
+		sink = c;
+	});
+	std::vector<U> primes;
+	U x = random() | U(1);
+	while (primes.size() < 100) {
+		if (prime(x)) primes.push_back(x);
+		x += U(2);
+	}
+	measure_and_print("prime on primes " + bits, primes.size(), [&]() {
+		std::uint64_t c = 0;
+		for (auto const& p : primes) c += prime(p);
+		sink = c;
+	});
+}
+
+int main() {
+	std::mt19937_64 eng(42);
+	run<128>(eng);
+	run<256>(eng);
+	return 0;
+}
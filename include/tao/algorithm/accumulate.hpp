@@ -10,15 +10,221 @@
 #define TAO_ALGORITHM_ACCUMULATE_HPP
 
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <iterator>
+#include <type_traits>
 #include <utility>
 
 #include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/simd.hpp>
 #include <tao/algorithm/type_attributes.hpp>
 
 namespace tao { namespace algorithm {
 
+template <TotallyOrdered T = void>
+struct minimum {
+    T operator()(T const& a, T const& b) const {
+        return b < a ? b : a;
+    }
+};
+
+template <>
+struct minimum<void> {
+    template <TotallyOrdered T, TotallyOrdered U>
+    std::common_type_t<T, U> operator()(T const& a, U const& b) const {
+        return b < a ? b : a;
+    }
+};
+
+template <TotallyOrdered T = void>
+struct maximum {
+    T operator()(T const& a, T const& b) const {
+        return a < b ? b : a;
+    }
+};
+
+template <>
+struct maximum<void> {
+    template <TotallyOrdered T, TotallyOrdered U>
+    std::common_type_t<T, U> operator()(T const& a, U const& b) const {
+        return a < b ? b : a;
+    }
+};
+
+namespace detail {
+
+struct identity_function {
+    template <typename T>
+    T const& operator()(T const& x) const { return x; }
+};
+
+// Operations the vectorized kernels know how to reassociate.
+enum class accumulate_kind { none, plus, multiplies, minimum, maximum };
+
+template <BinaryOperation Op>
+struct accumulate_kind_of : std::integral_constant<accumulate_kind, accumulate_kind::none> {};
+
+template <typename T>
+struct accumulate_kind_of<std::plus<T>> : std::integral_constant<accumulate_kind, accumulate_kind::plus> {};
+
+template <typename T>
+struct accumulate_kind_of<std::multiplies<T>> : std::integral_constant<accumulate_kind, accumulate_kind::multiplies> {};
+
+template <typename T>
+struct accumulate_kind_of<minimum<T>> : std::integral_constant<accumulate_kind, accumulate_kind::minimum> {};
+
+template <typename T>
+struct accumulate_kind_of<maximum<T>> : std::integral_constant<accumulate_kind, accumulate_kind::maximum> {};
+
+// Argument type of the operation, void for the transparent ones.
+template <typename Op>
+struct accumulate_operand {
+    using type = void;
+};
+
+template <template <typename> class F, typename U>
+struct accumulate_operand<F<U>> {
+    using type = U;
+};
+
+// Integer sums and products are computed in the unsigned type: wraparound
+// is then well defined and, being arithmetic modulo 2^k, independent of the
+// grouping, so the result is bitwise identical to the sequential one.
+template <accumulate_kind K, typename T, bool = std::is_integral<T>::value &&
+          (K == accumulate_kind::plus || K == accumulate_kind::multiplies)>
+struct accumulate_lane {
+    using type = T;
+};
+
+template <accumulate_kind K, typename T>
+struct accumulate_lane<K, T, true> {
+    using type = std::make_unsigned_t<T>;
+};
+
+template <accumulate_kind K, typename T>
+using accumulate_lane_t = typename accumulate_lane<K, T>::type;
+
+template <accumulate_kind K, typename U>
+TAO_ALGORITHM_ALWAYS_INLINE
+U accumulate_apply(U a, U b) {
+    using W = std::conditional_t<std::is_integral<U>::value && (sizeof(U) < sizeof(unsigned)), unsigned, U>;
+    if constexpr (K == accumulate_kind::plus) {
+        return U(W(a) + W(b));
+    } else if constexpr (K == accumulate_kind::multiplies) {
+        return U(W(a) * W(b));
+    } else if constexpr (K == accumulate_kind::minimum) {
+        return b < a ? b : a;
+    } else {
+        return a < b ? b : a;
+    }
+}
+
+// Value type, after fun, of the elements of a range of I.
+template <Iterator I, UnaryFunction F>
+using accumulate_input_t = std::decay_t<decltype(std::declval<F>()(*std::declval<I>()))>;
+
+template <Iterator I, typename T, BinaryOperation Op, UnaryFunction F, bool Reassociate>
+constexpr bool accumulate_vectorizable() {
+    if constexpr ( ! is_contiguous_iterator_v<I>) {
+        return false;
+    } else {
+        using R = accumulate_input_t<I, F>;
+        constexpr auto kind = accumulate_kind_of<Op>::value;
+        constexpr bool min_max = kind == accumulate_kind::minimum || kind == accumulate_kind::maximum;
+        constexpr bool integers = std::is_integral<T>::value && ! std::is_same<T, bool>::value &&
+                                  std::is_integral<R>::value && ! std::is_same<R, bool>::value;
+        constexpr bool reals = std::is_floating_point<T>::value && is_simd_arithmetic_v<T> &&
+                               is_simd_arithmetic_v<R>;
+        // An op on other arguments converts the operands first, which the
+        // kernels do not.
+        using U = typename accumulate_operand<Op>::type;
+        constexpr bool operands = std::is_void<U>::value ||
+                                  (std::is_same<U, T>::value && std::is_same<U, R>::value);
+        return kind != accumulate_kind::none && operands &&
+               ( ! min_max || std::is_same<R, T>::value) &&
+               (integers || (Reassociate && reals));
+    }
+}
+
+// Lanes independent accumulators, Bytes / sizeof(T) of them per vector
+// register and four registers to hide the latency of op.
+template <std::size_t Bytes, accumulate_kind K, typename T, typename V, UnaryFunction F>
+TAO_ALGORITHM_ALWAYS_INLINE
+T accumulate_lanes(V const* f, std::size_t n, T init, F fun) {
+    using U = accumulate_lane_t<K, T>;
+    constexpr std::size_t lanes = 4 * (Bytes / sizeof(T) == 0 ? 1 : Bytes / sizeof(T));
+
+    U r = U(init);
+    if (n >= lanes) {
+        U acc[lanes];
+        for (std::size_t j = 0; j < lanes; ++j) acc[j] = U(T(fun(f[j])));
+
+        std::size_t i = lanes;
+        for (; n - i >= lanes; i += lanes) {
+            TAO_ALGORITHM_UNROLL
+            for (std::size_t j = 0; j < lanes; ++j) {
+                acc[j] = accumulate_apply<K>(acc[j], U(T(fun(f[i + j]))));
+            }
+        }
+
+        for (std::size_t w = lanes / 2; w != 0; w /= 2) {
+            for (std::size_t j = 0; j < w; ++j) acc[j] = accumulate_apply<K>(acc[j], acc[j + w]);
+        }
+        r = accumulate_apply<K>(r, acc[0]);
+        f += i;
+        n -= i;
+    }
+    while (n != 0) {
+        r = accumulate_apply<K>(r, U(T(fun(*f))));
+        ++f;
+        --n;
+    }
+    return T(r);
+}
+
+#if defined(TAO_ALGORITHM_SIMD_X86)
+template <accumulate_kind K, typename T, typename V, UnaryFunction F>
+TAO_ALGORITHM_TARGET_AVX512
+T accumulate_avx512(V const* f, std::size_t n, T init, F fun) {
+    return accumulate_lanes<64, K>(f, n, init, fun);
+}
+
+template <accumulate_kind K, typename T, typename V, UnaryFunction F>
+TAO_ALGORITHM_TARGET_AVX2
+T accumulate_avx2(V const* f, std::size_t n, T init, F fun) {
+    return accumulate_lanes<32, K>(f, n, init, fun);
+}
+
+template <accumulate_kind K, typename T, typename V, UnaryFunction F>
+TAO_ALGORITHM_TARGET_SSE2
+T accumulate_sse2(V const* f, std::size_t n, T init, F fun) {
+    return accumulate_lanes<16, K>(f, n, init, fun);
+}
+#endif
+
+template <accumulate_kind K, typename T, typename V, UnaryFunction F>
+T accumulate_contiguous(V const* f, std::size_t n, T init, F fun) {
+#if defined(TAO_ALGORITHM_SIMD_X86)
+    switch (simd_isa_level()) {
+        case simd_isa::avx512: return accumulate_avx512<K>(f, n, init, fun);
+        case simd_isa::avx2:   return accumulate_avx2<K>(f, n, init, fun);
+        case simd_isa::sse2:   return accumulate_sse2<K>(f, n, init, fun);
+        default: break;
+    }
+#endif
+    return accumulate_lanes<16, K>(f, n, init, fun);
+}
+
+template <RandomAccessIterator I, typename T, BinaryOperation Op, UnaryFunction F>
+inline
+T accumulate_contiguous_n(I f, std::size_t n, T init, Op, F fun) {
+    if (n == 0) return init;
+    return accumulate_contiguous<accumulate_kind_of<Op>::value>(std::addressof(*f), n, init, fun);
+}
+
+} // namespace detail
+
 //Complexity:
 //      Runtime:
 //          Amortized: O(n)
@@ -30,6 +236,9 @@ template <Iterator I, typename T, BinaryOperation Op>
 inline
 T accumulate(I f, I l, T init, Op op) {
     // return sum of init and all in [f, l), using op
+    if constexpr (detail::accumulate_vectorizable<I, T, Op, detail::identity_function, false>()) {
+        return detail::accumulate_contiguous_n(f, std::size_t(l - f), init, op, detail::identity_function{});
+    }
     while (f != l) {
         init = op(init, *f);
         ++f;
@@ -48,6 +257,9 @@ template <Iterator I, typename T, BinaryOperation Op>
 inline
 T accumulate_n(I f, DistanceType<I> n, T init, Op op) {
     // return sum of init and all in [f, n), using op
+    if constexpr (detail::accumulate_vectorizable<I, T, Op, detail::identity_function, false>()) {
+        return detail::accumulate_contiguous_n(f, std::size_t(n), init, op, detail::identity_function{});
+    }
     while (n != 0) {
         init = op(init, *f);
         --n;
@@ -82,6 +294,9 @@ template <Iterator I, typename T, BinaryOperation Op, UnaryFunction F>
 inline
 T accumulate(I f, I l, T init, Op op, F fun) {
     // return sum of init and all in [f, l), using op and fun
+    if constexpr (detail::accumulate_vectorizable<I, T, Op, F, false>()) {
+        return detail::accumulate_contiguous_n(f, std::size_t(l - f), init, op, fun);
+    }
     while (f != l) {
         init = op(init, fun(*f));
         ++f;
@@ -101,6 +316,9 @@ template <Iterator I, typename T, BinaryOperation Op, UnaryFunction F>
 inline
 T accumulate_n(I f, DistanceType<I> n, T init, Op op, F fun) {
     // return sum of init and all in [f, n), using op and fun
+    if constexpr (detail::accumulate_vectorizable<I, T, Op, F, false>()) {
+        return detail::accumulate_contiguous_n(f, std::size_t(n), init, op, fun);
+    }
     while (n != 0) {
         init = op(init, fun(*f));
         --n;
@@ -126,6 +344,149 @@ T accumulate_n(I f, DistanceType<I> n, T init, Op op, F fun) {
 
 
 
+
+// Unordered accumulation: op is also allowed to be reassociated and
+// commuted. This is the explicit opt-in that lets floating point ranges
+// use the vectorized kernels (std::plus, std::multiplies, minimum and
+// maximum over contiguous ranges); the result may then differ from
+// accumulate in the last bits. For integers it is the same as accumulate.
+
+//Complexity:
+//      Runtime:
+//          Exact:     n applications of op (and of fun)
+//      Space:
+//          O(1)
+template <Iterator I, typename T, BinaryOperation Op, UnaryFunction F>
+// requires T == Domain(F)
+//          Codomain(F) == Domain(Op))
+//          Op is associative and commutative
+inline
+T accumulate_unordered(I f, I l, T init, Op op, F fun) {
+    if constexpr (detail::accumulate_vectorizable<I, T, Op, F, true>()) {
+        return detail::accumulate_contiguous_n(f, std::size_t(l - f), init, op, fun);
+    } else {
+        return tao::algorithm::accumulate(f, l, init, op, fun);
+    }
+}
+
+template <Iterator I, typename T, BinaryOperation Op>
+// requires T == Domain(Op)
+//          Op is associative and commutative
+inline
+T accumulate_unordered(I f, I l, T init, Op op) {
+    return accumulate_unordered(f, l, init, op, detail::identity_function{});
+}
+
+template <Iterator I, typename T, BinaryOperation Op, UnaryFunction F>
+// requires T == Domain(F)
+//          Codomain(F) == Domain(Op))
+//          Op is associative and commutative
+inline
+T accumulate_n_unordered(I f, DistanceType<I> n, T init, Op op, F fun) {
+    if constexpr (detail::accumulate_vectorizable<I, T, Op, F, true>()) {
+        return detail::accumulate_contiguous_n(f, std::size_t(n), init, op, fun);
+    } else {
+        return tao::algorithm::accumulate_n(f, n, init, op, fun);
+    }
+}
+
+template <Iterator I, typename T, BinaryOperation Op>
+// requires T == Domain(Op)
+//          Op is associative and commutative
+inline
+T accumulate_n_unordered(I f, DistanceType<I> n, T init, Op op) {
+    return accumulate_n_unordered(f, n, init, op, detail::identity_function{});
+}
+
 }} /*tao::algorithm*/
 
 #endif /*TAO_ALGORITHM_ACCUMULATE_HPP*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <cstdint>
+#include <forward_list>
+#include <vector>
+
+TEST_CASE("[accumulate] testing vectorized integer accumulate is bitwise identical") {
+    using namespace tao::algorithm;
+
+    auto accumulate_sequential = [](auto const& v, auto init, auto op) {
+        for (auto const& x : v) init = op(init, x);
+        return init;
+    };
+
+    auto check_accumulate_all_isas = [&](auto const& v, auto init, auto op) {
+        using V = std::decay_t<decltype(v[0])>;
+        auto expected = accumulate_sequential(v, init, op);
+        for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+            set_simd_isa_limit(isa);
+            for (std::size_t n : {std::size_t(0), std::size_t(1), std::size_t(31), std::size_t(257), v.size()}) {
+                std::vector<V> w(v.begin(), v.begin() + n);
+                CHECK(tao::algorithm::accumulate(w.begin(), w.end(), init, op) == accumulate_sequential(w, init, op));
+            }
+            CHECK(tao::algorithm::accumulate(v.begin(), v.end(), init, op) == expected);
+            CHECK(tao::algorithm::accumulate_n(v.data(), v.size(), init, op) == expected);
+        }
+        set_simd_isa_limit(simd_isa::avx512);
+    };
+
+    // Sums and products that wrap are on unsigned data, the reference
+    // loop itself must not overflow a signed type.
+    std::vector<std::int8_t> a8;
+    std::vector<std::int32_t> s32;
+    std::vector<std::uint32_t> a32;
+    std::vector<std::uint64_t> a64;
+    for (int i = 0; i < 10007; ++i) {
+        a8.push_back(std::int8_t(i * 37));
+        s32.push_back(std::int32_t(i * 2654435761u));
+        a32.push_back(std::uint32_t(i * 2654435761u));
+        a64.push_back(std::uint64_t(i) * 0x9E3779B97F4A7C15ull);
+    }
+
+    check_accumulate_all_isas(a8, std::int8_t(0), std::plus<>());
+    check_accumulate_all_isas(a8, std::int32_t(0), std::plus<>());
+    check_accumulate_all_isas(a8, std::int8_t(1), std::multiplies<>());
+    check_accumulate_all_isas(a32, std::uint32_t(0), std::plus<std::uint32_t>());
+    check_accumulate_all_isas(a32, std::uint32_t(1), std::multiplies<>());
+    check_accumulate_all_isas(s32, std::int32_t(0), minimum<>());
+    check_accumulate_all_isas(s32, std::int32_t(0), maximum<>());
+    check_accumulate_all_isas(a64, std::uint64_t(0), std::plus<>());
+    check_accumulate_all_isas(a64, std::uint64_t(3), std::multiplies<>());
+    check_accumulate_all_isas(a64, std::uint64_t(-1), minimum<std::uint64_t>());
+
+    // An op on a narrower type converts its operands: the sequential loop.
+    std::vector<int> const hundreds(1000, 100);
+    CHECK(tao::algorithm::accumulate(hundreds.begin(), hundreds.end(), 0, std::plus<std::int8_t>()) ==
+          accumulate_sequential(hundreds, 0, std::plus<std::int8_t>()));
+    CHECK(tao::algorithm::accumulate(hundreds.begin(), hundreds.end(), 0, std::plus<>()) == 100000);
+
+    auto sq = [](std::uint32_t x) { return std::uint64_t(x) * x; };
+    CHECK(tao::algorithm::accumulate(a32.begin(), a32.end(), std::uint64_t(0), std::plus<>(), sq) ==
+          tao::algorithm::accumulate(std::forward_list<std::uint32_t>(a32.begin(), a32.end()).begin(),
+                                     std::forward_list<std::uint32_t>::iterator(), std::uint64_t(0), std::plus<>(), sq));
+}
+
+TEST_CASE("[accumulate] testing accumulate_unordered floating point") {
+    using namespace tao::algorithm;
+
+    std::vector<double> a;
+    for (int i = 1; i <= 10000; ++i) a.push_back(1.0 / i);
+
+    double expected = tao::algorithm::accumulate(a.begin(), a.end(), 0.0, std::plus<>());
+    for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+        set_simd_isa_limit(isa);
+        CHECK(accumulate_unordered(a.begin(), a.end(), 0.0, std::plus<>()) == doctest::Approx(expected));
+        CHECK(accumulate_n_unordered(a.begin(), a.size(), 0.0, maximum<double>()) == 1.0);
+        CHECK(accumulate_unordered(a.begin(), a.end(), 2.0, minimum<double>()) == 1.0 / 10000);
+        CHECK(accumulate_unordered(a.begin(), a.end(), 0.0, std::plus<>(), [](double x) { return x * x; }) ==
+              doctest::Approx(1.6448340718480652));
+    }
+    set_simd_isa_limit(simd_isa::avx512);
+
+    std::vector<float> b(1000, 0.5f);
+    CHECK(accumulate_unordered(b.begin(), b.end(), 0.0f, std::plus<>()) == 500.0f);
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
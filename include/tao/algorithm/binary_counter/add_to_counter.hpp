@@ -8,6 +8,8 @@
 #ifndef TAO_ALGORITHM_BINARY_COUNTER_ADD_TO_COUNTER_HPP_
 #define TAO_ALGORITHM_BINARY_COUNTER_ADD_TO_COUNTER_HPP_
 
+#include <utility>
+
 #include <tao/algorithm/concepts.hpp>
 #include <tao/algorithm/type_attributes.hpp>
 
@@ -20,7 +22,7 @@ ValueType<I> add_to_counter_nonzeroes(I f, I l, Op op, ValueType<I> x, ValueType
     // precondition: x != z
     while (f != l) {
         if (*f == z) {
-            *f = x;
+            *f = std::move(x);
             return z;
         }
         x = op(*f, x);
@@ -34,7 +36,7 @@ template <ForwardIterator I, BinaryOperation Op>
     requires(Mutable<I> && ValueType<I> == Domain<Op>)
 ValueType<I> add_to_counter(I f, I l, Op op, ValueType<I> x, ValueType<I> const& z) {
     if (x == z) return z;
-    return add_to_counter_nonzeroes(f, l, op, x, z);
+    return add_to_counter_nonzeroes(f, l, op, std::move(x), z);
 }
 
 // TODO: requires associativity on Op?
@@ -44,7 +46,7 @@ void add_to_counter_unguarded_nonzeroes(I f, Op op, ValueType<I> x, ValueType<I>
     // precondition: x != z
     while (true) {
         if (*f == z) {
-            *f = x;
+            *f = std::move(x);
             return;
         }
         x = op(*f, x);
@@ -57,7 +59,7 @@ template <ForwardIterator I, BinaryOperation Op>
     requires(Mutable<I> && ValueType<I> == Domain<Op>)
 void add_to_counter_unguarded(I f, Op op, ValueType<I> x, ValueType<I> const& z) {
     if (x == z) return;
-    add_to_counter_unguarded_nonzeroes(f, op, x, z);
+    add_to_counter_unguarded_nonzeroes(f, op, std::move(x), z);
 }
 
 } // namespace tao::algorithm
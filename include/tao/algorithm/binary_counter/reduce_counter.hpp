@@ -0,0 +1,42 @@
+//! \file tao/algorithm/binary_counter/reduce_counter.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_BINARY_COUNTER_REDUCE_COUNTER_HPP_
+#define TAO_ALGORITHM_BINARY_COUNTER_REDUCE_COUNTER_HPP_
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao::algorithm {
+
+// Slot i of the counter holds the reduction of 2^i elements. The slots are
+// visited from the lowest occupied one up, and every higher slot is applied
+// as the left operand: x = op(slot, x). The result is then
+// op(s_k, op(..., op(s_j, s_i))) for the occupied slots i < j < ... < k,
+// the highest slot leftmost. Since add_to_counter leaves the earlier
+// elements in the higher slots, that is the order of the input, and an
+// associative op needs no commutativity.
+template <ForwardIterator I, BinaryOperation Op>
+    requires(Readable<I> && ValueType<I> == Domain<Op>)
+ValueType<I> reduce_counter(I f, I l, Op op, ValueType<I> const& z) {
+    // precondition: Op is associative
+    while (f != l && *f == z) ++f;
+    if (f == l) return z;
+
+    ValueType<I> x = *f;
+    ++f;
+    while (f != l) {
+        if (*f != z) x = op(*f, x);
+        ++f;
+    }
+    return x;
+}
+
+} // namespace tao::algorithm
+
+#include <tao/algorithm/concepts_undef.hpp>
+#endif /* TAO_ALGORITHM_BINARY_COUNTER_REDUCE_COUNTER_HPP_ */
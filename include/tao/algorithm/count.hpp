@@ -10,21 +10,365 @@
 #define TAO_ALGORITHM_COUNT_HPP_
 
 // #include <algorithm>
-// #include <iterator>
-// #include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 #include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/find.hpp>
+#include <tao/algorithm/integers.hpp>
+#include <tao/algorithm/predicates.hpp>
+#include <tao/algorithm/simd.hpp>
 #include <tao/algorithm/type_attributes.hpp>
 #include <tao/algorithm/for_each.hpp>
 
 namespace tao { namespace algorithm {
 
+// ------------------------------------------------------------------------
+// Vectorized counting
+// ------------------------------------------------------------------------
+// On contiguous ranges of integers, float or double, count and count_if
+// with the predicates of predicates.hpp count without branches, with the
+// comparisons of find.hpp. With SSE2 and AVX2 the all-ones lanes of the
+// comparison are subtracted from lane counters, which are summed into the
+// result before they can overflow (every 255 vectors for bytes, with
+// psadbw). With AVX-512 the comparison gives a mask and it is popcounted.
+// The last, partial vector is a full one ending at l whose lanes already
+// counted are shifted out. not_equal is counted as n minus equal.
+//
+// Packed bits (count_bits, and std::vector<bool> with libstdc++) are
+// counted a word at a time with popcount, 32 or 64 bytes at a time with
+// the nibble lookup table of pshufb when AVX2 is there.
+//
+// The counter is only vectorized when it is an integer.
+
+namespace detail {
+
+template <Iterator I, typename P, typename J>
+constexpr bool count_vectorizable() {
+    return find_vectorizable<I, P>() && std::is_integral<J>::value;
+}
+
+template <compare_kind K, typename T>
+std::size_t count_compare_scalar(T const* p, std::size_t n, compare_operands<T> const& o) {
+    std::size_t res = 0;
+    for (std::size_t i = 0; i != n; ++i) res += std::size_t(compare_test<K>(p[i], o));
+    return res;
+}
+
+// Vectors counted per lane before the lane counters are summed, two
+// accumulators.
+template <typename T>
+constexpr std::size_t count_block() {
+    using L = modular_unsigned_t<T>;
+    return 2 * std::size_t((std::min)(std::uintmax_t(std::numeric_limits<L>::max()), std::uintmax_t(65535)));
+}
+
+#if defined(TAO_ALGORITHM_SIMD_X86)
+
+template <typename T>
+TAO_ALGORITHM_TARGET_SSE2 TAO_ALGORITHM_ALWAYS_INLINE
+std::size_t lane_sum_sse2(__m128i x) {
+    // Bytes are summed in 64-bit lanes by psadbw.
+    using L = std::conditional_t<sizeof(T) == 1, std::uint64_t, modular_unsigned_t<T>>;
+    if constexpr (sizeof(T) == 1) x = _mm_sad_epu8(x, _mm_setzero_si128());
+    alignas(16) L lanes[16 / sizeof(L)];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), x);
+    std::size_t res = 0;
+    for (L y : lanes) res += std::size_t(y);
+    return res;
+}
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_SSE2
+std::size_t count_compare_sse2(T const* p, std::size_t n, compare_operands<T> const& o) {
+    constexpr std::size_t E = 16 / sizeof(T);
+    if (n < E) return count_compare_scalar<K>(p, n, o);
+    __m128i const a = broadcast_sse2(o.a);
+    __m128i const b = broadcast_sse2(o.b);
+
+    std::size_t res = 0;
+    std::size_t i = 0;
+    while (n - i >= E) {
+        std::size_t const vectors = (std::min)(count_block<T>(), (n - i) / E);
+        __m128i acc0 = _mm_setzero_si128();
+        __m128i acc1 = _mm_setzero_si128();
+        std::size_t k = 0;
+        for (; k + 2 <= vectors; k += 2, i += 2 * E) {
+            acc0 = subtract_sse2<T>(acc0, compare_lanes_sse2<K, T>(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i)), a, b));
+            acc1 = subtract_sse2<T>(acc1, compare_lanes_sse2<K, T>(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i + E)), a, b));
+        }
+        if (k != vectors) {
+            acc0 = subtract_sse2<T>(acc0, compare_lanes_sse2<K, T>(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i)), a, b));
+            i += E;
+        }
+        res += lane_sum_sse2<T>(acc0) + lane_sum_sse2<T>(acc1);
+    }
+    if (i != n) {
+        std::uint32_t const m = std::uint32_t(_mm_movemask_epi8(compare_lanes_sse2<K, T>(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p + n - E)), a, b)));
+        res += std::size_t(popcount(m >> ((E - (n - i)) * sizeof(T)))) / sizeof(T);
+    }
+    return res;
+}
+
+template <typename T>
+TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_ALWAYS_INLINE
+std::size_t lane_sum_avx2(__m256i x) {
+    // Bytes are summed in 64-bit lanes by psadbw.
+    using L = std::conditional_t<sizeof(T) == 1, std::uint64_t, modular_unsigned_t<T>>;
+    if constexpr (sizeof(T) == 1) x = _mm256_sad_epu8(x, _mm256_setzero_si256());
+    alignas(32) L lanes[32 / sizeof(L)];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), x);
+    std::size_t res = 0;
+    for (L y : lanes) res += std::size_t(y);
+    return res;
+}
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_AVX2
+std::size_t count_compare_avx2(T const* p, std::size_t n, compare_operands<T> const& o) {
+    constexpr std::size_t E = 32 / sizeof(T);
+    if (n < E) return count_compare_scalar<K>(p, n, o);
+    __m256i const a = broadcast_avx2(o.a);
+    __m256i const b = broadcast_avx2(o.b);
+
+    std::size_t res = 0;
+    std::size_t i = 0;
+    while (n - i >= E) {
+        std::size_t const vectors = (std::min)(count_block<T>(), (n - i) / E);
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        std::size_t k = 0;
+        for (; k + 2 <= vectors; k += 2, i += 2 * E) {
+            acc0 = subtract_avx2<T>(acc0, compare_lanes_avx2<K, T>(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i)), a, b));
+            acc1 = subtract_avx2<T>(acc1, compare_lanes_avx2<K, T>(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i + E)), a, b));
+        }
+        if (k != vectors) {
+            acc0 = subtract_avx2<T>(acc0, compare_lanes_avx2<K, T>(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i)), a, b));
+            i += E;
+        }
+        res += lane_sum_avx2<T>(acc0) + lane_sum_avx2<T>(acc1);
+    }
+    if (i != n) {
+        std::uint64_t const m = std::uint32_t(_mm256_movemask_epi8(compare_lanes_avx2<K, T>(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + n - E)), a, b)));
+        res += std::size_t(popcount(m >> ((E - (n - i)) * sizeof(T)))) / sizeof(T);
+    }
+    return res;
+}
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_AVX512
+std::size_t count_compare_avx512(T const* p, std::size_t n, compare_operands<T> const& o) {
+    constexpr std::size_t E = 64 / sizeof(T);
+    if (n < E) return count_compare_scalar<K>(p, n, o);
+    __m512i const a = broadcast_avx512(o.a);
+    __m512i const b = broadcast_avx512(o.b);
+
+    std::size_t res = 0;
+    std::size_t i = 0;
+    for (; i + 2 * E <= n; i += 2 * E) {
+        res += std::size_t(popcount(compare_lanes_avx512<K, T>(_mm512_loadu_si512(p + i), a, b)));
+        res += std::size_t(popcount(compare_lanes_avx512<K, T>(_mm512_loadu_si512(p + i + E), a, b)));
+    }
+    if (i + E <= n) {
+        res += std::size_t(popcount(compare_lanes_avx512<K, T>(_mm512_loadu_si512(p + i), a, b)));
+        i += E;
+    }
+    if (i != n) {
+        res += std::size_t(popcount(compare_lanes_avx512<K, T>(_mm512_loadu_si512(p + n - E), a, b) >> (E - (n - i))));
+    }
+    return res;
+}
+
+#endif
+
+// Number of elements of [p, p + n) that satisfy the comparison.
+template <compare_kind K, typename T>
+std::size_t count_compare(T const* p, std::size_t n, compare_operands<T> const& o) {
+    if constexpr (K == compare_kind::not_equal) {
+        return n - count_compare<compare_kind::equal>(p, n, o);
+    } else {
+#if defined(TAO_ALGORITHM_SIMD_X86)
+        switch (simd_isa_level()) {
+            case simd_isa::avx512: return count_compare_avx512<K>(p, n, o);
+            case simd_isa::avx2: return count_compare_avx2<K>(p, n, o);
+            case simd_isa::sse2:
+                if constexpr (sizeof(T) < 8 || std::is_floating_point<T>::value) {
+                    return count_compare_sse2<K>(p, n, o);
+                }
+                break;
+            default: break;
+        }
+#endif
+        return count_compare_scalar<K>(p, n, o);
+    }
+}
+
+template <Iterator I, typename P>
+std::size_t count_if_contiguous(I f, I l, P const& p) {
+    using T = std::remove_cv_t<ValueType<I>>;
+    if (f == l || compare_empty(p)) return 0;
+    constexpr auto kind = compare_kind_of<P>::value;
+    return count_compare<kind, T>(std::addressof(*f), std::size_t(l - f), compare_operands_of(p));
+}
+
+// Packed bits.
+
+template <typename W>
+std::uint64_t bit_mask(std::size_t f, std::size_t l) {
+    //precondition: f <= l <= bits of W
+    constexpr std::size_t bits = 8 * sizeof(W);
+    std::uint64_t const high = l == bits ? ~std::uint64_t(0) : low_bits(l);
+    return high & ~low_bits(f);
+}
+
+template <typename W>
+std::size_t popcount_words_scalar(W const* p, std::size_t n) {
+    std::size_t res = 0;
+    for (std::size_t i = 0; i != n; ++i) res += std::size_t(popcount(std::uint64_t(p[i])));
+    return res;
+}
+
+#if defined(TAO_ALGORITHM_SIMD_X86)
+
+// Bits set in each byte of x, from two lookups of a nibble table.
+TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_ALWAYS_INLINE
+__m256i popcount_bytes_avx2(__m256i x) {
+    __m256i const table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    __m256i const low = _mm256_set1_epi8(0x0f);
+    __m256i const lo = _mm256_shuffle_epi8(table, _mm256_and_si256(x, low));
+    __m256i const hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(x, 4), low));
+    return _mm256_add_epi8(lo, hi);
+}
+
+template <typename W>
+TAO_ALGORITHM_TARGET_AVX2
+std::size_t popcount_words_avx2(W const* p, std::size_t n) {
+    constexpr std::size_t E = 32 / sizeof(W);
+    __m256i acc = _mm256_setzero_si256();
+    std::size_t i = 0;
+    // At most 8 per byte and vector, the byte counters take 31 vectors.
+    while (n - i >= 2 * E) {
+        std::size_t const vectors = (std::min)(std::size_t(30), (n - i) / E) & ~std::size_t(1);
+        __m256i bytes = _mm256_setzero_si256();
+        for (std::size_t k = 0; k != vectors; k += 2, i += 2 * E) {
+            bytes = _mm256_add_epi8(bytes, popcount_bytes_avx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i))));
+            bytes = _mm256_add_epi8(bytes, popcount_bytes_avx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i + E))));
+        }
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    std::size_t res = std::size_t(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    for (; i != n; ++i) res += std::size_t(popcount(std::uint64_t(p[i])));
+    return res;
+}
+
+TAO_ALGORITHM_TARGET_AVX512 TAO_ALGORITHM_ALWAYS_INLINE
+__m512i popcount_bytes_avx512(__m512i x) {
+    // 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 in every 128-bit lane.
+    __m512i const table = _mm512_set4_epi64(0x0403030203020201, 0x0302020102010100,
+                                            0x0403030203020201, 0x0302020102010100);
+    __m512i const low = _mm512_set1_epi8(0x0f);
+    __m512i const lo = _mm512_shuffle_epi8(table, _mm512_and_si512(x, low));
+    __m512i const hi = _mm512_shuffle_epi8(table, _mm512_and_si512(_mm512_srli_epi16(x, 4), low));
+    return _mm512_add_epi8(lo, hi);
+}
+
+template <typename W>
+TAO_ALGORITHM_TARGET_AVX512
+std::size_t popcount_words_avx512(W const* p, std::size_t n) {
+    constexpr std::size_t E = 64 / sizeof(W);
+    __m512i acc = _mm512_setzero_si512();
+    std::size_t i = 0;
+    while (n - i >= 2 * E) {
+        std::size_t const vectors = (std::min)(std::size_t(30), (n - i) / E) & ~std::size_t(1);
+        __m512i bytes = _mm512_setzero_si512();
+        for (std::size_t k = 0; k != vectors; k += 2, i += 2 * E) {
+            bytes = _mm512_add_epi8(bytes, popcount_bytes_avx512(_mm512_loadu_si512(p + i)));
+            bytes = _mm512_add_epi8(bytes, popcount_bytes_avx512(_mm512_loadu_si512(p + i + E)));
+        }
+        acc = _mm512_add_epi64(acc, _mm512_sad_epu8(bytes, _mm512_setzero_si512()));
+    }
+    alignas(64) std::uint64_t lanes[8];
+    _mm512_store_si512(lanes, acc);
+    std::size_t res = 0;
+    for (std::uint64_t y : lanes) res += std::size_t(y);
+    for (; i != n; ++i) res += std::size_t(popcount(std::uint64_t(p[i])));
+    return res;
+}
+
+#endif
+
+// Bits set in the words [p, p + n).
+template <typename W>
+std::size_t popcount_words(W const* p, std::size_t n) {
+#if defined(TAO_ALGORITHM_SIMD_X86)
+    switch (simd_isa_level()) {
+        case simd_isa::avx512: return popcount_words_avx512(p, n);
+        case simd_isa::avx2: return popcount_words_avx2(p, n);
+        default: break;
+    }
+#endif
+    return popcount_words_scalar(p, n);
+}
+
+template <typename I>
+struct is_packed_bit_iterator : std::false_type {};
+
+#if defined(__GLIBCXX__) && ! defined(_GLIBCXX_DEBUG)
+// libstdc++ keeps the bits of std::vector<bool> in unsigned long words and
+// its iterators are a word pointer and a bit offset. The debug mode wraps
+// them in checked iterators.
+template <>
+struct is_packed_bit_iterator<std::vector<bool>::iterator> : std::true_type {};
+
+template <>
+struct is_packed_bit_iterator<std::vector<bool>::const_iterator> : std::true_type {};
+#endif
+
+} // namespace detail
+
+//Complexity:
+//      Runtime:
+//          O(l - f) word operations
+//      Space:
+//          O(1)
+//
+// Number of set bits among the bits [f, l) of the words at p, bit i being
+// bit i % (8 * sizeof(W)) of p[i / (8 * sizeof(W))].
+template <Integer W>
+std::size_t count_bits(W const* p, std::size_t f, std::size_t l) {
+    //precondition: f <= l && readable_bounded_range(p, p + (l + 8 * sizeof(W) - 1) / (8 * sizeof(W)))
+    static_assert(std::is_unsigned<W>::value && sizeof(W) <= 8, "count_bits works on unsigned words up to 64 bits");
+    constexpr std::size_t bits = 8 * sizeof(W);
+    if (f == l) return 0;
+    p += f / bits;
+    l -= f - f % bits;
+    f %= bits;
+    if (l <= bits) return std::size_t(popcount(std::uint64_t(*p) & detail::bit_mask<W>(f, l)));
+
+    std::size_t res = std::size_t(popcount(std::uint64_t(*p) & detail::bit_mask<W>(f, bits)));
+    std::size_t const words = l / bits;
+    res += detail::popcount_words(p + 1, words - 1);
+    if (l % bits != 0) res += std::size_t(popcount(std::uint64_t(p[words]) & detail::bit_mask<W>(0, l % bits)));
+    return res;
+}
+
 //Complexity:
 template <Iterator I, UnaryPredicate P, Iterator J>
     requires(Readable<I> && Procedure<Proc> && Arity<Proc> == 1 &&
         ValueType<I> == Domain<P>)
 J count_if(I f, I l, P p, J j) {
     // precondition: readable_bounded_range(f, l)
+    if constexpr (detail::count_vectorizable<I, P, J>()) {
+        return J(j + J(detail::count_if_contiguous(f, l, p)));
+    }
     while (f != l) {
         if (p(*f)) ++j;
         ++f;
@@ -40,6 +384,30 @@ DistanceType<I> count_if(I f, I l, P p) {
     return count_if(f, l, p, DistanceType<I>(0));
 }
 
+template <Iterator I, Iterator J>
+    requires(Readable<I>)
+J count(I f, I l, ValueType<I> const& x, J j) {
+    // precondition: readable_bounded_range(f, l)
+    using T = std::remove_cv_t<ValueType<I>>;
+    if constexpr (detail::is_packed_bit_iterator<I>::value && std::is_integral<J>::value) {
+#if defined(__GLIBCXX__) && ! defined(_GLIBCXX_DEBUG)
+        constexpr std::size_t bits = 8 * sizeof(*f._M_p);
+        std::size_t const last = std::size_t(l._M_p - f._M_p) * bits + l._M_offset;
+        std::size_t const ones = count_bits(f._M_p, f._M_offset, last);
+        return J(j + J(x ? ones : std::size_t(l - f) - ones));
+#endif
+    } else {
+        return count_if(f, l, equal_to_value<T>(x), j);
+    }
+}
+
+template <Iterator I>
+    requires(Readable<I>)
+DistanceType<I> count(I f, I l, ValueType<I> const& x) {
+    // precondition: readable_bounded_range(f, l)
+    return count(f, l, x, DistanceType<I>(0));
+}
+
 
 //EoP Exercise 6.2 page 98
 template <UnaryPredicate P, Iterator J>
@@ -66,7 +434,9 @@ template <Iterator I, UnaryPredicate P, Iterator J>
     requires(Readable<I> && Procedure<Proc> && Arity<Proc> == 1 &&
         ValueType<I> == Domain<P>)
 J count_if_2(I f, I l, P p, J j) {
-
+    if constexpr (detail::count_vectorizable<I, P, J>()) {
+        return J(j + J(detail::count_if_contiguous(f, l, p)));
+    }
     auto proc = tao::algorithm::for_each(f, l, count_if_func<P, J>(p, j));
     return proc.j;
 }
@@ -78,12 +448,16 @@ J count_if_2(I f, I l, P p, J j) {
 
 
 #ifdef DOCTEST_LIBRARY_INCLUDED
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
 #include <vector>
 
-using namespace tao::algorithm;
-using namespace std;
-
 TEST_CASE("[count_if_2] testing max_element selection algorithm, random access, no natural order, stability check") {
+    using namespace tao::algorithm;
+    using namespace std;
+
     vector<int> a = {1, 2, 3, 4, 5, 6, 7, 8, 9};
 
     auto even = [](int x) {
@@ -97,4 +471,123 @@ TEST_CASE("[count_if_2] testing max_element selection algorithm, random access,
     CHECK(res == 4);
 }
 
+TEST_CASE("[count] testing vectorized count and count_if against the scalar loops") {
+    using namespace tao::algorithm;
+
+    auto check = [](auto const& v, auto x, auto a, auto b) {
+        using T = decltype(x);
+        // Every offset and length up to a few vectors, including the tails.
+        for (std::size_t s = 0; s != 9; ++s) {
+            for (std::size_t n = 0; s + n <= v.size() && n <= 300; n += 1 + n / 16) {
+                auto const f = v.begin() + s;
+                auto const l = f + n;
+                auto reference = [&](auto p) {
+                    std::ptrdiff_t r = 0;
+                    for (auto it = f; it != l; ++it) if (p(*it)) ++r;
+                    return r;
+                };
+                CHECK(tao::algorithm::count(f, l, x) == reference([&](T y) { return y == x; }));
+                CHECK(tao::algorithm::count_if(f, l, not_equal_to_value<T>(x)) == reference([&](T y) { return y != x; }));
+                CHECK(tao::algorithm::count_if(f, l, less_than_value<T>(x)) == reference([&](T y) { return y < x; }));
+                CHECK(tao::algorithm::count_if(f, l, greater_than_value<T>(x)) == reference([&](T y) { return x < y; }));
+                CHECK(tao::algorithm::count_if(f, l, within_range<T>(a, b)) == reference([&](T y) { return ! (y < a) && y < b; }));
+                CHECK(tao::algorithm::count_if(f, l, within_range<T>(b, a)) == 0);
+                CHECK(count_if_2(f, l, less_than_value<T>(x), std::size_t(3)) == std::size_t(3 + reference([&](T y) { return y < x; })));
+            }
+        }
+    };
+
+    for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+        set_simd_isa_limit(isa);
+
+        std::vector<std::uint8_t> u8(330);
+        std::vector<std::int16_t> i16(330);
+        std::vector<std::int32_t> i32(330);
+        std::vector<std::uint64_t> u64(330);
+        std::vector<float> f32(330);
+        std::vector<double> f64(330);
+        for (std::size_t i = 0; i != u8.size(); ++i) {
+            u8[i] = std::uint8_t(i * 37 % 251);
+            i16[i] = std::int16_t(int(i * 7919 % 1000) - 500);
+            i32[i] = std::int32_t(i % 3 == 0 ? -int(i) : int(i % 17));
+            u64[i] = i % 5 == 0 ? ~std::uint64_t(0) - i : std::uint64_t(i % 11);
+            f32[i] = i % 13 == 0 ? std::numeric_limits<float>::quiet_NaN() : float(int(i % 9) - 4) * 0.5f;
+            f64[i] = i % 7 == 0 ? -0.0 : double(int(i % 10) - 5);
+        }
+        check(u8, std::uint8_t(111), std::uint8_t(10), std::uint8_t(200));
+        check(i16, std::int16_t(-8), std::int16_t(-300), std::int16_t(42));
+        check(i32, std::int32_t(5), std::int32_t(-100), std::int32_t(9));
+        check(u64, std::uint64_t(3), std::uint64_t(2), ~std::uint64_t(0) - 40);
+        check(f32, 0.5f, -1.0f, 1.5f);
+        check(f32, std::numeric_limits<float>::quiet_NaN(), -1.0f, 1.5f);
+        check(f64, 0.0, -3.0, 0.0);
+    }
+    set_simd_isa_limit(simd_isa::avx512);
+
+    // More than the 255 vectors a byte counter takes.
+    std::vector<std::int8_t> big(100003, std::int8_t(-1));
+    big[77] = 0;
+    for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+        set_simd_isa_limit(isa);
+        CHECK(tao::algorithm::count(big.begin(), big.end(), std::int8_t(-1)) == 100002);
+        CHECK(tao::algorithm::count_if(big.begin() + 1, big.end(), less_than_value<std::int8_t>(0)) == 100001);
+    }
+    set_simd_isa_limit(simd_isa::avx512);
+}
+
+TEST_CASE("[count] testing count_bits and count on std::vector<bool>") {
+    using namespace tao::algorithm;
+
+    std::vector<std::uint64_t> words(70);
+    std::vector<bool> bits(words.size() * 64);
+    for (std::size_t i = 0; i != bits.size(); ++i) {
+        bool const b = (i * 2654435761u >> 7) % 3 == 0;
+        bits[i] = b;
+        if (b) words[i / 64] |= std::uint64_t(1) << (i % 64);
+    }
+    std::vector<std::uint8_t> bytes(words.size() * 8);
+    for (std::size_t i = 0; i != bits.size(); ++i) {
+        if (bits[i]) bytes[i / 8] |= std::uint8_t(1u << (i % 8));
+    }
+
+    for (auto isa : {simd_isa::scalar, simd_isa::avx2, simd_isa::avx512}) {
+        set_simd_isa_limit(isa);
+        for (std::size_t f : {0, 1, 63, 64, 65, 200}) {
+            for (std::size_t l = f; l <= bits.size(); l += 1 + l / 8) {
+                std::size_t r = 0;
+                for (std::size_t i = f; i != l; ++i) r += bits[i];
+                CHECK(count_bits(words.data(), f, l) == r);
+                CHECK(count_bits(bytes.data(), f, l) == r);
+                CHECK(tao::algorithm::count(bits.begin() + f, bits.begin() + l, true) == std::ptrdiff_t(r));
+                CHECK(tao::algorithm::count(bits.cbegin() + f, bits.cbegin() + l, false) == std::ptrdiff_t(l - f - r));
+            }
+        }
+    }
+    set_simd_isa_limit(simd_isa::avx512);
+
+    // Empty ranges read no word: a null word pointer, and the end of a
+    // vector whose last word is full.
+    std::vector<bool> const empty;
+    CHECK(tao::algorithm::count(empty.begin(), empty.end(), true) == 0);
+    CHECK(tao::algorithm::count(empty.begin(), empty.end(), false) == 0);
+    std::vector<bool> const full(64, true);
+    CHECK(tao::algorithm::count(full.end(), full.end(), true) == 0);
+    CHECK(tao::algorithm::count(full.begin(), full.end(), true) == 64);
+    CHECK(count_bits(static_cast<std::uint64_t const*>(nullptr), 0, 0) == 0);
+
+    // The generic loop: reverse iterators are not packed bit iterators, and
+    // an iterator as the counter is not an integer.
+    for (std::size_t f : {0, 1, 63, 64, 65, 200}) {
+        for (std::size_t l = f; l <= bits.size(); l += 1 + l / 4) {
+            auto const r = tao::algorithm::count(bits.begin() + f, bits.begin() + l, true);
+            auto const rf = std::make_reverse_iterator(bits.begin() + l);
+            auto const rl = std::make_reverse_iterator(bits.begin() + f);
+            CHECK(tao::algorithm::count(rf, rl, true) == r);
+            CHECK(tao::algorithm::count(rf, rl, false) == std::ptrdiff_t(l - f) - r);
+            CHECK(tao::algorithm::count(bits.cbegin() + f, bits.cbegin() + l, true, bits.cbegin()) - bits.cbegin() == r);
+            CHECK(tao::algorithm::count(bits.cbegin() + f, bits.cbegin() + l, false, bits.cbegin()) - bits.cbegin() == std::ptrdiff_t(l - f) - r);
+        }
+    }
+}
+
 #endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -9,9 +9,12 @@
 #ifndef TAO_ALGORITHM_COUNTER_MACHINE_HPP
 #define TAO_ALGORITHM_COUNTER_MACHINE_HPP
 
+#include <cstddef>
+#include <utility>
 // #include <iterator>
 
 #include <tao/algorithm/binary_counter/add_to_counter.hpp>
+#include <tao/algorithm/binary_counter/reduce_counter.hpp>
 #include <tao/algorithm/concepts.hpp>
 // #include <tao/algorithm/integers.hpp>
 #include <tao/algorithm/type_attributes.hpp>
@@ -35,19 +38,39 @@ struct counter_machine {
 
     void add(T x) {
         // precondition: must not be called more than 2^Size - 1 times
-        x = add_to_counter(f, l, op, x, e);
+        x = add_to_counter(f, l, op, std::move(x), e);
         if (x != e) {
-            *l = x;
+            *l = std::move(x);
             ++l;
         }
     }
 
+    T reduce() const {
+        T const* first = f;
+        T const* last = l;
+        return reduce_counter(first, last, op, e);
+    }
+
     const Op op;
     const T e;
     T f[Size];
     T* l;
 };
 
+// Reduces [f, l) through a counter machine: the operations are applied
+// as a balanced binary tree, in the same order as a sequential reduction.
+template <Iterator I, BinaryOperation Op>
+    requires(Readable<I> && Domain<Op> == ValueType<I>)
+ValueType<I> reduce_balanced(I f, I l, Op op, ValueType<I> const& e) {
+    // precondition: readable_bounded_range(f, l) && Op is associative
+    counter_machine<ValueType<I>, Op> c(op, e);
+    while (f != l) {
+        c.add(*f);
+        ++f;
+    }
+    return c.reduce();
+}
+
 }} /*tao::algorithm*/
 
 #endif /*TAO_ALGORITHM_COUNTER_MACHINE_HPP*/
@@ -0,0 +1,270 @@
+//! \file tao/algorithm/factorize.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_FACTORIZE_HPP_
+#define TAO_ALGORITHM_FACTORIZE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/integers.hpp>
+#include <tao/algorithm/primes.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao { namespace algorithm {
+
+// ------------------------------------------------------------------------
+// Integer factorization
+// ------------------------------------------------------------------------
+// 1. The powers of two are removed with count_trailing_zeros.
+// 2. Trial division by the odd primes below factor_trial_bound, taken once
+//    from the wheel sieve. Divisibility is tested without dividing: for
+//    odd p, n is a multiple of p iff n * p^-1 mod 2^64 <= (2^64 - 1) / p,
+//    and then that product is n / p.
+// 3. The cofactor is prime (deterministic prime(n)) or is split by
+//    Pollard's rho with Brent's cycle detection, in Montgomery form. The
+//    differences are multiplied together and one gcd is taken every
+//    factor_rho_batch steps.
+// 4. Above 2^32, factor_rho_lanes sequences with different constants are
+//    advanced together. A step of one of them waits for the product of its
+//    previous step; the other lanes use the multiplier meanwhile. n splits
+//    when the first lane finds its cycle, and the minimum of the lanes' rho
+//    lengths is about half of the length of one of them.
+
+constexpr std::uint32_t factor_trial_bound = 2048;
+constexpr std::uint32_t factor_rho_batch = 128;
+constexpr std::size_t factor_rho_lanes = 4;
+
+namespace detail {
+
+struct trial_divisor {
+    std::uint64_t inverse;      // p^-1 mod 2^64
+    std::uint64_t limit;        // (2^64 - 1) / p
+    std::uint64_t p;
+};
+
+inline
+std::vector<trial_divisor> const& trial_divisors() {
+    static std::vector<trial_divisor> const divisors = [] {
+        std::vector<trial_divisor> res;
+        for_each_prime(3, factor_trial_bound, [&](std::uint64_t p) {
+            res.push_back({montgomery_multiply<std::uint64_t>::modular_inverse(p),
+                           ~std::uint64_t(0) / p, p});
+        });
+        return res;
+    }();
+    return divisors;
+}
+
+// (a + b) mod n and |a - b| for a, b in [0, n), without overflow.
+template <typename U>
+inline
+U modulo_add(U a, U b, U n) {
+    return a >= n - b ? U(a - (n - b)) : U(a + b);
+}
+
+template <typename U>
+inline
+U absolute_difference(U a, U b) {
+    return a > b ? U(a - b) : U(b - a);
+}
+
+// Nontrivial factor of n, or n if the sequences x -> x^2 + c + j, j in
+// [0, K), fail. Brent's variant: in every lane y runs r steps
+// ahead of x, r doubles every round; the differences x - y are accumulated
+// in one product per lane and gcd(q, n) of their product is taken in
+// batches. If a batch reaches a multiple of n, its steps are replayed one
+// at a time, lane by lane.
+template <std::size_t K, typename U>
+U pollard_rho_brent(U n, U c) {
+    //precondition: odd(n) && composite(n) && n is not a prime power of a factor < factor_trial_bound
+    montgomery_multiply<U> const op(n);
+    std::array<U, K> cm;
+    std::array<U, K> x;
+    std::array<U, K> y;
+    std::array<U, K> ys;
+    std::array<U, K> q;
+    for (std::size_t j = 0; j < K; ++j) {
+        cm[j] = op.to_montgomery(U(c + j));
+        y[j] = op.to_montgomery(U(2));
+        q[j] = op.one();
+    }
+    auto f = [&](U v, std::size_t j) { return modulo_add(op(v, v), cm[j], n); };
+
+    U g = 1;
+    U steps = 0;
+    for (U r = 1; g == 1; r *= 2) {
+        x = y;
+        for (U i = 0; i < r; ++i) {
+            for (std::size_t j = 0; j < K; ++j) y[j] = f(y[j], j);
+        }
+        for (U k = 0; k < r && g == 1; k += factor_rho_batch) {
+            ys = y;
+            steps = (std::min)(U(factor_rho_batch), U(r - k));
+            for (U i = 0; i < steps; ++i) {
+                for (std::size_t j = 0; j < K; ++j) {
+                    y[j] = f(y[j], j);
+                    q[j] = op(q[j], absolute_difference(x[j], y[j]));
+                }
+            }
+            U p = q[0];
+            for (std::size_t j = 1; j < K; ++j) p = op(p, q[j]);
+            g = U(binary_gcd(p, n));
+        }
+    }
+    if (g != n) return g;
+    for (std::size_t j = 0; j < K; ++j) {
+        U v = ys[j];
+        for (U i = 0; i < steps; ++i) {
+            v = f(v, j);
+            g = U(binary_gcd(absolute_difference(x[j], v), n));
+            if (g == n) break;
+            if (g != 1) return g;
+        }
+    }
+    return n;
+}
+
+// Nontrivial factor of the composite n, 32-bit arithmetic when it fits.
+inline
+std::uint64_t find_factor(std::uint64_t n) {
+    //precondition: odd(n) && composite(n) && n has no prime factor < factor_trial_bound
+    for (std::uint64_t c = 1; ; c += factor_rho_lanes) {
+        std::uint64_t const d = n < (std::uint64_t(1) << 32)
+            ? pollard_rho_brent<1>(std::uint32_t(n), std::uint32_t(c))
+            : pollard_rho_brent<factor_rho_lanes>(n, c);
+        if (d != n) return d;
+    }
+}
+
+template <typename P>
+void factorize_large(std::uint64_t n, P& push) {
+    //precondition: n > 1 && n has no prime factor < factor_trial_bound
+    if (n < std::uint64_t(factor_trial_bound) * factor_trial_bound || prime(n)) {
+        push(n);
+        return;
+    }
+    std::uint64_t const d = find_factor(n);
+    factorize_large(d, push);
+    factorize_large(n / d, push);
+}
+
+} // namespace detail
+
+//Complexity:
+//      Runtime:
+//          O(pi(factor_trial_bound)) to remove the small factors,
+//          expected O(p^(1/2)) Montgomery products to split off each
+//          other prime factor p
+//      Space:
+//          O(log n)
+//
+// Writes the prime factors of n, in non-decreasing order and with their
+// multiplicity, to out. Returns the final out.
+template <Integer N, Iterator O>
+    requires(Writable<O>)
+O factorize(N n, O out) {
+    //precondition: n > 0
+    static_assert(sizeof(N) <= 8, "factorize works up to 64-bit integers");
+
+    std::array<std::uint64_t, 64> factors;
+    std::size_t count = 0;
+    auto push = [&](std::uint64_t p) { factors[count++] = p; };
+
+    auto x = std::uint64_t(n);
+    int const twos = count_trailing_zeros(x);
+    for (int i = 0; i < twos; ++i) push(2);
+    x >>= twos;
+
+    for (auto const& d : detail::trial_divisors()) {
+        if (d.p * d.p > x) break;
+        while (x * d.inverse <= d.limit) {
+            push(d.p);
+            x *= d.inverse;
+        }
+    }
+    if (x != 1) detail::factorize_large(x, push);
+
+    std::sort(factors.begin(), factors.begin() + count);
+    for (std::size_t i = 0; i < count; ++i) {
+        *out = N(factors[i]);
+        ++out;
+    }
+    return out;
+}
+
+template <Integer N>
+std::vector<N> factorize(N n) {
+    //precondition: n > 0
+    std::vector<N> res;
+    factorize(n, std::back_inserter(res));
+    return res;
+}
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_FACTORIZE_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("[factorize] testing factorize against trial division") {
+    using namespace tao::algorithm;
+
+    auto check = [](std::uint64_t n) {
+        auto const f = factorize(n);
+        std::uint64_t m = 1;
+        for (std::size_t i = 0; i < f.size(); ++i) {
+            CHECK(prime(f[i]));
+            CHECK((i == 0 || f[i - 1] <= f[i]));
+            m *= f[i];
+        }
+        CHECK(m == n);
+    };
+
+    CHECK(factorize(1u).empty());
+    CHECK(factorize(2u) == std::vector<unsigned>{2});
+    CHECK(factorize(360) == std::vector<int>{2, 2, 2, 3, 3, 5});
+    CHECK(factorize(2047u * 2053u) == std::vector<unsigned>{23, 89, 2053});
+    for (std::uint64_t n = 1; n < 20000; ++n) check(n);
+    for (std::uint64_t n = 4294967296ull - 1000; n < 4294967296ull + 1000; ++n) check(n);
+    for (std::uint64_t n = 18446744073709551615ull - 300; n != 0; ++n) check(n);
+
+    CHECK(factorize(std::uint64_t(18446744073709551615ull)) ==
+          std::vector<std::uint64_t>{3, 5, 17, 257, 641, 65537, 6700417});
+    CHECK(factorize(std::uint64_t(1) << 63) == std::vector<std::uint64_t>(63, 2));
+    CHECK(factorize(std::uint64_t(2053) * 2053 * 2053 * 2053 * 2053) ==
+          std::vector<std::uint64_t>(5, 2053));
+}
+
+TEST_CASE("[factorize] testing factorize on semiprimes and prime powers") {
+    using namespace tao::algorithm;
+
+    // Balanced 64-bit semiprimes, the hardest inputs for rho.
+    CHECK(factorize(std::uint64_t(4294967291ull * 4294967279ull)) ==
+          std::vector<std::uint64_t>{4294967279ull, 4294967291ull});
+    CHECK(factorize(std::uint64_t(3037000493ull * 3037000453ull)) ==
+          std::vector<std::uint64_t>{3037000453ull, 3037000493ull});
+    CHECK(factorize(std::uint64_t(1000003ull * 1000003ull * 1000003ull)) ==
+          std::vector<std::uint64_t>(3, 1000003ull));
+    CHECK(factorize(std::uint64_t(65521ull * 65521ull)) == std::vector<std::uint64_t>{65521ull, 65521ull});
+    // Carmichael numbers and strong pseudoprimes.
+    CHECK(factorize(std::uint64_t(3215031751ull)) == std::vector<std::uint64_t>{151, 751, 28351});
+    CHECK(factorize(std::uint64_t(3825123056546413051ull)) ==
+          std::vector<std::uint64_t>{149491, 747451, 34233211});
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -10,22 +10,603 @@
 #define TAO_ALGORITHM_FIND_HPP_
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include <tao/algorithm/concepts.hpp>
 #include <tao/algorithm/integers.hpp>
+#include <tao/algorithm/simd.hpp>
 #include <tao/algorithm/swap.hpp>
 #include <tao/algorithm/type_attributes.hpp>
 #include <tao/algorithm/predicates.hpp>
 
 namespace tao { namespace algorithm {
 
+// ------------------------------------------------------------------------
+// Vectorized comparisons
+// ------------------------------------------------------------------------
+// On contiguous ranges of integers, float or double, find and the find_if
+// family with the predicates of predicates.hpp (equal_to_value,
+// not_equal_to_value, less_than_value, greater_than_value, within_range)
+// compare 16, 32 or 64 bytes at a time. The loads are aligned: the first
+// vector starts at or before f and the bits of the elements before f are
+// shifted out, the last one is masked at l. Hits come from movemask (a
+// mask register with AVX-512) and count_trailing_zeros. The results are
+// those of the scalar loops, including for NaN.
+//
+// find_unguarded keeps its sentinel contract: it reads aligned vectors up
+// to the one holding the first match only, and an aligned vector never
+// crosses a page, so no bound is needed.
+
+namespace detail {
+
+enum class compare_kind { none, equal, not_equal, less, greater, range };
+
+template <typename P>
+struct compare_kind_of : std::integral_constant<compare_kind, compare_kind::none> {
+    using value_type = void;
+};
+
+template <typename T>
+struct compare_kind_of<equal_to_value<T>> : std::integral_constant<compare_kind, compare_kind::equal> {
+    using value_type = T;
+};
+
+template <typename T>
+struct compare_kind_of<not_equal_to_value<T>> : std::integral_constant<compare_kind, compare_kind::not_equal> {
+    using value_type = T;
+};
+
+template <typename T>
+struct compare_kind_of<less_than_value<T>> : std::integral_constant<compare_kind, compare_kind::less> {
+    using value_type = T;
+};
+
+template <typename T>
+struct compare_kind_of<greater_than_value<T>> : std::integral_constant<compare_kind, compare_kind::greater> {
+    using value_type = T;
+};
+
+template <typename T>
+struct compare_kind_of<within_range<T>> : std::integral_constant<compare_kind, compare_kind::range> {
+    using value_type = T;
+};
+
+// Operands of the comparison. For an integer range, b is b - a and the
+// test is the unsigned x - a < b - a.
+template <typename T>
+struct compare_operands {
+    T a;
+    T b;
+};
+
+template <typename P, typename T = typename compare_kind_of<P>::value_type>
+compare_operands<T> compare_operands_of(P const& p) {
+    if constexpr (compare_kind_of<P>::value == compare_kind::range) {
+        if constexpr (std::is_integral<T>::value) {
+            using U = std::make_unsigned_t<T>;
+            return {p.a, T(U(U(p.b) - U(p.a)))};
+        } else {
+            return {p.a, p.b};
+        }
+    } else {
+        return {p.x, p.x};
+    }
+}
+
+template <typename P>
+bool compare_empty(P const& p) {
+    if constexpr (compare_kind_of<P>::value == compare_kind::range) {
+        return ! (p.a < p.b);
+    } else {
+        return false;
+    }
+}
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_ALWAYS_INLINE
+bool compare_test(T x, compare_operands<T> const& o) {
+    if constexpr (K == compare_kind::equal) {
+        return x == o.a;
+    } else if constexpr (K == compare_kind::not_equal) {
+        return x != o.a;
+    } else if constexpr (K == compare_kind::less) {
+        return x < o.a;
+    } else if constexpr (K == compare_kind::greater) {
+        return o.a < x;
+    } else if constexpr (std::is_integral<T>::value) {
+        using U = std::make_unsigned_t<T>;
+        return U(U(x) - U(o.a)) < U(o.b);
+    } else {
+        return ! (x < o.a) && x < o.b;
+    }
+}
+
+template <Iterator I, typename P>
+constexpr bool find_vectorizable() {
+    if constexpr ( ! is_contiguous_iterator_v<I>) {
+        return false;
+    } else {
+        using T = std::remove_cv_t<ValueType<I>>;
+        return compare_kind_of<P>::value != compare_kind::none &&
+               is_simd_arithmetic_v<T> &&
+               std::is_same<typename compare_kind_of<P>::value_type, T>::value;
+    }
+}
+
+inline constexpr
+std::uint64_t low_bits(std::size_t k) {
+    //precondition: k < 64
+    return (std::uint64_t(1) << k) - 1;
+}
+
+template <compare_kind K, typename T, bool Bounded>
+std::size_t find_compare_scalar(T const* p, std::size_t n, compare_operands<T> const& o) {
+    std::size_t i = 0;
+    if constexpr (Bounded) {
+        while (i != n && ! compare_test<K>(p[i], o)) ++i;
+    } else {
+        while ( ! compare_test<K>(p[i], o)) ++i;
+    }
+    return i;
+}
+
+#if defined(TAO_ALGORITHM_SIMD_X86)
+
+// SSE2, 16-byte vectors, byte masks. No 64-bit integer comparisons.
+
+template <typename T>
+TAO_ALGORITHM_TARGET_SSE2 TAO_ALGORITHM_ALWAYS_INLINE
+__m128i broadcast_sse2(T x) {
+    if constexpr (std::is_same<T, float>::value) {
+        return _mm_castps_si128(_mm_set1_ps(x));
+    } else if constexpr (std::is_same<T, double>::value) {
+        return _mm_castpd_si128(_mm_set1_pd(x));
+    } else if constexpr (sizeof(T) == 1) {
+        return _mm_set1_epi8(char(x));
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm_set1_epi16(short(x));
+    } else {
+        return _mm_set1_epi32(int(x));
+    }
+}
+
+template <typename T>
+TAO_ALGORITHM_TARGET_SSE2 TAO_ALGORITHM_ALWAYS_INLINE
+__m128i equal_sse2(__m128i x, __m128i y) {
+    if constexpr (std::is_same<T, float>::value) {
+        return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(x), _mm_castsi128_ps(y)));
+    } else if constexpr (std::is_same<T, double>::value) {
+        return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(x), _mm_castsi128_pd(y)));
+    } else if constexpr (sizeof(T) == 1) {
+        return _mm_cmpeq_epi8(x, y);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm_cmpeq_epi16(x, y);
+    } else {
+        return _mm_cmpeq_epi32(x, y);
+    }
+}
+
+// x < y
+template <typename T>
+TAO_ALGORITHM_TARGET_SSE2 TAO_ALGORITHM_ALWAYS_INLINE
+__m128i less_sse2(__m128i x, __m128i y) {
+    if constexpr (std::is_same<T, float>::value) {
+        return _mm_castps_si128(_mm_cmplt_ps(_mm_castsi128_ps(x), _mm_castsi128_ps(y)));
+    } else if constexpr (std::is_same<T, double>::value) {
+        return _mm_castpd_si128(_mm_cmplt_pd(_mm_castsi128_pd(x), _mm_castsi128_pd(y)));
+    } else if constexpr (std::is_unsigned<T>::value) {
+        using S = std::make_signed_t<T>;
+        __m128i const bias = broadcast_sse2(S(T(1) << (8 * sizeof(T) - 1)));
+        return less_sse2<S>(_mm_xor_si128(x, bias), _mm_xor_si128(y, bias));
+    } else if constexpr (sizeof(T) == 1) {
+        return _mm_cmpgt_epi8(y, x);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm_cmpgt_epi16(y, x);
+    } else {
+        return _mm_cmpgt_epi32(y, x);
+    }
+}
+
+template <typename T>
+TAO_ALGORITHM_TARGET_SSE2 TAO_ALGORITHM_ALWAYS_INLINE
+__m128i subtract_sse2(__m128i x, __m128i y) {
+    if constexpr (sizeof(T) == 1) {
+        return _mm_sub_epi8(x, y);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm_sub_epi16(x, y);
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm_sub_epi32(x, y);
+    } else {
+        return _mm_sub_epi64(x, y);
+    }
+}
+
+// All-ones lanes where x satisfies the comparison. not_equal is the
+// complement of equal and is left to the callers.
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_SSE2 TAO_ALGORITHM_ALWAYS_INLINE
+__m128i compare_lanes_sse2(__m128i x, __m128i a, __m128i b) {
+    static_assert(K != compare_kind::not_equal, "not_equal is the complement of equal");
+    if constexpr (K == compare_kind::equal) {
+        return equal_sse2<T>(x, a);
+    } else if constexpr (K == compare_kind::less) {
+        return less_sse2<T>(x, a);
+    } else if constexpr (K == compare_kind::greater) {
+        return less_sse2<T>(a, x);
+    } else if constexpr (std::is_integral<T>::value) {
+        return less_sse2<std::make_unsigned_t<T>>(subtract_sse2<T>(x, a), b);
+    } else {
+        return _mm_andnot_si128(less_sse2<T>(x, a), less_sse2<T>(x, b));
+    }
+}
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_SSE2 TAO_ALGORITHM_ALWAYS_INLINE
+std::uint32_t compare_mask_sse2(void const* p, __m128i a, __m128i b) {
+    __m128i const x = _mm_load_si128(static_cast<__m128i const*>(p));
+    if constexpr (K == compare_kind::not_equal) {
+        return ~std::uint32_t(_mm_movemask_epi8(equal_sse2<T>(x, a))) & 0xffff;
+    } else {
+        return std::uint32_t(_mm_movemask_epi8(compare_lanes_sse2<K, T>(x, a, b)));
+    }
+}
+
+template <compare_kind K, typename T, bool Bounded>
+TAO_ALGORITHM_TARGET_SSE2 TAO_ALGORITHM_NO_SANITIZE_ADDRESS
+std::size_t find_compare_sse2(T const* p, std::size_t n, compare_operands<T> const& o) {
+    constexpr std::size_t W = 16;
+    __m128i const a = broadcast_sse2(o.a);
+    __m128i const b = broadcast_sse2(o.b);
+    auto const address = reinterpret_cast<std::uintptr_t>(p);
+    std::size_t const head = address & (W - 1);
+    auto const q = reinterpret_cast<unsigned char const*>(address - head);
+    std::size_t const end = head + n * sizeof(T);       // in bytes from q, when Bounded
+
+    std::uint64_t m = compare_mask_sse2<K, T>(q, a, b) >> head;
+    if (Bounded && end < W) m &= low_bits(end - head);
+    if (m != 0) return std::size_t(count_trailing_zeros(m)) / sizeof(T);
+
+    std::size_t i = W;
+    if constexpr (Bounded) {
+        for (; i + 4 * W <= end; i += 4 * W) {
+            std::uint64_t const m4 = std::uint64_t(compare_mask_sse2<K, T>(q + i, a, b)) |
+                                     std::uint64_t(compare_mask_sse2<K, T>(q + i + W, a, b)) << 16 |
+                                     std::uint64_t(compare_mask_sse2<K, T>(q + i + 2 * W, a, b)) << 32 |
+                                     std::uint64_t(compare_mask_sse2<K, T>(q + i + 3 * W, a, b)) << 48;
+            if (m4 != 0) return (i - head + std::size_t(count_trailing_zeros(m4))) / sizeof(T);
+        }
+        for (; i < end; i += W) {
+            m = compare_mask_sse2<K, T>(q + i, a, b);
+            if (end - i < W) m &= low_bits(end - i);
+            if (m != 0) return (i - head + std::size_t(count_trailing_zeros(m))) / sizeof(T);
+        }
+        return n;
+    } else {
+        while (true) {
+            m = compare_mask_sse2<K, T>(q + i, a, b);
+            if (m != 0) return (i - head + std::size_t(count_trailing_zeros(m))) / sizeof(T);
+            i += W;
+        }
+    }
+}
+
+// AVX2, 32-byte vectors, byte masks.
+
+template <typename T>
+TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_ALWAYS_INLINE
+__m256i broadcast_avx2(T x) {
+    if constexpr (std::is_same<T, float>::value) {
+        return _mm256_castps_si256(_mm256_set1_ps(x));
+    } else if constexpr (std::is_same<T, double>::value) {
+        return _mm256_castpd_si256(_mm256_set1_pd(x));
+    } else if constexpr (sizeof(T) == 1) {
+        return _mm256_set1_epi8(char(x));
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_set1_epi16(short(x));
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm256_set1_epi32(int(x));
+    } else {
+        return _mm256_set1_epi64x((long long)(x));
+    }
+}
+
+template <typename T>
+TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_ALWAYS_INLINE
+__m256i equal_avx2(__m256i x, __m256i y) {
+    if constexpr (std::is_same<T, float>::value) {
+        return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(x), _mm256_castsi256_ps(y), _CMP_EQ_OQ));
+    } else if constexpr (std::is_same<T, double>::value) {
+        return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(x), _mm256_castsi256_pd(y), _CMP_EQ_OQ));
+    } else if constexpr (sizeof(T) == 1) {
+        return _mm256_cmpeq_epi8(x, y);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_cmpeq_epi16(x, y);
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm256_cmpeq_epi32(x, y);
+    } else {
+        return _mm256_cmpeq_epi64(x, y);
+    }
+}
+
+// x < y
+template <typename T>
+TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_ALWAYS_INLINE
+__m256i less_avx2(__m256i x, __m256i y) {
+    if constexpr (std::is_same<T, float>::value) {
+        return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(x), _mm256_castsi256_ps(y), _CMP_LT_OQ));
+    } else if constexpr (std::is_same<T, double>::value) {
+        return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(x), _mm256_castsi256_pd(y), _CMP_LT_OQ));
+    } else if constexpr (std::is_unsigned<T>::value) {
+        using S = std::make_signed_t<T>;
+        __m256i const bias = broadcast_avx2(S(T(1) << (8 * sizeof(T) - 1)));
+        return less_avx2<S>(_mm256_xor_si256(x, bias), _mm256_xor_si256(y, bias));
+    } else if constexpr (sizeof(T) == 1) {
+        return _mm256_cmpgt_epi8(y, x);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_cmpgt_epi16(y, x);
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm256_cmpgt_epi32(y, x);
+    } else {
+        return _mm256_cmpgt_epi64(y, x);
+    }
+}
+
+template <typename T>
+TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_ALWAYS_INLINE
+__m256i subtract_avx2(__m256i x, __m256i y) {
+    if constexpr (sizeof(T) == 1) {
+        return _mm256_sub_epi8(x, y);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm256_sub_epi16(x, y);
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm256_sub_epi32(x, y);
+    } else {
+        return _mm256_sub_epi64(x, y);
+    }
+}
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_ALWAYS_INLINE
+__m256i compare_lanes_avx2(__m256i x, __m256i a, __m256i b) {
+    static_assert(K != compare_kind::not_equal, "not_equal is the complement of equal");
+    if constexpr (K == compare_kind::equal) {
+        return equal_avx2<T>(x, a);
+    } else if constexpr (K == compare_kind::less) {
+        return less_avx2<T>(x, a);
+    } else if constexpr (K == compare_kind::greater) {
+        return less_avx2<T>(a, x);
+    } else if constexpr (std::is_integral<T>::value) {
+        return less_avx2<std::make_unsigned_t<T>>(subtract_avx2<T>(x, a), b);
+    } else {
+        return _mm256_andnot_si256(less_avx2<T>(x, a), less_avx2<T>(x, b));
+    }
+}
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_ALWAYS_INLINE
+std::uint32_t compare_mask_avx2(void const* p, __m256i a, __m256i b) {
+    __m256i const x = _mm256_load_si256(static_cast<__m256i const*>(p));
+    if constexpr (K == compare_kind::not_equal) {
+        return ~std::uint32_t(_mm256_movemask_epi8(equal_avx2<T>(x, a)));
+    } else {
+        return std::uint32_t(_mm256_movemask_epi8(compare_lanes_avx2<K, T>(x, a, b)));
+    }
+}
+
+template <compare_kind K, typename T, bool Bounded>
+TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_NO_SANITIZE_ADDRESS
+std::size_t find_compare_avx2(T const* p, std::size_t n, compare_operands<T> const& o) {
+    constexpr std::size_t W = 32;
+    __m256i const a = broadcast_avx2(o.a);
+    __m256i const b = broadcast_avx2(o.b);
+    auto const address = reinterpret_cast<std::uintptr_t>(p);
+    std::size_t const head = address & (W - 1);
+    auto const q = reinterpret_cast<unsigned char const*>(address - head);
+    std::size_t const end = head + n * sizeof(T);
+
+    std::uint64_t m = compare_mask_avx2<K, T>(q, a, b) >> head;
+    if (Bounded && end < W) m &= low_bits(end - head);
+    if (m != 0) return std::size_t(count_trailing_zeros(m)) / sizeof(T);
+
+    std::size_t i = W;
+    if constexpr (Bounded) {
+        for (; i + 4 * W <= end; i += 4 * W) {
+            std::uint64_t const m0 = std::uint64_t(compare_mask_avx2<K, T>(q + i, a, b)) |
+                                     std::uint64_t(compare_mask_avx2<K, T>(q + i + W, a, b)) << 32;
+            std::uint64_t const m1 = std::uint64_t(compare_mask_avx2<K, T>(q + i + 2 * W, a, b)) |
+                                     std::uint64_t(compare_mask_avx2<K, T>(q + i + 3 * W, a, b)) << 32;
+            if ((m0 | m1) != 0) {
+                if (m0 != 0) return (i - head + std::size_t(count_trailing_zeros(m0))) / sizeof(T);
+                return (i + 2 * W - head + std::size_t(count_trailing_zeros(m1))) / sizeof(T);
+            }
+        }
+        for (; i < end; i += W) {
+            m = compare_mask_avx2<K, T>(q + i, a, b);
+            if (end - i < W) m &= low_bits(end - i);
+            if (m != 0) return (i - head + std::size_t(count_trailing_zeros(m))) / sizeof(T);
+        }
+        return n;
+    } else {
+        while (true) {
+            m = compare_mask_avx2<K, T>(q + i, a, b);
+            if (m != 0) return (i - head + std::size_t(count_trailing_zeros(m))) / sizeof(T);
+            i += W;
+        }
+    }
+}
+
+// AVX-512, 64-byte vectors, element masks.
+
+template <typename T>
+TAO_ALGORITHM_TARGET_AVX512 TAO_ALGORITHM_ALWAYS_INLINE
+__m512i broadcast_avx512(T x) {
+    if constexpr (std::is_same<T, float>::value) {
+        return _mm512_castps_si512(_mm512_set1_ps(x));
+    } else if constexpr (std::is_same<T, double>::value) {
+        return _mm512_castpd_si512(_mm512_set1_pd(x));
+    } else if constexpr (sizeof(T) == 1) {
+        return _mm512_set1_epi8(char(x));
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm512_set1_epi16(short(x));
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm512_set1_epi32(int(x));
+    } else {
+        return _mm512_set1_epi64((long long)(x));
+    }
+}
+
+// The integer predicates are _MM_CMPINT_EQ, _MM_CMPINT_LT or _MM_CMPINT_NE.
+template <typename T, int Predicate>
+TAO_ALGORITHM_TARGET_AVX512 TAO_ALGORITHM_ALWAYS_INLINE
+std::uint64_t compare_avx512(__m512i x, __m512i y) {
+    constexpr bool is_signed = std::is_signed<T>::value;
+    if constexpr (std::is_floating_point<T>::value) {
+        constexpr int fp = Predicate == _MM_CMPINT_EQ ? _CMP_EQ_OQ : Predicate == _MM_CMPINT_LT ? _CMP_LT_OQ : _CMP_NEQ_UQ;
+        if constexpr (std::is_same<T, float>::value) {
+            return _mm512_cmp_ps_mask(_mm512_castsi512_ps(x), _mm512_castsi512_ps(y), fp);
+        } else {
+            return _mm512_cmp_pd_mask(_mm512_castsi512_pd(x), _mm512_castsi512_pd(y), fp);
+        }
+    } else if constexpr (sizeof(T) == 1) {
+        return is_signed ? _mm512_cmp_epi8_mask(x, y, Predicate) : _mm512_cmp_epu8_mask(x, y, Predicate);
+    } else if constexpr (sizeof(T) == 2) {
+        return is_signed ? _mm512_cmp_epi16_mask(x, y, Predicate) : _mm512_cmp_epu16_mask(x, y, Predicate);
+    } else if constexpr (sizeof(T) == 4) {
+        return is_signed ? _mm512_cmp_epi32_mask(x, y, Predicate) : _mm512_cmp_epu32_mask(x, y, Predicate);
+    } else {
+        return is_signed ? _mm512_cmp_epi64_mask(x, y, Predicate) : _mm512_cmp_epu64_mask(x, y, Predicate);
+    }
+}
+
+template <typename T>
+TAO_ALGORITHM_TARGET_AVX512 TAO_ALGORITHM_ALWAYS_INLINE
+__m512i subtract_avx512(__m512i x, __m512i y) {
+    if constexpr (sizeof(T) == 1) {
+        return _mm512_sub_epi8(x, y);
+    } else if constexpr (sizeof(T) == 2) {
+        return _mm512_sub_epi16(x, y);
+    } else if constexpr (sizeof(T) == 4) {
+        return _mm512_sub_epi32(x, y);
+    } else {
+        return _mm512_sub_epi64(x, y);
+    }
+}
+
+// One bit per element of x.
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_AVX512 TAO_ALGORITHM_ALWAYS_INLINE
+std::uint64_t compare_lanes_avx512(__m512i x, __m512i a, __m512i b) {
+    if constexpr (K == compare_kind::equal) {
+        return compare_avx512<T, _MM_CMPINT_EQ>(x, a);
+    } else if constexpr (K == compare_kind::not_equal) {
+        return compare_avx512<T, _MM_CMPINT_NE>(x, a);
+    } else if constexpr (K == compare_kind::less) {
+        return compare_avx512<T, _MM_CMPINT_LT>(x, a);
+    } else if constexpr (K == compare_kind::greater) {
+        return compare_avx512<T, _MM_CMPINT_LT>(a, x);
+    } else if constexpr (std::is_integral<T>::value) {
+        return compare_avx512<std::make_unsigned_t<T>, _MM_CMPINT_LT>(subtract_avx512<T>(x, a), b);
+    } else {
+        return compare_avx512<T, _MM_CMPINT_LT>(x, b) & ~compare_avx512<T, _MM_CMPINT_LT>(x, a);
+    }
+}
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_AVX512 TAO_ALGORITHM_ALWAYS_INLINE
+std::uint64_t compare_mask_avx512(void const* p, __m512i a, __m512i b) {
+    return compare_lanes_avx512<K, T>(_mm512_load_si512(p), a, b);
+}
+
+template <compare_kind K, typename T, bool Bounded>
+TAO_ALGORITHM_TARGET_AVX512 TAO_ALGORITHM_NO_SANITIZE_ADDRESS
+std::size_t find_compare_avx512(T const* p, std::size_t n, compare_operands<T> const& o) {
+    constexpr std::size_t W = 64;
+    constexpr std::size_t E = W / sizeof(T);            // elements per vector
+    __m512i const a = broadcast_avx512(o.a);
+    __m512i const b = broadcast_avx512(o.b);
+    auto const address = reinterpret_cast<std::uintptr_t>(p);
+    std::size_t const head = (address & (W - 1)) / sizeof(T);
+    auto const q = reinterpret_cast<T const*>(address - head * sizeof(T));
+    std::size_t const end = head + n;                   // in elements from q, when Bounded
+
+    std::uint64_t m = compare_mask_avx512<K, T>(q, a, b) >> head;
+    if (Bounded && end < E) m &= low_bits(end - head);
+    if (m != 0) return std::size_t(count_trailing_zeros(m));
+
+    std::size_t i = E;
+    if constexpr (Bounded) {
+        for (; i + 2 * E <= end; i += 2 * E) {
+            std::uint64_t const m0 = compare_mask_avx512<K, T>(q + i, a, b);
+            std::uint64_t const m1 = compare_mask_avx512<K, T>(q + i + E, a, b);
+            if ((m0 | m1) != 0) {
+                if (m0 != 0) return i - head + std::size_t(count_trailing_zeros(m0));
+                return i + E - head + std::size_t(count_trailing_zeros(m1));
+            }
+        }
+        for (; i < end; i += E) {
+            m = compare_mask_avx512<K, T>(q + i, a, b);
+            if (end - i < E) m &= low_bits(end - i);
+            if (m != 0) return i - head + std::size_t(count_trailing_zeros(m));
+        }
+        return n;
+    } else {
+        while (true) {
+            m = compare_mask_avx512<K, T>(q + i, a, b);
+            if (m != 0) return i - head + std::size_t(count_trailing_zeros(m));
+            i += E;
+        }
+    }
+}
+
+#endif
+
+// Index of the first element of [p, p + n) that satisfies the comparison,
+// n if none. Without Bounded, n is ignored and there must be a match.
+template <compare_kind K, typename T, bool Bounded>
+std::size_t find_compare(T const* p, std::size_t n, compare_operands<T> const& o) {
+    if (Bounded && n == 0) return 0;
+#if defined(TAO_ALGORITHM_SIMD_X86)
+    // The vectors must start at element boundaries.
+    if (reinterpret_cast<std::uintptr_t>(p) % sizeof(T) == 0) {
+        switch (simd_isa_level()) {
+            case simd_isa::avx512: return find_compare_avx512<K, T, Bounded>(p, n, o);
+            case simd_isa::avx2: return find_compare_avx2<K, T, Bounded>(p, n, o);
+            case simd_isa::sse2:
+                if constexpr (sizeof(T) < 8 || std::is_floating_point<T>::value) {
+                    return find_compare_sse2<K, T, Bounded>(p, n, o);
+                }
+                break;
+            default: break;
+        }
+    }
+#endif
+    return find_compare_scalar<K, T, Bounded>(p, n, o);
+}
+
+template <bool Bounded, Iterator I, typename P>
+std::size_t find_if_contiguous(I f, std::size_t n, P const& p) {
+    using T = std::remove_cv_t<ValueType<I>>;
+    constexpr auto kind = compare_kind_of<P>::value;
+    return find_compare<kind, T, Bounded>(std::addressof(*f), n, compare_operands_of(p));
+}
+
+} // namespace detail
+
 template <Iterator I>
     requires(Readable<I>)
 I find(I f, I l, ValueType<I> const& x) {
     //precondition: readable_bounded_range(f, l)
+    if constexpr (detail::find_vectorizable<I, equal_to_value<std::remove_cv_t<ValueType<I>>>>()) {
+        if (f == l) return f;
+        return f + detail::find_if_contiguous<true>(f, std::size_t(l - f), equal_to_value<std::remove_cv_t<ValueType<I>>>(x));
+    }
     while (f != l && *f != x) ++f;
     return f;
 }
@@ -34,6 +615,11 @@ template <Iterator I>
     requires(Readable<I>)
 std::pair<I, DistanceType<I>> find_n(I f, DistanceType<I> n, ValueType<I> const& x) {
     //precondition: readable_weak_range(f, n)
+    if constexpr (detail::find_vectorizable<I, equal_to_value<std::remove_cv_t<ValueType<I>>>>()) {
+        if (zero(n)) return {f, n};
+        auto const i = DistanceType<I>(detail::find_if_contiguous<true>(f, std::size_t(n), equal_to_value<std::remove_cv_t<ValueType<I>>>(x)));
+        return {f + i, n - i};
+    }
     while (!zero(n) && *f != x) {
         ++f;
         --n;
@@ -45,6 +631,10 @@ template <Iterator I, UnaryPredicate P>
     requires(Readable<I>, Domain<P, ValueType<I>)
 I find_if(I f, I l, P p) {
     //precondition: readable_bounded_range(f, l)
+    if constexpr (detail::find_vectorizable<I, P>()) {
+        if (f == l || detail::compare_empty(p)) return l;
+        return f + detail::find_if_contiguous<true>(f, std::size_t(l - f), p);
+    }
     while (f != l && ! p(*f)) ++f;
     return f;
 }
@@ -61,6 +651,11 @@ template <Iterator I, UnaryPredicate P>
     requires(Readable<I>, Domain<P, ValueType<I>)
 std::pair<I, DistanceType<I>> find_if_n(I f, DistanceType<I> n, P p) {
     //precondition: readable_weak_range(f, n)
+    if constexpr (detail::find_vectorizable<I, P>()) {
+        if (zero(n) || detail::compare_empty(p)) return {f + n, DistanceType<I>(0)};
+        auto const i = DistanceType<I>(detail::find_if_contiguous<true>(f, std::size_t(n), p));
+        return {f + i, n - i};
+    }
     while (!zero(n) && ! p(*f)) {
         ++f;
         --n;
@@ -72,6 +667,9 @@ template <Iterator I>
     requires(Readable<I>)
 I find_unguarded(I f, ValueType<I> const& x) {
     //precondition: There exists l : I, such that: readable_bounded_range(f, l) && some(f, l, ???) TODO(fernando): ???
+    if constexpr (detail::find_vectorizable<I, equal_to_value<std::remove_cv_t<ValueType<I>>>>()) {
+        return f + detail::find_if_contiguous<false>(f, 0, equal_to_value<std::remove_cv_t<ValueType<I>>>(x));
+    }
     while (*f != x) ++f;
     return f;
 }
@@ -80,6 +678,9 @@ template <Iterator I, UnaryPredicate P>
     requires(Readable<I>, Domain<P, ValueType<I>)
 I find_if_unguarded(I f, P p) {
     //precondition: There exists l : I, such that: readable_bounded_range(f, l) && some(f, l, p)
+    if constexpr (detail::find_vectorizable<I, P>()) {
+        return f + detail::find_if_contiguous<false>(f, 0, p);
+    }
     while (! p(*f)) ++f;
     return f;
 }
@@ -164,6 +765,157 @@ bool some_n(I f, DistanceType<I> n, P p) {
 
 // ---------------------------------------------------------------------------
 
+// With std::equal_to on two contiguous ranges of integers, float or double
+// the find_mismatch family compares 16, 32 or 64 bytes per step with
+// unaligned loads; the last step is a full vector ending at the last
+// element, overlapping the previous one. Integers are compared as bytes
+// (equality is bitwise), float and double with ordered compares, so that
+// NaN != NaN and -0.0 == 0.0 as in the scalar loops.
+
+namespace detail {
+
+template <typename R, typename T>
+constexpr bool is_equal_to_v = std::is_same<R, std::equal_to<>>::value || std::is_same<R, std::equal_to<T>>::value;
+
+template <Iterator I0, Iterator I1, Relation R>
+constexpr bool mismatch_vectorizable() {
+    if constexpr ( ! is_contiguous_iterator_v<I0> || ! is_contiguous_iterator_v<I1>) {
+        return false;
+    } else {
+        using T = std::remove_cv_t<ValueType<I0>>;
+        return std::is_same<T, std::remove_cv_t<ValueType<I1>>>::value &&
+               is_simd_arithmetic_v<T> && is_equal_to_v<R, T>;
+    }
+}
+
+template <typename T>
+std::size_t mismatch_scalar(T const* a, T const* b, std::size_t i, std::size_t n) {
+    while (i != n && a[i] == b[i]) ++i;
+    return i;
+}
+
+#if defined(TAO_ALGORITHM_SIMD_X86)
+
+template <typename T>
+TAO_ALGORITHM_TARGET_SSE2 TAO_ALGORITHM_ALWAYS_INLINE
+std::uint32_t different_mask_sse2(T const* a, T const* b) {
+    __m128i const x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a));
+    __m128i const y = _mm_loadu_si128(reinterpret_cast<__m128i const*>(b));
+    return ~std::uint32_t(_mm_movemask_epi8(equal_sse2<T>(x, y))) & 0xffff;
+}
+
+template <typename T>
+TAO_ALGORITHM_TARGET_SSE2
+std::size_t mismatch_sse2(T const* a, T const* b, std::size_t n) {
+    constexpr std::size_t E = 16 / sizeof(T);
+    std::size_t i = 0;
+    for (; i + 4 * E <= n; i += 4 * E) {
+        std::uint64_t const m = std::uint64_t(different_mask_sse2(a + i, b + i)) |
+                                std::uint64_t(different_mask_sse2(a + i + E, b + i + E)) << 16 |
+                                std::uint64_t(different_mask_sse2(a + i + 2 * E, b + i + 2 * E)) << 32 |
+                                std::uint64_t(different_mask_sse2(a + i + 3 * E, b + i + 3 * E)) << 48;
+        if (m != 0) return i + std::size_t(count_trailing_zeros(m)) / sizeof(T);
+    }
+    for (; i + E <= n; i += E) {
+        std::uint32_t const m = different_mask_sse2(a + i, b + i);
+        if (m != 0) return i + std::size_t(count_trailing_zeros(m)) / sizeof(T);
+    }
+    if (i == n || n < E) return mismatch_scalar(a, b, i, n);
+    // [n - E, i) is already known to match.
+    std::uint32_t const m = different_mask_sse2(a + (n - E), b + (n - E));
+    return m == 0 ? n : n - E + std::size_t(count_trailing_zeros(m)) / sizeof(T);
+}
+
+template <typename T>
+TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_ALWAYS_INLINE
+std::uint32_t different_mask_avx2(T const* a, T const* b) {
+    __m256i const x = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a));
+    __m256i const y = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b));
+    return ~std::uint32_t(_mm256_movemask_epi8(equal_avx2<T>(x, y)));
+}
+
+template <typename T>
+TAO_ALGORITHM_TARGET_AVX2
+std::size_t mismatch_avx2(T const* a, T const* b, std::size_t n) {
+    constexpr std::size_t E = 32 / sizeof(T);
+    std::size_t i = 0;
+    for (; i + 2 * E <= n; i += 2 * E) {
+        std::uint64_t const m = std::uint64_t(different_mask_avx2(a + i, b + i)) |
+                                std::uint64_t(different_mask_avx2(a + i + E, b + i + E)) << 32;
+        if (m != 0) return i + std::size_t(count_trailing_zeros(m)) / sizeof(T);
+    }
+    for (; i + E <= n; i += E) {
+        std::uint32_t const m = different_mask_avx2(a + i, b + i);
+        if (m != 0) return i + std::size_t(count_trailing_zeros(m)) / sizeof(T);
+    }
+    if (i == n || n < E) return mismatch_scalar(a, b, i, n);
+    std::uint32_t const m = different_mask_avx2(a + (n - E), b + (n - E));
+    return m == 0 ? n : n - E + std::size_t(count_trailing_zeros(m)) / sizeof(T);
+}
+
+template <typename T>
+TAO_ALGORITHM_TARGET_AVX512 TAO_ALGORITHM_ALWAYS_INLINE
+std::uint64_t different_mask_avx512(T const* a, T const* b) {
+    __m512i const x = _mm512_loadu_si512(a);
+    __m512i const y = _mm512_loadu_si512(b);
+    return compare_avx512<T, _MM_CMPINT_NE>(x, y);
+}
+
+template <typename T>
+TAO_ALGORITHM_TARGET_AVX512
+std::size_t mismatch_avx512(T const* a, T const* b, std::size_t n) {
+    constexpr std::size_t E = 64 / sizeof(T);
+    std::size_t i = 0;
+    for (; i + 2 * E <= n; i += 2 * E) {
+        std::uint64_t const m0 = different_mask_avx512(a + i, b + i);
+        std::uint64_t const m1 = different_mask_avx512(a + i + E, b + i + E);
+        if ((m0 | m1) != 0) {
+            if (m0 != 0) return i + std::size_t(count_trailing_zeros(m0));
+            return i + E + std::size_t(count_trailing_zeros(m1));
+        }
+    }
+    for (; i + E <= n; i += E) {
+        std::uint64_t const m = different_mask_avx512(a + i, b + i);
+        if (m != 0) return i + std::size_t(count_trailing_zeros(m));
+    }
+    if (i == n || n < E) return mismatch_scalar(a, b, i, n);
+    std::uint64_t const m = different_mask_avx512(a + (n - E), b + (n - E));
+    return m == 0 ? n : n - E + std::size_t(count_trailing_zeros(m));
+}
+
+#endif
+
+// Index of the first i < n with a[i] != b[i], n if none.
+template <typename T>
+std::size_t mismatch_contiguous(T const* a, T const* b, std::size_t n) {
+#if defined(TAO_ALGORITHM_SIMD_X86)
+    if (simd_isa_level() == simd_isa::scalar) return mismatch_scalar(a, b, 0, n);
+    if constexpr (std::is_integral<T>::value && sizeof(T) > 1) {
+        // Bitwise equality: compare bytes, then round down to the element.
+        auto const i = mismatch_contiguous(reinterpret_cast<unsigned char const*>(a),
+                                           reinterpret_cast<unsigned char const*>(b), n * sizeof(T));
+        return i / sizeof(T);
+    } else {
+        switch (simd_isa_level()) {
+            case simd_isa::avx512: return mismatch_avx512(a, b, n);
+            case simd_isa::avx2: return mismatch_avx2(a, b, n);
+            case simd_isa::sse2: return mismatch_sse2(a, b, n);
+            default: break;
+        }
+    }
+#endif
+    return mismatch_scalar(a, b, 0, n);
+}
+
+template <Iterator I0, Iterator I1>
+std::size_t mismatch_contiguous_n(I0 f0, I1 f1, std::size_t n) {
+    if (n == 0) return 0;
+    using T = std::remove_cv_t<ValueType<I0>>;
+    return mismatch_contiguous<T>(std::addressof(*f0), std::addressof(*f1), n);
+}
+
+} // namespace detail
+
 template <Iterator I0, Iterator I1, Relation R>
     requires(Readable<I0>, Readable<I1>, Same<ValueType<I0>, ValueType<I1>>
              && Domain<R, ValueType<I0>>)
@@ -171,6 +923,10 @@ std::pair<I0, I1> find_mismatch(I0 f0, I0 l0, I1 f1, I1 l1, R r) {
     //precondition: readable_bounded_range(f0, l0) &&
     //              readable_bounded_range(f1, l1)
     //postcondition: TODO(Fernando): EoP Ex 6.4 pag. 102
+    if constexpr (detail::mismatch_vectorizable<I0, I1, R>()) {
+        auto const i = detail::mismatch_contiguous_n(f0, f1, std::size_t((std::min)(l0 - f0, DistanceType<I0>(l1 - f1))));
+        return {f0 + i, f1 + i};
+    }
 
     while (f0 != l0 && f1 != l1 && r(*f0, *f1)) {
         ++f0;
@@ -197,6 +953,10 @@ std::tuple<I0, I1, DistanceType<I1>> find_mismatch_bn(I0 f0, I0 l0, I1 f1, Dista
     //precondition: readable_bounded_range(f0, l0) &&
     //              readable_weak_range(f1, l1)
     //postcondition: TODO(Fernando): EoP Ex 6.4 pag. 102
+    if constexpr (detail::mismatch_vectorizable<I0, I1, R>()) {
+        auto const i = detail::mismatch_contiguous_n(f0, f1, std::size_t((std::min)(DistanceType<I1>(l0 - f0), n1)));
+        return {f0 + i, f1 + i, n1 - DistanceType<I1>(i)};
+    }
 
     while (f0 != l0 && n1 != 0 && r(*f0, *f1)) {
         ++f0;
@@ -224,6 +984,10 @@ std::tuple<I0, DistanceType<I0>, I1> find_mismatch_nb(I0 f0, DistanceType<I0> n0
     //precondition: readable_weak_range(f0, l0) &&
     //              readable_bounded_range(f1, l1)
     //postcondition: TODO(Fernando): EoP Ex 6.4 pag. 102
+    if constexpr (detail::mismatch_vectorizable<I0, I1, R>()) {
+        auto const i = detail::mismatch_contiguous_n(f0, f1, std::size_t((std::min)(n0, DistanceType<I0>(l1 - f1))));
+        return {f0 + i, n0 - DistanceType<I0>(i), f1 + i};
+    }
 
     while (n0 != 0 && f1 != l1 && r(*f0, *f1)) {
         ++f0;
@@ -251,6 +1015,10 @@ std::tuple<I0, DistanceType<I0>, I1, DistanceType<I1>> find_mismatch_nn(I0 f0, D
     //precondition: readable_weak_range(f0, l0) &&
     //              readable_weak_range(f1, l1)
     //postcondition: TODO(Fernando): EoP Ex 6.4 pag. 102
+    if constexpr (detail::mismatch_vectorizable<I0, I1, R>()) {
+        auto const i = detail::mismatch_contiguous_n(f0, f1, std::size_t((std::min)(n0, DistanceType<I0>(n1))));
+        return {f0 + i, n0 - DistanceType<I0>(i), f1 + i, n1 - DistanceType<I1>(i)};
+    }
 
     while (n0 != 0 && n1 != 0 && r(*f0, *f1)) {
         ++f0;
@@ -306,13 +1074,29 @@ I find_adjacent_mismatch(I f, I l, R r, std::forward_iterator_tag) {
     return f;
 }
 
+// With std::equal_to on a contiguous range of integers, float or double,
+// [f, l - 1) and [f + 1, l) are compared with the find_mismatch kernels.
 template <Iterator I, Relation R>
     requires(Readable<I> && Domain<R, ValueType<I>>)
 inline
 I find_adjacent_mismatch(I f, I l, R r) {
+    //precondition: readable_bounded_range(f, l)
+    if constexpr (detail::mismatch_vectorizable<I, I, R>()) {
+        if (l - f < 2) return l;
+        auto const i = detail::mismatch_contiguous_n(f, std::next(f), std::size_t(l - f - 1));
+        return f + DistanceType<I>(i + 1);
+    }
     return find_adjacent_mismatch(f, l, r, IteratorCategory<I>{});
 }
 
+template <Iterator I>
+    requires(Readable<I> && Regular<ValueType<I>>)
+inline
+I find_adjacent_mismatch(I f, I l) {
+    //precondition: readable_bounded_range(f, l)
+    return tao::algorithm::find_adjacent_mismatch(f, l, std::equal_to<>{});
+}
+
 }} /*tao::algorithm*/
 
 #endif /*TAO_ALGORITHM_FIND_HPP_*/
@@ -320,21 +1104,192 @@ I find_adjacent_mismatch(I f, I l, R r) {
 
 #ifdef DOCTEST_LIBRARY_INCLUDED
 
-#include <iterator>
-#include <forward_list>
-#include <list>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
 #include <vector>
 
-#include <tao/benchmark/instrumented.hpp>
+// The tests are outside the include guard and count.hpp includes this
+// header, so this part can be compiled twice in a test build: the helpers
+// are lambdas, not namespace-scope functions that would be redefined.
 
-using namespace std;
-using namespace tao::algorithm;
+TEST_CASE("[find] testing the vectorized find and find_if against the scalar loops") {
+    using namespace tao::algorithm;
 
-// TEST_CASE("[shift] testing shift_right_by_one 0 elements random access") {
-//     using T = int;
-//     vector<T> a;
-//     shift_right_by_one(begin(a), end(a));
-//     CHECK(a == vector<T>());
-// }
+    auto find_if_reference = [](auto const& v, std::size_t f, std::size_t l, auto p) {
+        while (f != l && ! p(v[f])) ++f;
+        return f;
+    };
+
+    auto check_find_vectorized = [&](auto zero) {
+        using T = decltype(zero);
+        std::mt19937 gen(44);
+        for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+            set_simd_isa_limit(isa);
+            for (int round = 0; round < 40; ++round) {
+                // Small values, so that every comparison has hits and misses.
+                std::vector<T> v(gen() % 300 + 1);
+                for (auto& x : v) x = T(gen() % 7);
+                if (std::is_floating_point<T>::value && round % 4 == 0) {
+                    v[gen() % v.size()] = std::numeric_limits<T>::quiet_NaN();
+                    v[gen() % v.size()] = T(-0.0);
+                }
+                std::size_t const f = gen() % (v.size() / 2 + 1);
+                std::size_t const l = f + gen() % (v.size() - f + 1);
+                T const x = T(gen() % 8);
+                T const y = T(gen() % 8);
+
+                auto const first = v.data() + f;
+                auto const last = v.data() + l;
+                auto check = [&](auto p) {
+                    auto const expected = find_if_reference(v, f, l, [&](T z) { return p(z); });
+                    CHECK(std::size_t(tao::algorithm::find_if(first, last, p) - v.data()) == expected);
+                    auto const r = find_if_n(first, std::ptrdiff_t(l - f), p);
+                    CHECK(std::size_t(r.first - v.data()) == expected);
+                    CHECK(std::size_t(r.second) == l - expected);
+                    if (expected != l) {
+                        CHECK(std::size_t(find_if_unguarded(first, p) - v.data()) == expected);
+                    }
+                };
+                check(equal_to_value<T>(x));
+                check(not_equal_to_value<T>(v[f]));
+                check(less_than_value<T>(x));
+                check(greater_than_value<T>(x));
+                check(within_range<T>(x, y));
+                check(within_range<T>(x, T(x + 2)));
+
+                auto const expected = find_if_reference(v, f, l, [&](T z) { return z == x; });
+                CHECK(std::size_t(tao::algorithm::find(first, last, x) - v.data()) == expected);
+                CHECK(std::size_t(tao::algorithm::find(v.begin() + f, v.begin() + l, x) - v.begin()) == expected);
+                auto const r = find_n(first, std::ptrdiff_t(l - f), x);
+                CHECK(std::size_t(r.first - v.data()) == expected);
+                CHECK(std::size_t(r.second) == l - expected);
+                if (expected != l) {
+                    CHECK(std::size_t(find_unguarded(first, x) - v.data()) == expected);
+                }
+            }
+        }
+        set_simd_isa_limit(simd_isa::avx512);
+    };
+
+    check_find_vectorized(std::int8_t());
+    check_find_vectorized(std::uint8_t());
+    check_find_vectorized(std::int16_t());
+    check_find_vectorized(std::uint16_t());
+    check_find_vectorized(std::int32_t());
+    check_find_vectorized(std::uint32_t());
+    check_find_vectorized(std::int64_t());
+    check_find_vectorized(std::uint64_t());
+    check_find_vectorized(float());
+    check_find_vectorized(double());
+}
+
+TEST_CASE("[find] testing the vectorized find at the extremes of the value range") {
+    using namespace tao::algorithm;
+    std::vector<std::int32_t> const v = {0, -1, std::numeric_limits<std::int32_t>::max(), std::numeric_limits<std::int32_t>::min(), 5};
+    CHECK(tao::algorithm::find_if(v.begin(), v.end(), less_than_value<std::int32_t>(std::numeric_limits<std::int32_t>::min() + 1)) == v.begin() + 3);
+    CHECK(tao::algorithm::find_if(v.begin(), v.end(), greater_than_value<std::int32_t>(5)) == v.begin() + 2);
+    CHECK(tao::algorithm::find_if(v.begin(), v.end(), within_range<std::int32_t>(std::numeric_limits<std::int32_t>::min(), -1)) == v.begin() + 3);
+    CHECK(tao::algorithm::find_if(v.begin(), v.end(), within_range<std::int32_t>(3, 3)) == v.end());
+    std::vector<std::uint64_t> const u = {1, 2, ~std::uint64_t(0), 0};
+    CHECK(tao::algorithm::find_if(u.begin(), u.end(), greater_than_value<std::uint64_t>(std::uint64_t(1) << 63)) == u.begin() + 2);
+    CHECK(tao::algorithm::find_if(u.begin(), u.end(), less_than_value<std::uint64_t>(1)) == u.begin() + 3);
+}
+
+TEST_CASE("[find] testing the vectorized find_mismatch family against the scalar loops") {
+    using namespace tao::algorithm;
+
+    auto check = [](auto zero) {
+        using T = decltype(zero);
+        std::mt19937 gen(45);
+        for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+            set_simd_isa_limit(isa);
+            for (int round = 0; round < 60; ++round) {
+                std::vector<T> a(gen() % 300);
+                for (auto& x : a) x = T(gen() % 5);
+                std::vector<T> b = a;
+                if ( ! b.empty() && round % 3 != 0) b[gen() % b.size()] = T(9);
+                if (std::is_floating_point<T>::value && ! a.empty() && round % 5 == 0) {
+                    auto const k = gen() % a.size();
+                    a[k] = b[k] = std::numeric_limits<T>::quiet_NaN();
+                }
+                if (std::is_floating_point<T>::value && ! a.empty() && round % 7 == 0) {
+                    auto const k = gen() % a.size();
+                    a[k] = T(0.0);
+                    b[k] = T(-0.0);
+                }
+                if (round % 2 == 0) b.resize(gen() % (b.size() + 1));
+                auto const na = std::ptrdiff_t(a.size());
+                auto const nb = std::ptrdiff_t(b.size());
+
+                // A relation that is not std::equal_to takes the scalar loops.
+                auto const eq = [](T x, T y) { return x == y; };
+                auto const e = find_mismatch(a.begin(), a.end(), b.begin(), b.end(), eq);
+                auto const en = std::distance(a.begin(), e.first);
+
+                CHECK(find_mismatch(a.begin(), a.end(), b.begin(), b.end()) == e);
+                CHECK(find_mismatch(a.cbegin(), a.cend(), b.data(), b.data() + nb, std::equal_to<T>{}).first == a.cbegin() + en);
+                CHECK(find_mismatch_bn(a.begin(), a.end(), b.begin(), nb) == find_mismatch_bn(a.begin(), a.end(), b.begin(), nb, eq));
+                CHECK(find_mismatch_nb(a.begin(), na, b.begin(), b.end()) == find_mismatch_nb(a.begin(), na, b.begin(), b.end(), eq));
+                CHECK(find_mismatch_nn(a.begin(), na, b.begin(), nb) == find_mismatch_nn(a.begin(), na, b.begin(), nb, eq));
+                // Unaligned starts.
+                if (na > 3 && nb > 3) {
+                    CHECK(find_mismatch_nn(a.data() + 1, na - 1, b.data() + 1, nb - 1) ==
+                          find_mismatch_nn(a.data() + 1, na - 1, b.data() + 1, nb - 1, eq));
+                }
+            }
+        }
+        set_simd_isa_limit(simd_isa::avx512);
+    };
+    check(std::uint8_t());
+    check(std::int16_t());
+    check(std::int32_t());
+    check(std::uint64_t());
+    check(float());
+    check(double());
+}
+
+TEST_CASE("[find] testing the vectorized find_adjacent_mismatch against the scalar loop") {
+    using namespace tao::algorithm;
+
+    auto check = [](auto zero) {
+        using T = decltype(zero);
+        std::mt19937 gen(50);
+        for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+            set_simd_isa_limit(isa);
+            for (int round = 0; round < 80; ++round) {
+                // Long runs, so that the mismatches fall anywhere in a vector.
+                std::vector<T> a(gen() % 300);
+                T x = T(gen() % 3);
+                for (auto& y : a) {
+                    if (gen() % 97 == 0) x = T(gen() % 3);
+                    y = x;
+                }
+                if (std::is_floating_point<T>::value && ! a.empty() && round % 5 == 0) {
+                    a[gen() % a.size()] = std::numeric_limits<T>::quiet_NaN();
+                }
+                if (std::is_floating_point<T>::value && a.size() > 1 && round % 7 == 0) {
+                    auto const k = gen() % (a.size() - 1);
+                    a[k] = T(0.0);
+                    a[k + 1] = T(-0.0);
+                }
+                auto const eq = [](T y, T z) { return y == z; };
+                for (std::size_t k = 0; k < 3 && k <= a.size(); ++k) {
+                    auto const e = find_adjacent_mismatch(a.begin() + k, a.end(), eq);
+                    CHECK(find_adjacent_mismatch(a.begin() + k, a.end()) == e);
+                    CHECK(find_adjacent_mismatch(a.data() + k, a.data() + a.size(), std::equal_to<T>{}) == a.data() + (e - a.begin()));
+                }
+            }
+        }
+        set_simd_isa_limit(simd_isa::avx512);
+    };
+    check(std::uint8_t());
+    check(std::int16_t());
+    check(std::int32_t());
+    check(std::uint64_t());
+    check(float());
+    check(double());
+}
 
 #endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -0,0 +1,492 @@
+//! \file tao/algorithm/histogram.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_HISTOGRAM_HPP_
+#define TAO_ALGORITHM_HISTOGRAM_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/integers.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao { namespace algorithm {
+
+// ------------------------------------------------------------------------
+// Bucket schemes
+// ------------------------------------------------------------------------
+// A bucket scheme maps a value to a bucket index in [0, size()) and a
+// bucket index back to the half-open value range [lower(i), upper(i)).
+// Values outside the trackable range are clamped to the first/last bucket.
+
+template <Number T>
+struct linear_buckets {
+    using value_type = T;
+
+    linear_buckets(T lo, T hi, std::size_t n)
+        : lo(lo), hi(hi), n(n), width((double(hi) - double(lo)) / double(n))
+    {
+        //precondition: lo < hi && n > 0
+    }
+
+    std::size_t size() const { return n; }
+
+    // Branch-free so that the bulk loop in histogram::record can be vectorized.
+    // The first clamp is written so that NaN fails it and goes to bucket 0.
+    std::size_t index(T x) const {
+        double i = (double(x) - double(lo)) / width;
+        i = ! (i >= 0.0) ? 0.0 : i;
+        i = i > double(n - 1) ? double(n - 1) : i;
+        return std::size_t(i);
+    }
+
+    double lower(std::size_t i) const { return double(lo) + double(i) * width; }
+    double upper(std::size_t i) const { return double(lo) + double(i + 1) * width; }
+    double midpoint(std::size_t i) const { return lower(i) + width / 2; }
+
+    T lo;
+    T hi;
+    std::size_t n;
+    double width;
+};
+
+namespace detail {
+
+inline
+int floor_log2_u64(std::uint64_t x) {
+    //precondition: x != 0
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(x);
+#else
+    int r = 0;
+    while (x >>= 1) ++r;
+    return r;
+#endif
+}
+
+} // namespace detail
+
+// HdrHistogram-style log-linear buckets: each power of two range is split
+// in linear sub-buckets so that the relative error of any recorded value
+// is bounded by 10^-significant_digits.
+// Values are unsigned integers in [1, highest], 0 falls in the first bucket.
+template <Integer T = std::uint64_t>
+struct log_linear_buckets {
+    using value_type = T;
+
+    log_linear_buckets(T highest, int significant_digits)
+        : highest(highest), significant_digits(significant_digits)
+    {
+        //precondition: highest >= 2 && 1 <= significant_digits <= 5
+        std::uint64_t largest_single_unit = 2;
+        for (int i = 0; i < significant_digits; ++i) largest_single_unit *= 10;
+
+        int sub_bucket_count_magnitude = detail::floor_log2_u64(largest_single_unit - 1) + 1;
+        sub_bucket_half_count_magnitude = (std::max)(sub_bucket_count_magnitude, 1) - 1;
+        sub_bucket_count = std::uint64_t(1) << (sub_bucket_half_count_magnitude + 1);
+        sub_bucket_half_count = sub_bucket_count / 2;
+        sub_bucket_mask = sub_bucket_count - 1;
+
+        std::uint64_t smallest_untrackable = sub_bucket_count;
+        std::size_t buckets = 1;
+        while (smallest_untrackable <= std::uint64_t(highest)) {
+            if (smallest_untrackable > (std::numeric_limits<std::uint64_t>::max)() / 2) {
+                ++buckets;
+                break;
+            }
+            smallest_untrackable <<= 1;
+            ++buckets;
+        }
+        bucket_count = buckets;
+        n = (buckets + 1) * sub_bucket_half_count;
+    }
+
+    std::size_t size() const { return n; }
+
+    std::size_t index(T x) const {
+        std::uint64_t v = std::uint64_t(x);
+        int bucket_index = detail::floor_log2_u64(v | sub_bucket_mask) - sub_bucket_half_count_magnitude;
+        std::uint64_t sub_bucket_index = v >> bucket_index;
+        std::size_t i = (std::size_t(bucket_index) << sub_bucket_half_count_magnitude)
+                      + std::size_t(sub_bucket_index);
+        return (std::min)(i, n - 1);
+    }
+
+    double lower(std::size_t i) const {
+        return double(value_from_index(i));
+    }
+
+    double upper(std::size_t i) const {
+        return double(value_from_index(i) + (std::uint64_t(1) << bucket_of(i)));
+    }
+
+    double midpoint(std::size_t i) const {
+        return double(value_from_index(i)) + double(std::uint64_t(1) << bucket_of(i)) / 2;
+    }
+
+    int bucket_of(std::size_t i) const {
+        int b = int(i >> sub_bucket_half_count_magnitude) - 1;
+        return b < 0 ? 0 : b;
+    }
+
+    std::uint64_t value_from_index(std::size_t i) const {
+        int bucket_index = int(i >> sub_bucket_half_count_magnitude) - 1;
+        std::uint64_t sub_bucket_index = (i & (sub_bucket_half_count - 1)) + sub_bucket_half_count;
+        if (bucket_index < 0) {
+            sub_bucket_index -= sub_bucket_half_count;
+            bucket_index = 0;
+        }
+        return sub_bucket_index << bucket_index;
+    }
+
+    T highest;
+    int significant_digits;
+    int sub_bucket_half_count_magnitude;
+    std::uint64_t sub_bucket_count;
+    std::uint64_t sub_bucket_half_count;
+    std::uint64_t sub_bucket_mask;
+    std::size_t bucket_count;
+    std::size_t n;
+};
+
+// ------------------------------------------------------------------------
+// Histogram
+// ------------------------------------------------------------------------
+
+template <typename Scheme, Integer C = std::uint64_t>
+struct histogram {
+    using scheme_type = Scheme;
+    using value_type = typename Scheme::value_type;
+    using count_type = C;
+
+    explicit
+    histogram(Scheme const& scheme)
+        : scheme(scheme), counts(scheme.size(), C(0))
+    {}
+
+    void record(value_type x) {
+        ++counts[scheme.index(x)];
+        ++total;
+    }
+
+    void record_n(value_type x, C k) {
+        counts[scheme.index(x)] += k;
+        total += k;
+    }
+
+    template <Iterator I>
+        requires(Readable<I> && ValueType<I> == value_type)
+    void record(I f, I l) {
+        //precondition: readable_bounded_range(f, l)
+        record(f, l, IteratorCategory<I>{});
+    }
+
+    void merge(histogram const& x) {
+        //precondition: x.counts.size() == counts.size()
+        for (std::size_t i = 0; i < counts.size(); ++i) counts[i] += x.counts[i];
+        total += x.total;
+    }
+
+    histogram& operator+=(histogram const& x) {
+        merge(x);
+        return *this;
+    }
+
+    void reset() {
+        std::fill(counts.begin(), counts.end(), C(0));
+        total = C(0);
+    }
+
+    C total_count() const { return total; }
+    std::size_t size() const { return counts.size(); }
+    C count_at(std::size_t i) const { return counts[i]; }
+
+    double min() const {
+        auto it = std::find_if(counts.begin(), counts.end(), [](C c) { return c != C(0); });
+        if (it == counts.end()) return 0.0;
+        return scheme.lower(std::size_t(it - counts.begin()));
+    }
+
+    double max() const {
+        auto it = std::find_if(counts.rbegin(), counts.rend(), [](C c) { return c != C(0); });
+        if (it == counts.rend()) return 0.0;
+        return scheme.upper(std::size_t(counts.rend() - it - 1));
+    }
+
+    // Returns the upper bound of the bucket holding the q-quantile.
+    double value_at_quantile(double q) const {
+        //precondition: 0 <= q <= 1
+        if (zero(total)) return 0.0;
+        q = q < 0.0 ? 0.0 : (q > 1.0 ? 1.0 : q);
+        C target = C(std::ceil(q * double(total)));
+        if (zero(target)) target = C(1);
+
+        C acc(0);
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            acc += counts[i];
+            if (acc >= target) return scheme.upper(i);
+        }
+        return scheme.upper(counts.size() - 1);
+    }
+
+    double mean() const {
+        if (zero(total)) return 0.0;
+        double s = 0.0;
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            if (counts[i] != C(0)) s += scheme.midpoint(i) * double(counts[i]);
+        }
+        return s / double(total);
+    }
+
+    double population_variance() const {
+        if (zero(total)) return 0.0;
+        double m = mean();
+        double s = 0.0;
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            if (counts[i] != C(0)) {
+                double d = scheme.midpoint(i) - m;
+                s += d * d * double(counts[i]);
+            }
+        }
+        return s / double(total);
+    }
+
+    double sample_variance() const {
+        if (total < C(2)) return 0.0;
+        return population_variance() * double(total) / double(total - C(1));
+    }
+
+    double population_std_dev() const { return std::sqrt(population_variance()); }
+    double sample_std_dev() const { return std::sqrt(sample_variance()); }
+
+    Scheme scheme;
+    std::vector<C> counts;
+    C total = C(0);
+
+private:
+    template <Iterator I>
+    void record(I f, I l, std::input_iterator_tag) {
+        while (f != l) {
+            record(*f);
+            ++f;
+        }
+    }
+
+    // Two phases per block: the index computation has no loop-carried
+    // dependency and vectorizes; the scatter of increments does not.
+    template <RandomAccessIterator I>
+    void record(I f, I l, std::random_access_iterator_tag) {
+        constexpr std::ptrdiff_t block = 256;
+        std::size_t idx[block];
+
+        while (l - f >= block) {
+            for (std::ptrdiff_t k = 0; k < block; ++k) idx[k] = scheme.index(f[k]);
+            for (std::ptrdiff_t k = 0; k < block; ++k) ++counts[idx[k]];
+            f += block;
+            total += C(block);
+        }
+        std::ptrdiff_t r = l - f;
+        for (std::ptrdiff_t k = 0; k < r; ++k) idx[k] = scheme.index(f[k]);
+        for (std::ptrdiff_t k = 0; k < r; ++k) ++counts[idx[k]];
+        total += C(r);
+    }
+};
+
+template <typename Scheme>
+inline
+histogram<Scheme> make_histogram(Scheme const& scheme) {
+    return histogram<Scheme>(scheme);
+}
+
+// ------------------------------------------------------------------------
+// Concurrent recording
+// ------------------------------------------------------------------------
+
+namespace detail {
+
+inline
+std::size_t histogram_thread_id() {
+    static std::atomic<std::size_t> next{0};
+    thread_local std::size_t const id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+} // namespace detail
+
+// Lock-free recording from any number of threads. Every thread writes to
+// its own shard (threads are spread round-robin over Shards shards) with
+// relaxed atomic increments; snapshot() merges the shards.
+template <typename Scheme, std::size_t Shards = 16>
+struct concurrent_histogram {
+    using scheme_type = Scheme;
+    using value_type = typename Scheme::value_type;
+
+    explicit
+    concurrent_histogram(Scheme const& scheme)
+        : scheme(scheme)
+    {
+        for (auto& s : shards) {
+            s.counts.reset(new std::atomic<std::uint64_t>[scheme.size()]);
+            for (std::size_t i = 0; i < scheme.size(); ++i) {
+                s.counts[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    concurrent_histogram(concurrent_histogram const&) = delete;
+    concurrent_histogram& operator=(concurrent_histogram const&) = delete;
+
+    void record(value_type x) {
+        auto& s = shards[detail::histogram_thread_id() % Shards];
+        s.counts[scheme.index(x)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <Iterator I>
+        requires(Readable<I> && ValueType<I> == value_type)
+    void record(I f, I l) {
+        //precondition: readable_bounded_range(f, l)
+        auto& s = shards[detail::histogram_thread_id() % Shards];
+        while (f != l) {
+            s.counts[scheme.index(*f)].fetch_add(1, std::memory_order_relaxed);
+            ++f;
+        }
+    }
+
+    histogram<Scheme> snapshot() const {
+        histogram<Scheme> h(scheme);
+        for (auto const& s : shards) {
+            for (std::size_t i = 0; i < scheme.size(); ++i) {
+                auto c = s.counts[i].load(std::memory_order_relaxed);
+                h.counts[i] += c;
+                h.total += c;
+            }
+        }
+        return h;
+    }
+
+    struct alignas(64) shard {
+        std::unique_ptr<std::atomic<std::uint64_t>[]> counts;
+    };
+
+    Scheme scheme;
+    shard shards[Shards];
+};
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_HISTOGRAM_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <tao/algorithm/statistics.hpp>
+
+TEST_CASE("[histogram] testing linear_buckets histogram") {
+    using namespace tao::algorithm;
+
+    histogram<linear_buckets<double>> h(linear_buckets<double>(0.0, 100.0, 100));
+    std::vector<double> v;
+    for (int i = 0; i < 1000; ++i) v.push_back(i % 100 + 0.5);
+
+    h.record(v.begin(), v.end());
+    CHECK(h.total_count() == 1000);
+    CHECK(h.count_at(0) == 10);
+    CHECK(h.count_at(99) == 10);
+
+    CHECK(h.mean() == doctest::Approx(tao::algorithm::mean(v.begin(), v.end())));
+    CHECK(h.population_variance() == doctest::Approx(population_variance_n(v.begin(), v.size())));
+    CHECK(h.value_at_quantile(0.5) == doctest::Approx(50.0));
+    CHECK(h.value_at_quantile(1.0) == doctest::Approx(100.0));
+    CHECK(h.min() == doctest::Approx(0.0));
+    CHECK(h.max() == doctest::Approx(100.0));
+
+    h.record(-5.0);
+    h.record(500.0);
+    CHECK(h.count_at(0) == 11);
+    CHECK(h.count_at(99) == 11);
+
+    // NaN and the infinities, one at a time and through the bulk loop.
+    double const nan = std::numeric_limits<double>::quiet_NaN();
+    double const inf = std::numeric_limits<double>::infinity();
+    h.record(nan);
+    CHECK(h.count_at(0) == 12);
+    std::vector<double> const special {nan, -inf, inf, nan};
+    h.record(special.begin(), special.end());
+    CHECK(h.count_at(0) == 15);
+    CHECK(h.count_at(99) == 12);
+}
+
+TEST_CASE("[histogram] testing log_linear_buckets histogram") {
+    using namespace tao::algorithm;
+
+    log_linear_buckets<std::uint64_t> s(3600ull * 1000 * 1000, 3);
+    CHECK(s.sub_bucket_count == 2048);
+
+    // Exact below the first sub-bucket count.
+    for (std::uint64_t v = 0; v < 2048; ++v) {
+        CHECK(s.lower(s.index(v)) == double(v));
+    }
+
+    // Relative error bounded by 10^-3 everywhere.
+    for (std::uint64_t v = 2048; v < 3600ull * 1000 * 1000; v = v * 3 + 7) {
+        auto i = s.index(v);
+        CHECK(s.lower(i) <= double(v));
+        CHECK(double(v) < s.upper(i));
+        CHECK((s.upper(i) - s.lower(i)) / double(v) <= 0.001);
+    }
+
+    histogram<log_linear_buckets<std::uint64_t>> h(s);
+    std::vector<std::uint64_t> v;
+    for (std::uint64_t i = 1; i <= 10000; ++i) v.push_back(i * 100);
+    h.record(v.begin(), v.end());
+
+    CHECK(h.total_count() == 10000);
+    CHECK(h.mean() == doctest::Approx(tao::algorithm::mean(v.begin(), v.end())).epsilon(0.001));
+    CHECK(h.sample_std_dev() == doctest::Approx(sample_std_dev_n(v.begin(), v.size())).epsilon(0.001));
+    CHECK(h.value_at_quantile(0.99) == doctest::Approx(990000.0).epsilon(0.001));
+}
+
+TEST_CASE("[histogram] testing concurrent_histogram and merge") {
+    using namespace tao::algorithm;
+    using scheme_t = log_linear_buckets<std::uint64_t>;
+
+    scheme_t s(1000000, 2);
+    concurrent_histogram<scheme_t> ch(s);
+
+    std::vector<std::thread> ts;
+    for (int t = 0; t < 4; ++t) {
+        ts.emplace_back([&ch] {
+            for (std::uint64_t i = 1; i <= 1000; ++i) ch.record(i);
+        });
+    }
+    for (auto& t : ts) t.join();
+
+    auto h = ch.snapshot();
+    CHECK(h.total_count() == 4000);
+
+    histogram<scheme_t> a(s);
+    histogram<scheme_t> b(s);
+    for (std::uint64_t i = 1; i <= 1000; ++i) a.record(i);
+    b.record_n(7, 3);
+    a += b;
+    CHECK(a.total_count() == 1003);
+    CHECK(a.count_at(s.index(7)) == 4);
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -9,7 +9,11 @@
 #ifndef TAO_ALGORITHM_INTEGERS_HPP_
 #define TAO_ALGORITHM_INTEGERS_HPP_
 
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 #include <tao/algorithm/concepts.hpp>
 
@@ -43,6 +47,99 @@ template <Integer I>
 inline constexpr
 bool one(I const& a) { return a == I(1); }
 
+// Bit operations on 64-bit words.
+
+inline
+int count_trailing_zeros(std::uint64_t x) {
+    //precondition: x != 0
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int r = 0;
+    while ((x & 1) == 0) {
+        x >>= 1;
+        ++r;
+    }
+    return r;
+#endif
+}
+
+inline
+int count_leading_zeros(std::uint64_t x) {
+    //precondition: x != 0
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    int r = 0;
+    while ((x >> 63) == 0) {
+        x <<= 1;
+        ++r;
+    }
+    return r;
+#endif
+}
+
+inline
+int popcount(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    int r = 0;
+    while (x != 0) {
+        x &= x - 1;
+        ++r;
+    }
+    return r;
+#endif
+}
+
+// Stein's binary gcd: shifts and subtractions only, the powers of two are
+// removed with count_trailing_zeros.
+inline
+std::uint64_t binary_gcd(std::uint64_t a, std::uint64_t b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    int const k = count_trailing_zeros(a | b);
+    a >>= count_trailing_zeros(a);
+    while (b != 0) {
+        b >>= count_trailing_zeros(b);
+        if (a > b) std::swap(a, b);
+        b -= a;
+    }
+    return a << k;
+}
+
+namespace detail {
+
+// Unsigned integer twice as wide as U, for the products of modular arithmetic.
+template <typename U>
+struct wider_unsigned;
+
+template <>
+struct wider_unsigned<std::uint8_t> { using type = std::uint16_t; };
+
+template <>
+struct wider_unsigned<std::uint16_t> { using type = std::uint32_t; };
+
+template <>
+struct wider_unsigned<std::uint32_t> { using type = std::uint64_t; };
+
+#if defined(__SIZEOF_INT128__)
+template <>
+struct wider_unsigned<std::uint64_t> { using type = unsigned __int128; };
+#endif
+
+template <typename U>
+using wider_unsigned_t = typename wider_unsigned<U>::type;
+
+// Unsigned type of the same width as I.
+template <typename I>
+using modular_unsigned_t = std::conditional_t<sizeof(I) <= 1, std::uint8_t,
+                           std::conditional_t<sizeof(I) <= 2, std::uint16_t,
+                           std::conditional_t<sizeof(I) <= 4, std::uint32_t, std::uint64_t>>>;
+
+} // namespace detail
+
 template <Regular T>
 constexpr auto supremum = std::numeric_limits<T>::max();
 
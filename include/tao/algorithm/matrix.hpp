@@ -0,0 +1,434 @@
+//! \file tao/algorithm/matrix.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_MATRIX_HPP_
+#define TAO_ALGORITHM_MATRIX_HPP_
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/integers.hpp>
+#include <tao/algorithm/power.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao { namespace algorithm {
+
+// ------------------------------------------------------------------------
+// Square matrices of fixed size
+// ------------------------------------------------------------------------
+// Row-major N x N matrix. With operator* and identity_element it models
+// MultiplicativeMonoid, so power_monoid, power<N> and parallel_reduce work
+// on it directly.
+//
+// The product runs i, k, j: the inner loop updates a row of the result
+// with a row of b times a scalar, contiguous and with a trip count known
+// at compile time, which the compiler vectorizes. Matrices larger than
+// matrix_block are multiplied by panels of matrix_block rows and columns
+// of b, so the panel being read stays in L1 while every row of a goes by.
+
+constexpr std::size_t matrix_block = 32;
+
+template <Regular T, std::size_t N>
+struct matrix {
+    using value_type = T;
+    static constexpr std::size_t order = N;
+
+    static
+    matrix identity() {
+        matrix m{};
+        for (std::size_t i = 0; i < N; ++i) m(i, i) = T(1);
+        return m;
+    }
+
+    T& operator()(std::size_t i, std::size_t j) { return data[i * N + j]; }
+    T const& operator()(std::size_t i, std::size_t j) const { return data[i * N + j]; }
+
+    friend
+    bool operator==(matrix const& a, matrix const& b) { return a.data == b.data; }
+
+    friend
+    bool operator!=(matrix const& a, matrix const& b) { return !(a == b); }
+
+    friend
+    matrix operator+(matrix const& a, matrix const& b) {
+        matrix c;
+        for (std::size_t i = 0; i < N * N; ++i) c.data[i] = a.data[i] + b.data[i];
+        return c;
+    }
+
+    friend
+    matrix operator*(matrix const& a, matrix const& b) {
+        matrix c{};
+        multiply_add(a, b, c);
+        return c;
+    }
+
+    // c += a * b
+    static
+    void multiply_add(matrix const& a, matrix const& b, matrix& c) {
+        if constexpr (N <= matrix_block) {
+            for (std::size_t i = 0; i < N; ++i) {
+                for (std::size_t k = 0; k < N; ++k) {
+                    multiply_add_row<N>(a.data[i * N + k], &b.data[k * N], &c.data[i * N]);
+                }
+            }
+        } else {
+            constexpr std::size_t bs = matrix_block;
+            for (std::size_t kk = 0; kk < N; kk += bs) {
+                std::size_t const ke = kk + bs < N ? kk + bs : N;
+                for (std::size_t jj = 0; jj < N; jj += bs) {
+                    for (std::size_t i = 0; i < N; ++i) {
+                        for (std::size_t k = kk; k < ke; ++k) {
+                            T const x = a.data[i * N + k];
+                            T const* bk = &b.data[k * N + jj];
+                            T* ci = &c.data[i * N + jj];
+                            if (jj + bs <= N) multiply_add_row<bs>(x, bk, ci);
+                            else multiply_add_row<N % bs>(x, bk, ci);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // c[0, L) += x * b[0, L), L constant: the loop vectorizes without a tail.
+    template <std::size_t L>
+    static
+    void multiply_add_row(T x, T const* __restrict b, T* __restrict c) {
+        for (std::size_t j = 0; j < L; ++j) c[j] += x * b[j];
+    }
+
+    std::array<T, N * N> data;
+};
+
+template <Regular T, std::size_t N>
+matrix<T, N> identity_element(std::multiplies<matrix<T, N>>) {
+    return matrix<T, N>::identity();
+}
+
+// Product of matrices modulo modulus, a SemigroupOperation on matrices
+// with entries in [0, modulus). The products of the entries are
+// accumulated in a type twice as wide and reduced only when the
+// accumulators could overflow, once per row for moduli up to 32 bits
+// and N < 2^32.
+template <Integer I, std::size_t N>
+struct matrix_modulo_multiply {
+    I modulus;
+    matrix_modulo_multiply(I const& m) : modulus(m) {}
+
+    matrix<I, N> operator()(matrix<I, N> const& a, matrix<I, N> const& b) const {
+        // precondition: modulus > 0 && entries of a and b in [0, modulus)
+        using U = detail::modular_unsigned_t<I>;
+        using W = detail::wider_unsigned_t<U>;
+        W const m = W(U(modulus));
+        W const p = (m - 1) * (m - 1);
+        // Products that can be added to a reduced accumulator.
+        W const batch = p == 0 ? W(N) : (~W(0) - (m - 1)) / p;
+
+        matrix<I, N> c;
+        std::array<W, N> acc;
+        for (std::size_t i = 0; i < N; ++i) {
+            acc.fill(W(0));
+            W pending = 0;
+            for (std::size_t k = 0; k < N; ++k) {
+                if (pending == batch) {
+                    for (auto& x : acc) x %= m;
+                    pending = 0;
+                }
+                W const x = W(U(a(i, k)));
+                I const* bk = &b.data[k * N];
+                for (std::size_t j = 0; j < N; ++j) acc[j] += x * W(U(bk[j]));
+                ++pending;
+            }
+            for (std::size_t j = 0; j < N; ++j) c(i, j) = I(acc[j] % m);
+        }
+        return c;
+    }
+};
+
+template <Integer I, std::size_t N>
+matrix<I, N> identity_element(matrix_modulo_multiply<I, N> const&) {
+    return matrix<I, N>::identity();
+}
+
+
+// ------------------------------------------------------------------------
+// Linear recurrences
+// ------------------------------------------------------------------------
+// x[i] = c[0] x[i - 1] + c[1] x[i - 2] + ... + c[k - 1] x[i - k], given
+// x[0], ..., x[k - 1].
+//
+// linear_recurrence_nth raises the k x k companion matrix to the n-th
+// power: O(k^3 log n), k known at compile time.
+// linear_recurrence_nth_kitamasa computes x^n mod the characteristic
+// polynomial x^k - c[0] x^(k-1) - ... - c[k - 1] with power_monoid on
+// polynomials: O(k^2 log n), k known at run time.
+
+namespace detail {
+
+// Companion matrix: times the state (x[i + k - 1], ..., x[i]) it gives
+// (x[i + k], ..., x[i + 1]).
+template <Regular T, std::size_t K>
+matrix<T, K> companion_matrix(std::array<T, K> const& coeffs) {
+    matrix<T, K> m{};
+    for (std::size_t j = 0; j < K; ++j) m(0, j) = coeffs[j];
+    for (std::size_t i = 1; i < K; ++i) m(i, i - 1) = T(1);
+    return m;
+}
+
+template <Regular T>
+struct arithmetic_ring {
+    T add(T const& a, T const& b) const { return a + b; }
+    T multiply(T const& a, T const& b) const { return a * b; }
+};
+
+template <Integer I>
+struct modular_ring {
+    I add(I const& a, I const& b) const {
+        return a >= modulus - b ? I(a - (modulus - b)) : I(a + b);
+    }
+
+    I multiply(I const& a, I const& b) const {
+        using U = modular_unsigned_t<I>;
+        using W = wider_unsigned_t<U>;
+        return I(W(U(a)) * W(U(b)) % W(U(modulus)));
+    }
+
+    I modulus;
+};
+
+// Product of polynomials of degree < k modulo the characteristic
+// polynomial of coeffs; coefficients in increasing degree.
+template <Regular T, typename Ring>
+struct polynomial_modulo_multiply {
+    std::vector<T> operator()(std::vector<T> const& a, std::vector<T> const& b) const {
+        std::size_t const k = coeffs.size();
+        std::vector<T> p(2 * k - 1, T(0));
+        for (std::size_t i = 0; i < k; ++i) {
+            for (std::size_t j = 0; j < k; ++j) {
+                p[i + j] = ring.add(p[i + j], ring.multiply(a[i], b[j]));
+            }
+        }
+        // x^i = c[0] x^(i-1) + ... + c[k - 1] x^(i-k)
+        for (std::size_t i = 2 * k - 2; i >= k; --i) {
+            for (std::size_t j = 0; j < k; ++j) {
+                p[i - 1 - j] = ring.add(p[i - 1 - j], ring.multiply(p[i], coeffs[j]));
+            }
+        }
+        p.resize(k);
+        return p;
+    }
+
+    std::vector<T> coeffs;
+    Ring ring;
+};
+
+template <Regular T, typename Ring>
+std::vector<T> identity_element(polynomial_modulo_multiply<T, Ring> const& op) {
+    std::vector<T> one(op.coeffs.size(), T(0));
+    one[0] = T(1);
+    return one;
+}
+
+template <Regular T, Integer N, typename Ring>
+T kitamasa(std::vector<T> const& coeffs, std::vector<T> const& init, N n, Ring ring) {
+    //precondition: coeffs.size() == init.size() && coeffs.size() > 0 && n >= 0
+    std::size_t const k = coeffs.size();
+    polynomial_modulo_multiply<T, Ring> op{coeffs, ring};
+
+    // x mod the characteristic polynomial.
+    std::vector<T> x(k, T(0));
+    if (k == 1) x[0] = coeffs[0];
+    else x[1] = T(1);
+
+    std::vector<T> const r = power_monoid(x, n, op);
+    T s(0);
+    for (std::size_t i = 0; i < k; ++i) s = ring.add(s, ring.multiply(r[i], init[i]));
+    return s;
+}
+
+} // namespace detail
+
+//Complexity:
+//      Runtime:
+//          O(K^3 log n) multiplications of T
+//      Space:
+//          O(K^2)
+template <Regular T, std::size_t K, Integer N>
+T linear_recurrence_nth(std::array<T, K> const& coeffs, std::array<T, K> const& init, N n) {
+    //precondition: n >= 0
+    if (n < N(K)) return init[std::size_t(n)];
+    auto const m = power_monoid(detail::companion_matrix(coeffs), n - N(K - 1), std::multiplies<matrix<T, K>>());
+    // m maps the state at x[k - 1] to the state at x[n].
+    T r(0);
+    for (std::size_t j = 0; j < K; ++j) r = r + m(0, j) * init[K - 1 - j];
+    return r;
+}
+
+template <Integer I, std::size_t K, Integer N>
+I linear_recurrence_nth(std::array<I, K> const& coeffs, std::array<I, K> const& init, N n, I modulus) {
+    //precondition: n >= 0 && modulus > 0 && coeffs and init in [0, modulus)
+    if (n < N(K)) return init[std::size_t(n)];
+    auto const m = power_monoid(detail::companion_matrix(coeffs), n - N(K - 1), matrix_modulo_multiply<I, K>(modulus));
+    detail::modular_ring<I> ring{modulus};
+    I r(0);
+    for (std::size_t j = 0; j < K; ++j) r = ring.add(r, ring.multiply(m(0, j), init[K - 1 - j]));
+    return r;
+}
+
+//Complexity:
+//      Runtime:
+//          O(k^2 log n) multiplications of T, k = coeffs.size()
+//      Space:
+//          O(k)
+template <Regular T, Integer N>
+T linear_recurrence_nth_kitamasa(std::vector<T> const& coeffs, std::vector<T> const& init, N n) {
+    //precondition: coeffs.size() == init.size() && coeffs.size() > 0 && n >= 0
+    return detail::kitamasa(coeffs, init, n, detail::arithmetic_ring<T>{});
+}
+
+template <Integer I, Integer N>
+I linear_recurrence_nth_kitamasa(std::vector<I> const& coeffs, std::vector<I> const& init, N n, I modulus) {
+    //precondition: coeffs.size() == init.size() && coeffs.size() > 0 && n >= 0
+    //              && modulus > 0 && coeffs and init in [0, modulus)
+    return detail::kitamasa(coeffs, init, n, detail::modular_ring<I>{modulus});
+}
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_MATRIX_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("[matrix] testing matrix as a MultiplicativeMonoid") {
+    using namespace tao::algorithm;
+
+    // Fibonacci: [[1, 1], [1, 0]]^n = [[F(n + 1), F(n)], [F(n), F(n - 1)]]
+    matrix<std::uint64_t, 2> f{{1, 1, 1, 0}};
+    CHECK(power_monoid(f, 0, std::multiplies<matrix<std::uint64_t, 2>>()) == (matrix<std::uint64_t, 2>::identity()));
+    CHECK(power_monoid(f, 90, std::multiplies<matrix<std::uint64_t, 2>>())(0, 1) == 2880067194370816120ull);
+    CHECK(power<90>(f, std::multiplies<matrix<std::uint64_t, 2>>())(0, 1) == 2880067194370816120ull);
+
+    // Paths of length 6 between opposite corners of a 4-cycle: 2^5.
+    matrix<int, 4> g{{0, 1, 0, 1,
+                      1, 0, 1, 0,
+                      0, 1, 0, 1,
+                      1, 0, 1, 0}};
+    auto g6 = power_semigroup(g, 6, std::multiplies<matrix<int, 4>>());
+    CHECK(g6(0, 2) == 32);
+    CHECK(g6(0, 1) == 0);
+
+    // Blocked product against the naive one.
+    auto check = [](auto a) {
+        using M = decltype(a);
+        constexpr std::size_t n = M::order;
+        M b;
+        for (std::size_t i = 0; i < n * n; ++i) {
+            a.data[i] = std::int64_t((i * 7919) % 23) - 11;
+            b.data[i] = std::int64_t((i * 104729) % 19) - 9;
+        }
+        M c = a * b;
+        bool equal = true;
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                std::int64_t s = 0;
+                for (std::size_t k = 0; k < n; ++k) s += a(i, k) * b(k, j);
+                equal = equal && s == c(i, j);
+            }
+        }
+        CHECK(equal);
+        CHECK(a * M::identity() == a);
+    };
+    check(matrix<std::int64_t, 3>{});
+    check(matrix<std::int64_t, 32>{});
+    check(matrix<std::int64_t, 45>{});
+}
+
+TEST_CASE("[matrix] testing matrix_modulo_multiply") {
+    using namespace tao::algorithm;
+
+    auto check = [](auto a, auto m) {
+        using M = decltype(a);
+        using I = typename M::value_type;
+        constexpr std::size_t n = M::order;
+        M b;
+        for (std::size_t i = 0; i < n * n; ++i) {
+            a.data[i] = I((m - 1) - I(i % 3));
+            b.data[i] = I((I(i) * 7919) % m);
+        }
+        M const c = matrix_modulo_multiply<I, n>(m)(a, b);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                unsigned __int128 s = 0;
+                for (std::size_t k = 0; k < n; ++k) s = (s + (unsigned __int128)a(i, k) * b(k, j)) % m;
+                CHECK(c(i, j) == I(s));
+            }
+        }
+    };
+    check(matrix<std::uint32_t, 5>{}, std::uint32_t(4294967291u));
+    check(matrix<std::uint64_t, 7>{}, std::uint64_t(1000000007));
+    check(matrix<std::uint64_t, 6>{}, std::uint64_t(18446744073709551557ull));
+
+    // Fibonacci mod a prime.
+    std::uint64_t const p = 1000000007;
+    matrix<std::uint64_t, 2> f{{1, 1, 1, 0}};
+    auto fn = power_monoid(f, 1000000000000ull, matrix_modulo_multiply<std::uint64_t, 2>(p));
+    CHECK(fn(0, 1) == 730695249);
+}
+
+TEST_CASE("[matrix] testing linear_recurrence_nth and linear_recurrence_nth_kitamasa") {
+    using namespace tao::algorithm;
+
+    // Tribonacci
+    std::array<std::uint64_t, 3> const c{{1, 1, 1}};
+    std::array<std::uint64_t, 3> const x0{{0, 0, 1}};
+    std::vector<std::uint64_t> t = {0, 0, 1};
+    for (int i = 3; i < 70; ++i) t.push_back(t[i - 1] + t[i - 2] + t[i - 3]);
+    for (std::uint64_t n = 0; n < 70; ++n) {
+        CHECK(linear_recurrence_nth(c, x0, n) == t[n]);
+        CHECK(linear_recurrence_nth_kitamasa(std::vector<std::uint64_t>(c.begin(), c.end()),
+                                             std::vector<std::uint64_t>(x0.begin(), x0.end()), n) == t[n]);
+    }
+
+    // k = 1: geometric sequence.
+    CHECK(linear_recurrence_nth(std::array<int, 1>{{3}}, std::array<int, 1>{{2}}, 5) == 486);
+    CHECK(linear_recurrence_nth_kitamasa(std::vector<int>{3}, std::vector<int>{2}, 5) == 486);
+
+    // Both modular variants against iteration, k = 8.
+    std::uint64_t const p = 998244353;
+    std::array<std::uint64_t, 8> c8;
+    std::array<std::uint64_t, 8> x8;
+    std::vector<std::uint64_t> seq;
+    for (std::size_t i = 0; i < 8; ++i) {
+        c8[i] = (i * 31337 + 7) % p;
+        x8[i] = (i * i * 1000003 + 1) % p;
+        seq.push_back(x8[i]);
+    }
+    for (std::size_t i = 8; i < 2000; ++i) {
+        unsigned __int128 s = 0;
+        for (std::size_t j = 0; j < 8; ++j) s += (unsigned __int128)c8[j] * seq[i - 1 - j];
+        seq.push_back(std::uint64_t(s % p));
+    }
+    std::vector<std::uint64_t> const cv(c8.begin(), c8.end());
+    std::vector<std::uint64_t> const xv(x8.begin(), x8.end());
+    for (std::uint64_t n : {0, 7, 8, 9, 100, 1234, 1999}) {
+        CHECK(linear_recurrence_nth(c8, x8, n, p) == seq[n]);
+        CHECK(linear_recurrence_nth_kitamasa(cv, xv, n, p) == seq[n]);
+    }
+    std::uint64_t const n = 1000000000000000000ull;
+    CHECK(linear_recurrence_nth(c8, x8, n, p) == linear_recurrence_nth_kitamasa(cv, xv, n, p));
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -0,0 +1,461 @@
+//! \file tao/algorithm/multi_search.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_MULTI_SEARCH_HPP_
+#define TAO_ALGORITHM_MULTI_SEARCH_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/integers.hpp>
+#include <tao/algorithm/search.hpp>
+#include <tao/algorithm/simd.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao { namespace algorithm {
+
+// ------------------------------------------------------------------------
+// Multi-pattern search
+// ------------------------------------------------------------------------
+// A multi_searcher is built once from a set of non-empty patterns of bytes
+// and reports, in one pass over a text, every occurrence of every pattern
+// as callback(pattern_id, position), position being the distance from the
+// start of the text to match_first. Occurrences may overlap; those of one
+// pattern are reported in increasing position.
+//
+// 1. Aho-Corasick automaton. The states are numbered in breadth-first
+//    order, so the children of a state are consecutive and the goto
+//    function is a 256-bit bitmap per state: the child for byte c is
+//    child_base[c / 64] + popcount(bits[c / 64] below c). A cache line
+//    per state, whatever the alphabet; the root has a dense table.
+//    Works on ForwardIterators.
+// 2. Teddy (G. Langdale, Hyperscan) for up to multi_search_teddy_max
+//    patterns over contiguous memory, with AVX2. The patterns are grouped
+//    in 8 buckets; for each of the first 1 to 3 bytes of the patterns, two
+//    pshufb tables map the low and the high nibble of a text byte to the
+//    buckets where it may appear. The AND of these masks over 32 positions
+//    leaves the candidate positions and their buckets, which are verified
+//    with memcmp.
+
+constexpr std::size_t multi_search_teddy_max = 64;
+
+namespace detail {
+
+// One cache line per state.
+struct alignas(64) aho_corasick_state {
+    std::array<std::uint64_t, 4> bits;
+    std::array<std::int32_t, 4> child_base;
+    std::int32_t fail;
+    std::int32_t report;        // first state with output on the suffix chain, -1 if none
+};
+
+} // namespace detail
+
+struct multi_searcher {
+    template <ForwardIterator I>
+        requires(Readable<I>)
+    multi_searcher(I f, I l) {
+        // precondition: readable_bounded_range(f, l) && every pattern in [f, l) is non-empty
+        offsets.push_back(0);
+        while (f != l) {
+            for (auto const& x : *f) bytes.push_back(std::uint8_t(x));
+            offsets.push_back(bytes.size());
+            ++f;
+        }
+        build_automaton();
+        build_teddy();
+    }
+
+    std::size_t size() const { return offsets.size() - 1; }
+
+    //Complexity:
+    //      Runtime:
+    //          O(n + z) for z occurrences; each text element is read once
+    //      Space:
+    //          O(1), the automaton is built by the constructor
+    template <ForwardIterator I, typename F>
+        requires(Readable<I>)
+    F operator()(I f, I l, F callback) const {
+        // precondition: readable_bounded_range(f, l)
+        static_assert(detail::is_search_byte_v<ValueType<I>>, "multi_searcher works on ranges of bytes");
+#if defined(TAO_ALGORITHM_SIMD_X86)
+        if constexpr (is_contiguous_iterator_v<I>) {
+            if (teddy_width != 0 && simd_isa_level() >= simd_isa::avx2 && f != l) {
+                auto const s = static_cast<std::uint8_t const*>(static_cast<void const*>(std::addressof(*f)));
+                auto report = [&](std::size_t id, std::size_t pos) { callback(id, DistanceType<I>(pos)); };
+                run_teddy(s, std::size_t(l - f), report);
+                return callback;
+            }
+        }
+#endif
+        return run_automaton(f, l, callback);
+    }
+
+private:
+    std::vector<std::uint8_t> bytes;          // the patterns, concatenated
+    std::vector<std::size_t> offsets;         // pattern i is [offsets[i], offsets[i + 1])
+
+    // Aho-Corasick, state 0 is the root.
+    std::vector<detail::aho_corasick_state> states;
+    std::array<std::int32_t, 256> root{};     // transitions of the root, 0 when there is no child
+    std::vector<std::int32_t> output;         // first pattern ending at the state, -1 if none
+    std::vector<std::int32_t> next_output;    // next pattern ending at the same state
+    std::vector<std::int32_t> dictionary;     // nearest proper suffix state with output, -1 if none
+
+    // Teddy.
+    std::size_t teddy_width = 0;              // fingerprint length, 0 when Teddy is not used
+    std::array<std::array<std::uint8_t, 16>, 3> teddy_low{};
+    std::array<std::array<std::uint8_t, 16>, 3> teddy_high{};
+    std::array<std::vector<std::int32_t>, 8> buckets;
+
+    std::size_t length(std::size_t id) const { return offsets[id + 1] - offsets[id]; }
+
+    std::int32_t child(std::int32_t s, std::uint8_t c) const {
+        auto const& g = states[std::size_t(s)];
+        std::uint64_t const word = g.bits[c >> 6];
+        std::uint64_t const bit = std::uint64_t(1) << (c & 63);
+        std::int32_t const t = g.child_base[c >> 6] + std::int32_t(popcount(word & (bit - 1)));
+        return (word & bit) == 0 ? -1 : t;
+    }
+
+    void build_automaton() {
+        // Trie with temporary sorted child lists, then breadth-first renumbering.
+        std::vector<std::vector<std::pair<std::uint8_t, std::int32_t>>> trie(1);
+        std::vector<std::int32_t> trie_output(1, -1);
+        next_output.assign(size(), -1);
+        for (std::size_t id = 0; id < size(); ++id) {
+            std::int32_t s = 0;
+            for (std::size_t k = offsets[id]; k != offsets[id + 1]; ++k) {
+                auto& children = trie[std::size_t(s)];
+                auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(bytes[k], std::int32_t(-1)));
+                if (it == children.end() || it->first != bytes[k]) {
+                    auto const t = std::int32_t(trie.size());
+                    children.insert(it, std::make_pair(bytes[k], t));
+                    trie.emplace_back();
+                    trie_output.push_back(-1);
+                    s = t;
+                } else {
+                    s = it->second;
+                }
+            }
+            // Duplicated patterns share the state, ids in increasing order.
+            auto* link = &trie_output[std::size_t(s)];
+            while (*link != -1) link = &next_output[std::size_t(*link)];
+            *link = std::int32_t(id);
+        }
+
+        std::size_t const n = trie.size();
+        std::vector<std::int32_t> order;        // breadth-first order of the trie states
+        std::vector<std::int32_t> number(n);
+        order.reserve(n);
+        order.push_back(0);
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            for (auto const& c : trie[std::size_t(order[i])]) {
+                number[std::size_t(c.second)] = std::int32_t(order.size());
+                order.push_back(c.second);
+            }
+        }
+
+        states.assign(n, detail::aho_corasick_state{});
+        output.resize(n);
+        std::int32_t next_child = 1;
+        for (std::size_t i = 0; i < n; ++i) {
+            auto const& children = trie[std::size_t(order[i])];
+            auto& g = states[i];
+            for (auto const& c : children) g.bits[c.first >> 6] |= std::uint64_t(1) << (c.first & 63);
+            for (std::size_t w = 0; w < 4; ++w) {
+                g.child_base[w] = next_child;
+                next_child += std::int32_t(popcount(g.bits[w]));
+            }
+            output[i] = trie_output[std::size_t(order[i])];
+        }
+
+        // Failure and dictionary links, in breadth-first order.
+        dictionary.assign(n, -1);
+        for (std::size_t i = 0; i < n; ++i) {
+            for (auto const& c : trie[std::size_t(order[i])]) {
+                std::int32_t const t = number[std::size_t(c.second)];
+                std::int32_t v = 0;
+                if (i != 0) {
+                    std::int32_t s = states[i].fail;
+                    v = child(s, c.first);
+                    while (v == -1 && s != 0) {
+                        s = states[std::size_t(s)].fail;
+                        v = child(s, c.first);
+                    }
+                    if (v == -1) v = 0;
+                }
+                states[std::size_t(t)].fail = v;
+                dictionary[std::size_t(t)] = output[std::size_t(v)] != -1 ? v : dictionary[std::size_t(v)];
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            states[i].report = output[i] != -1 ? std::int32_t(i) : dictionary[i];
+        }
+        for (std::size_t c = 0; c < 256; ++c) {
+            std::int32_t const t = child(0, std::uint8_t(c));
+            root[c] = t == -1 ? 0 : t;
+        }
+    }
+
+    void build_teddy() {
+        if (size() == 0 || size() > multi_search_teddy_max) return;
+        std::size_t shortest = length(0);
+        for (std::size_t id = 1; id < size(); ++id) shortest = (std::min)(shortest, length(id));
+        teddy_width = (std::min)(shortest, std::size_t(3));
+
+        // Patterns with equal prefixes share a bucket, that keeps the
+        // number of buckets flagged per candidate low.
+        std::vector<std::int32_t> ids(size());
+        for (std::size_t id = 0; id < size(); ++id) ids[id] = std::int32_t(id);
+        std::stable_sort(ids.begin(), ids.end(), [&](std::int32_t a, std::int32_t b) {
+            auto const pa = bytes.begin() + std::ptrdiff_t(offsets[std::size_t(a)]);
+            auto const pb = bytes.begin() + std::ptrdiff_t(offsets[std::size_t(b)]);
+            return std::lexicographical_compare(pa, pa + std::ptrdiff_t(teddy_width), pb, pb + std::ptrdiff_t(teddy_width));
+        });
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            std::size_t const b = i * 8 / ids.size();
+            buckets[b].push_back(ids[i]);
+            for (std::size_t k = 0; k < teddy_width; ++k) {
+                std::uint8_t const c = bytes[offsets[std::size_t(ids[i])] + k];
+                teddy_low[k][c & 15] |= std::uint8_t(1u << b);
+                teddy_high[k][c >> 4] |= std::uint8_t(1u << b);
+            }
+        }
+        // Verification in increasing id order within a bucket.
+        for (auto& b : buckets) std::sort(b.begin(), b.end());
+    }
+
+    template <ForwardIterator I, typename F>
+    TAO_ALGORITHM_ALWAYS_INLINE
+    void automaton_loop(I f, I l, F& callback) const {
+        using D = DistanceType<I>;
+        std::int32_t s = 0;
+        D end = 0;
+        while (f != l) {
+            auto const c = std::uint8_t(*f);
+            ++f;
+            ++end;
+            // Without a child, most states fail directly to the root; the
+            // failure chain is walked only from deeper states.
+            std::int32_t t = s == 0 ? root[c] : child(s, c);
+            if (t == -1 && states[std::size_t(s)].fail != 0) {
+                std::int32_t u = states[std::size_t(s)].fail;
+                while (u != 0 && (t = child(u, c)) == -1) u = states[std::size_t(u)].fail;
+            }
+            s = t == -1 ? root[c] : t;
+            for (std::int32_t o = states[std::size_t(s)].report; o != -1; o = dictionary[std::size_t(o)]) {
+                for (std::int32_t id = output[std::size_t(o)]; id != -1; id = next_output[std::size_t(id)]) {
+                    callback(std::size_t(id), D(end - D(length(std::size_t(id)))));
+                }
+            }
+        }
+    }
+
+#if defined(TAO_ALGORITHM_SIMD_X86)
+    // The same loop, with the popcnt instruction.
+    template <ForwardIterator I, typename F>
+    TAO_ALGORITHM_TARGET_AVX2
+    void automaton_loop_popcnt(I f, I l, F& callback) const {
+        automaton_loop(f, l, callback);
+    }
+#endif
+
+    template <ForwardIterator I, typename F>
+    F run_automaton(I f, I l, F& callback) const {
+#if defined(TAO_ALGORITHM_SIMD_X86)
+        if (simd_isa_level() >= simd_isa::avx2) {
+            automaton_loop_popcnt(f, l, callback);
+            return callback;
+        }
+#endif
+        automaton_loop(f, l, callback);
+        return callback;
+    }
+
+    // Reports the occurrences starting at i + j for the set bits j of mask,
+    // candidates[j] holds the buckets to verify at i + j.
+    template <typename F>
+    void teddy_verify(std::uint8_t const* s, std::size_t n, std::size_t i,
+                      std::uint32_t mask, std::uint8_t const* candidates, F& report) const {
+        while (mask != 0) {
+            std::size_t const j = std::size_t(count_trailing_zeros(mask));
+            mask &= mask - 1;
+            std::size_t const pos = i + j;
+            std::uint32_t b = candidates[j];
+            while (b != 0) {
+                for (std::int32_t id : buckets[std::size_t(count_trailing_zeros(b))]) {
+                    std::size_t const m = length(std::size_t(id));
+                    if (m <= n - pos && std::memcmp(s + pos, bytes.data() + offsets[std::size_t(id)], m) == 0) {
+                        report(std::size_t(id), pos);
+                    }
+                }
+                b &= b - 1;
+            }
+        }
+    }
+
+#if defined(TAO_ALGORITHM_SIMD_X86)
+    // Candidates at the 32 positions starting at p: byte j of the result
+    // holds the buckets that may match at p + j.
+    template <std::size_t W>
+    TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_ALWAYS_INLINE
+    static __m256i teddy_block(std::uint8_t const* p, __m256i const* low, __m256i const* high) {
+        __m256i const nibble = _mm256_set1_epi8(0x0f);
+        __m256i r = _mm256_set1_epi8(char(0xff));
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t k = 0; k < W; ++k) {
+            __m256i const t = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + k));
+            __m256i const lo = _mm256_shuffle_epi8(low[k], _mm256_and_si256(t, nibble));
+            __m256i const hi = _mm256_shuffle_epi8(high[k], _mm256_and_si256(_mm256_srli_epi16(t, 4), nibble));
+            r = _mm256_and_si256(r, _mm256_and_si256(lo, hi));
+        }
+        return r;
+    }
+
+    template <std::size_t W, typename F>
+    TAO_ALGORITHM_TARGET_AVX2
+    void teddy_avx2(std::uint8_t const* s, std::size_t n, F& report) const {
+        __m256i low[W];
+        __m256i high[W];
+        for (std::size_t k = 0; k < W; ++k) {
+            low[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(teddy_low[k].data())));
+            high[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(teddy_high[k].data())));
+        }
+        __m256i const zero = _mm256_setzero_si256();
+        alignas(32) std::uint8_t candidates[32];
+
+        std::size_t i = 0;
+        for (; i + 32 + W - 1 <= n; i += 32) {
+            __m256i const r = teddy_block<W>(s + i, low, high);
+            auto const mask = ~std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(r, zero)));
+            if (mask == 0) continue;
+            _mm256_store_si256(reinterpret_cast<__m256i*>(candidates), r);
+            teddy_verify(s, n, i, mask, candidates, report);
+        }
+
+        // The last positions, from a zero padded copy; the verification reads the text.
+        alignas(32) std::uint8_t tail[64 + 32] = {};
+        std::memcpy(tail, s + i, n - i);
+        for (std::size_t j = 0; i + j < n; j += 32) {
+            __m256i const r = teddy_block<W>(tail + j, low, high);
+            auto mask = ~std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(r, zero)));
+            if (n - i - j < 32) mask &= (std::uint32_t(1) << (n - i - j)) - 1;     // positions past the end
+            _mm256_store_si256(reinterpret_cast<__m256i*>(candidates), r);
+            teddy_verify(s, n, i + j, mask, candidates, report);
+        }
+    }
+
+    template <typename F>
+    void run_teddy(std::uint8_t const* s, std::size_t n, F& report) const {
+        switch (teddy_width) {
+            case 1: teddy_avx2<1>(s, n, report); break;
+            case 2: teddy_avx2<2>(s, n, report); break;
+            default: teddy_avx2<3>(s, n, report); break;
+        }
+    }
+#endif
+};
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_MULTI_SEARCH_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <cstdint>
+#include <list>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+TEST_CASE("[multi_search] testing multi_searcher against search per pattern") {
+    using namespace tao::algorithm;
+
+    using match = std::pair<std::size_t, std::ptrdiff_t>;
+    auto expected_matches = [](std::vector<std::string> const& patterns, std::string const& text) {
+        std::vector<match> res;
+        for (std::size_t id = 0; id < patterns.size(); ++id) {
+            for (std::size_t p = 0; p + patterns[id].size() <= text.size(); ++p) {
+                if (text.compare(p, patterns[id].size(), patterns[id]) == 0) res.emplace_back(id, std::ptrdiff_t(p));
+            }
+        }
+        std::sort(res.begin(), res.end());
+        return res;
+    };
+
+    std::mt19937 gen(42);
+    for (std::size_t count : {1, 2, 5, 8, 17, 64, 65, 200}) {
+        for (int round = 0; round < 6; ++round) {
+            int const alphabet = round % 2 == 0 ? 3 : 20;
+            std::vector<std::string> patterns(count);
+            for (auto& p : patterns) {
+                p.resize(1 + gen() % (round < 2 ? 2 : 7));
+                for (auto& c : p) c = char('a' + gen() % unsigned(alphabet));
+            }
+            if (count > 1) patterns[1] = patterns[0];     // duplicated pattern
+            std::string text(gen() % 400, ' ');
+            for (auto& c : text) c = char('a' + gen() % unsigned(alphabet));
+            auto const expected = expected_matches(patterns, text);
+
+            multi_searcher const s(patterns.begin(), patterns.end());
+            for (auto isa : {simd_isa::scalar, simd_isa::avx2}) {
+                set_simd_isa_limit(isa);
+                std::vector<match> got;
+                s(text.begin(), text.end(), [&](std::size_t id, std::ptrdiff_t pos) { got.emplace_back(id, pos); });
+                // Occurrences of one pattern come in increasing position.
+                std::vector<std::ptrdiff_t> last(count, -1);
+                for (auto const& m : got) {
+                    CHECK(last[m.first] < m.second);
+                    last[m.first] = m.second;
+                }
+                std::sort(got.begin(), got.end());
+                CHECK(got == expected);
+            }
+            set_simd_isa_limit(simd_isa::avx512);
+
+            std::list<char> const chars(text.begin(), text.end());
+            std::vector<match> got;
+            s(chars.begin(), chars.end(), [&](std::size_t id, std::ptrdiff_t pos) { got.emplace_back(id, pos); });
+            std::sort(got.begin(), got.end());
+            CHECK(got == expected);
+        }
+    }
+}
+
+TEST_CASE("[multi_search] testing multi_searcher on overlapping and nested patterns") {
+    using namespace tao::algorithm;
+
+    std::vector<std::string> const patterns = {"he", "she", "his", "hers", "s"};
+    multi_searcher const s(patterns.begin(), patterns.end());
+    CHECK(s.size() == 5);
+    std::string const text = "ushers";
+    std::list<char> const chars(text.begin(), text.end());
+    std::vector<std::pair<std::size_t, std::ptrdiff_t>> got;
+    s(chars.begin(), chars.end(), [&](std::size_t id, std::ptrdiff_t pos) { got.emplace_back(id, pos); });
+    std::sort(got.begin(), got.end());
+    using P = std::pair<std::size_t, std::ptrdiff_t>;
+    CHECK(got == std::vector<P>{P{0, 2}, P{1, 1}, P{3, 2}, P{4, 1}, P{4, 5}});
+
+    std::vector<std::string> const none;
+    multi_searcher const empty(none.begin(), none.end());
+    std::size_t calls = 0;
+    empty(text.begin(), text.end(), [&](std::size_t, std::ptrdiff_t) { ++calls; });
+    CHECK(calls == 0);
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -0,0 +1,214 @@
+//! \file tao/algorithm/parallel/find.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_PARALLEL_FIND_HPP_
+#define TAO_ALGORITHM_PARALLEL_FIND_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/find.hpp>
+#include <tao/algorithm/parallel/workers.hpp>
+#include <tao/algorithm/predicates.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao { namespace algorithm {
+
+// Elements per block. A block is scanned with the sequential (vectorized
+// when possible) find_if; the per-block cost is one atomic increment and
+// one atomic load.
+constexpr std::size_t parallel_find_grain = 1 << 16;
+
+namespace detail {
+
+// Blocks are handed out in increasing order through an atomic cursor, so
+// all the workers scan the front of the range first and an early match
+// stops them after about one block each. The lowest match found so far is
+// kept in an atomic. A block that starts after it cannot hold the first
+// match and is not scanned; a worker that finds a match stops, since the
+// blocks it could take next come after it.
+// With First false any match will do and the workers stop at the first
+// one that is published.
+template <bool First, RandomAccessIterator I, UnaryPredicate P>
+std::size_t parallel_find_if_index(I f, std::size_t n, P const& p, std::size_t workers) {
+    //precondition: readable_weak_range(f, n) && workers > 1
+    std::atomic<std::size_t> next(0);
+    std::atomic<std::size_t> best(n);
+
+    run_workers(workers, [&](std::size_t) {
+        while (true) {
+            std::size_t const b = next.fetch_add(parallel_find_grain, std::memory_order_relaxed);
+            if (b >= n) return;
+            std::size_t const limit = best.load(std::memory_order_relaxed);
+            if (First ? b >= limit : limit != n) return;
+
+            std::size_t const e = n - b < parallel_find_grain ? n : b + parallel_find_grain;
+            auto const i = std::size_t(tao::algorithm::find_if(f + b, f + e, p) - f);
+            if (i != e) {
+                std::size_t current = best.load(std::memory_order_relaxed);
+                while (i < current && ! best.compare_exchange_weak(current, i, std::memory_order_relaxed)) {}
+                return;
+            }
+        }
+    });
+    return best.load(std::memory_order_relaxed);
+}
+
+// Negation that keeps the vectorized comparisons where there is one.
+template <typename P>
+predicate_negator<P> negation(P const& p) {
+    return predicate_negator<P>(p);
+}
+
+template <typename T>
+not_equal_to_value<T> negation(equal_to_value<T> const& p) {
+    return not_equal_to_value<T>(p.x);
+}
+
+template <typename T>
+equal_to_value<T> negation(not_equal_to_value<T> const& p) {
+    return equal_to_value<T>(p.x);
+}
+
+} // namespace detail
+
+//Complexity:
+//      Runtime:
+//          O(k + workers * parallel_find_grain) applications of p, k being
+//          the position of the first match (n if none)
+//      Space:
+//          O(workers)
+//
+// The first iterator in [f, l) that satisfies p, l if none: the result of
+// find_if. p is called concurrently from the workers.
+template <RandomAccessIterator I, UnaryPredicate P>
+    requires(Readable<I>, Domain<P, ValueType<I>)
+I parallel_find_if(I f, I l, P p, std::size_t workers) {
+    //precondition: readable_bounded_range(f, l) && workers > 0 && p can be called concurrently
+    auto const n = std::size_t(l - f);
+    if (workers > (n + parallel_find_grain - 1) / parallel_find_grain) {
+        workers = (n + parallel_find_grain - 1) / parallel_find_grain;
+    }
+    if (workers <= 1) return tao::algorithm::find_if(f, l, p);
+    return f + DistanceType<I>(detail::parallel_find_if_index<true>(f, n, p, workers));
+}
+
+template <RandomAccessIterator I, UnaryPredicate P>
+    requires(Readable<I>, Domain<P, ValueType<I>)
+I parallel_find_if(I f, I l, P p) {
+    //precondition: readable_bounded_range(f, l) && p can be called concurrently
+    return parallel_find_if(f, l, p, workers_for(std::size_t(l - f), parallel_find_grain));
+}
+
+template <RandomAccessIterator I>
+    requires(Readable<I>)
+I parallel_find(I f, I l, ValueType<I> const& x) {
+    //precondition: readable_bounded_range(f, l)
+    return parallel_find_if(f, l, equal_to_value<std::remove_cv_t<ValueType<I>>>(x));
+}
+
+//Complexity:
+//      Runtime:
+//          O(n) applications of p, the workers stop once any of them
+//          finds a match
+//      Space:
+//          O(workers)
+template <RandomAccessIterator I, UnaryPredicate P>
+    requires(Readable<I>, Domain<P, ValueType<I>)
+bool parallel_some(I f, I l, P p, std::size_t workers) {
+    //precondition: readable_bounded_range(f, l) && workers > 0 && p can be called concurrently
+    auto const n = std::size_t(l - f);
+    if (workers > (n + parallel_find_grain - 1) / parallel_find_grain) {
+        workers = (n + parallel_find_grain - 1) / parallel_find_grain;
+    }
+    if (workers <= 1) return tao::algorithm::find_if(f, l, p) != l;
+    return detail::parallel_find_if_index<false>(f, n, p, workers) != n;
+}
+
+template <RandomAccessIterator I, UnaryPredicate P>
+    requires(Readable<I>, Domain<P, ValueType<I>)
+bool parallel_some(I f, I l, P p) {
+    //precondition: readable_bounded_range(f, l) && p can be called concurrently
+    return parallel_some(f, l, p, workers_for(std::size_t(l - f), parallel_find_grain));
+}
+
+template <RandomAccessIterator I, UnaryPredicate P>
+    requires(Readable<I>, Domain<P, ValueType<I>)
+bool parallel_none(I f, I l, P p) {
+    //precondition: readable_bounded_range(f, l) && p can be called concurrently
+    return ! parallel_some(f, l, p);
+}
+
+template <RandomAccessIterator I, UnaryPredicate P>
+    requires(Readable<I>, Domain<P, ValueType<I>)
+bool parallel_all(I f, I l, P p) {
+    //precondition: readable_bounded_range(f, l) && p can be called concurrently
+    return ! parallel_some(f, l, detail::negation(p));
+}
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_PARALLEL_FIND_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("[parallel_find] testing parallel_find_if against find_if") {
+    using namespace tao::algorithm;
+
+    std::vector<std::int32_t> v(5 * parallel_find_grain + 123, 0);
+    auto const n = v.size();
+    // The first match, at the front, in the middle, at block edges, at the end and missing.
+    for (std::size_t k : {std::size_t(0), std::size_t(1), parallel_find_grain - 1, parallel_find_grain,
+                          3 * parallel_find_grain + 17, n - 1, n}) {
+        std::fill(v.begin(), v.end(), 0);
+        if (k != n) {
+            v[k] = 7;
+            for (std::size_t j = k + 1; j < n; j += 9973) v[j] = 7;
+        }
+        for (std::size_t workers : {1, 2, 3, 8}) {
+            CHECK(std::size_t(parallel_find_if(v.begin(), v.end(), equal_to_value<std::int32_t>(7), workers) - v.begin()) == k);
+            CHECK(std::size_t(parallel_find_if(v.begin(), v.end(), [](std::int32_t x) { return x == 7; }, workers) - v.begin()) == k);
+            CHECK(parallel_some(v.begin(), v.end(), equal_to_value<std::int32_t>(7), workers) == (k != n));
+        }
+        CHECK(std::size_t(parallel_find(v.begin(), v.end(), 7) - v.begin()) == k);
+        CHECK(parallel_some(v.begin(), v.end(), greater_than_value<std::int32_t>(0)) == (k != n));
+        CHECK(parallel_none(v.begin(), v.end(), equal_to_value<std::int32_t>(7)) == (k == n));
+        CHECK(parallel_all(v.begin(), v.end(), equal_to_value<std::int32_t>(0)) == (k == n));
+        CHECK(parallel_all(v.begin(), v.end(), less_than_value<std::int32_t>(8)));
+    }
+    CHECK(parallel_find_if(v.begin(), v.begin(), equal_to_value<std::int32_t>(0), 4) == v.begin());
+    CHECK(parallel_all(v.begin(), v.begin(), equal_to_value<std::int32_t>(1)));
+}
+
+TEST_CASE("[parallel_find] testing that parallel_find_if stops after an early match") {
+    using namespace tao::algorithm;
+
+    std::vector<std::int32_t> v(64 * parallel_find_grain, 0);
+    v[10] = 1;
+    std::atomic<std::size_t> calls(0);
+    auto p = [&](std::int32_t x) {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        return x == 1;
+    };
+    std::size_t const workers = 4;
+    CHECK(parallel_find_if(v.begin(), v.end(), p, workers) == v.begin() + 10);
+    // Every worker scans about the block it holds when the match is
+    // published, not the 64 blocks of the range.
+    CHECK(calls.load() < v.size() / 2);
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -0,0 +1,83 @@
+//! \file tao/algorithm/parallel/prime_batch.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_PARALLEL_PRIME_BATCH_HPP_
+#define TAO_ALGORITHM_PARALLEL_PRIME_BATCH_HPP_
+
+#include <algorithm>
+#include <cstddef>
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/parallel/workers.hpp>
+#include <tao/algorithm/prime_batch.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao { namespace algorithm {
+
+// Minimum amount of candidates per worker.
+constexpr std::size_t parallel_prime_batch_grain = 4096;
+
+//Complexity:
+//      Runtime:
+//          same total work as prime_batch, split in workers contiguous chunks
+//      Space:
+//          O(1) per worker
+template <RandomAccessIterator I, RandomAccessIterator O>
+    requires(Readable<I> && Integer<ValueType<I>> && Writable<O>)
+O parallel_prime_batch(I f, I l, O out, std::size_t workers) {
+    //precondition: readable_bounded_range(f, l) && writable_counted_range(out, l - f) && workers > 0
+    std::size_t const n = std::size_t(l - f);
+    if (workers <= 1) return prime_batch(f, l, out);
+
+    // Bounds of the i-th of workers contiguous chunks.
+    auto bound = [&](std::size_t i) {
+        return DistanceType<I>(n / workers * i + (std::min)(i, n % workers));
+    };
+    run_workers(workers, [&](std::size_t i) {
+        prime_batch(f + bound(i), f + bound(i + 1), out + bound(i));
+    });
+    return out + DistanceType<I>(n);
+}
+
+template <RandomAccessIterator I, RandomAccessIterator O>
+    requires(Readable<I> && Integer<ValueType<I>> && Writable<O>)
+O parallel_prime_batch(I f, I l, O out) {
+    //precondition: readable_bounded_range(f, l) && writable_counted_range(out, l - f)
+    return parallel_prime_batch(f, l, out, workers_for(std::size_t(l - f), parallel_prime_batch_grain));
+}
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_PARALLEL_PRIME_BATCH_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("[parallel_prime_batch] testing parallel_prime_batch against prime") {
+    using namespace tao::algorithm;
+
+    std::vector<std::uint64_t> v;
+    for (std::uint64_t x = 4294967296ull - 20000; x < 4294967296ull + 20000; ++x) v.push_back(x);
+
+    std::vector<char> expected;
+    for (auto x : v) expected.push_back(prime(x));
+
+    for (std::size_t workers : {1, 2, 3, 8}) {
+        std::vector<char> res(v.size());
+        CHECK(parallel_prime_batch(v.begin(), v.end(), res.begin(), workers) == res.end());
+        CHECK(res == expected);
+    }
+    std::vector<char> res(v.size());
+    CHECK(parallel_prime_batch(v.begin(), v.end(), res.begin()) == res.end());
+    CHECK(res == expected);
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -0,0 +1,131 @@
+//! \file tao/algorithm/parallel/reduce.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_PARALLEL_REDUCE_HPP_
+#define TAO_ALGORITHM_PARALLEL_REDUCE_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <tao/algorithm/counter_machine.hpp>
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/parallel/workers.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao { namespace algorithm {
+
+constexpr std::size_t parallel_reduce_grain = 4096;
+
+//Complexity:
+//      Runtime:
+//          Exact: n - 1 applications of op (minus those absorbed by e)
+//      Space:
+//          O(workers)
+//
+// Every worker reduces a contiguous chunk through its own counter machine.
+// The partial results are then added, in chunk order, to a final counter
+// machine. Only associativity is required: non-commutative operations
+// (matrix products, concatenation, merging of sorted runs) produce the
+// same result as a sequential reduction.
+template <ForwardIterator I, BinaryOperation Op>
+    requires(Readable<I> && Domain<Op> == ValueType<I>)
+ValueType<I> parallel_reduce(I f, I l, Op op, ValueType<I> const& e, std::size_t workers) {
+    // precondition: readable_bounded_range(f, l) && Op is associative && workers > 0
+    //               && op and ValueType<I> copies can be used concurrently
+    using T = ValueType<I>;
+
+    auto n = std::size_t(std::distance(f, l));
+    if (workers > n) workers = n;
+    if (workers <= 1) return reduce_balanced(f, l, op, e);
+
+    std::vector<I> bounds;
+    bounds.reserve(workers + 1);
+    bounds.push_back(f);
+    for (std::size_t i = 0; i < workers; ++i) {
+        auto size = n / workers + (i < n % workers ? 1 : 0);
+        bounds.push_back(std::next(bounds.back(), size));
+    }
+
+    std::vector<T> partial(workers, e);
+    run_workers(workers, [&](std::size_t i) {
+        partial[i] = reduce_balanced(bounds[i], bounds[i + 1], op, e);
+    });
+
+    return reduce_balanced(partial.begin(), partial.end(), op, e);
+}
+
+template <ForwardIterator I, BinaryOperation Op>
+    requires(Readable<I> && Domain<Op> == ValueType<I>)
+inline
+ValueType<I> parallel_reduce(I f, I l, Op op, ValueType<I> const& e) {
+    // precondition: readable_bounded_range(f, l) && Op is associative
+    auto n = std::size_t(std::distance(f, l));
+    return parallel_reduce(f, l, op, e, workers_for(n, parallel_reduce_grain));
+}
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_PARALLEL_REDUCE_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST_CASE("[parallel_reduce] testing parallel_reduce with a commutative operation") {
+    using namespace tao::algorithm;
+    std::vector<std::uint64_t> a(100000);
+    std::iota(a.begin(), a.end(), 1);
+
+    auto expected = std::accumulate(a.begin(), a.end(), std::uint64_t(0));
+    CHECK(reduce_balanced(a.begin(), a.end(), std::plus<>(), std::uint64_t(0)) == expected);
+    for (std::size_t w = 1; w <= 9; ++w) {
+        CHECK(parallel_reduce(a.begin(), a.end(), std::plus<>(), std::uint64_t(0), w) == expected);
+    }
+    CHECK(parallel_reduce(a.begin(), a.end(), std::plus<>(), std::uint64_t(0)) == expected);
+    CHECK(parallel_reduce(a.begin(), a.begin(), std::plus<>(), std::uint64_t(0), 4) == 0);
+}
+
+TEST_CASE("[parallel_reduce] testing parallel_reduce with non-commutative operations") {
+    using namespace tao::algorithm;
+
+    std::list<std::string> words;
+    std::string expected;
+    for (int i = 0; i < 1000; ++i) {
+        words.push_back(std::to_string(i));
+        expected += words.back();
+    }
+    auto concat = [](std::string const& a, std::string const& b) { return a + b; };
+    for (std::size_t w = 1; w <= 7; ++w) {
+        CHECK(parallel_reduce(words.begin(), words.end(), concat, std::string(), w) == expected);
+    }
+
+    // 2x2 matrix product (mod 2^64), the identity plays the role of the counter zero.
+    using m2 = std::array<std::uint64_t, 4>;
+    auto mult = [](m2 const& a, m2 const& b) {
+        return m2{a[0] * b[0] + a[1] * b[2], a[0] * b[1] + a[1] * b[3],
+                  a[2] * b[0] + a[3] * b[2], a[2] * b[1] + a[3] * b[3]};
+    };
+    m2 const id{1, 0, 0, 1};
+    std::vector<m2> ms;
+    for (std::uint64_t i = 0; i < 3000; ++i) ms.push_back(m2{i % 3, 1, i % 5 + 1, i % 7});
+
+    auto seq = std::accumulate(ms.begin(), ms.end(), id, mult);
+    for (std::size_t w = 1; w <= 8; ++w) {
+        CHECK(parallel_reduce(ms.begin(), ms.end(), mult, id, w) == seq);
+    }
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -0,0 +1,137 @@
+//! \file tao/algorithm/parallel/sieve.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_PARALLEL_SIEVE_HPP_
+#define TAO_ALGORITHM_PARALLEL_SIEVE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <tao/algorithm/parallel/workers.hpp>
+#include <tao/algorithm/primes.hpp>
+
+namespace tao { namespace algorithm {
+
+// Minimum amount of numbers per worker: a few segments, so the sieving
+// primes set up by every worker are amortized.
+constexpr std::uint64_t parallel_sieve_grain = 4 * 30 * prime_segment_bytes;
+
+namespace detail {
+
+// Bounds of the i-th of workers contiguous chunks of [lo, hi).
+inline
+std::uint64_t parallel_sieve_bound(std::uint64_t lo, std::uint64_t hi, std::size_t i, std::size_t workers) {
+    if (i == workers) return hi;
+    std::uint64_t const n = hi - lo;
+    return lo + (n / workers) * i + (std::min)(std::uint64_t(i), n % workers);
+}
+
+} // namespace detail
+
+//Complexity:
+//      Runtime:
+//          O((hi - lo) log log hi + workers sqrt(hi)) total work
+//      Space:
+//          O(workers (sqrt(hi) / log(hi) + prime_segment_bytes))
+//
+// Every worker sieves a contiguous chunk of [lo, hi) with its own
+// segmented_sieve: its own segment buffer, sieving primes and bucket lists
+// for the large sieving primes, nothing is shared.
+// f is called concurrently from the workers; each worker reports the
+// primes of its chunk in increasing order.
+template <typename F>
+void parallel_sieve(std::uint64_t lo, std::uint64_t hi, F f, std::size_t workers) {
+    //precondition: lo <= hi && workers > 0 && f can be called concurrently
+    if (workers <= 1) {
+        for_each_prime(lo, hi, f);
+        return;
+    }
+    run_workers(workers, [&](std::size_t i) {
+        for_each_prime(detail::parallel_sieve_bound(lo, hi, i, workers),
+                       detail::parallel_sieve_bound(lo, hi, i + 1, workers), f);
+    });
+}
+
+template <typename F>
+void parallel_sieve(std::uint64_t lo, std::uint64_t hi, F f) {
+    //precondition: lo <= hi && f can be called concurrently
+    parallel_sieve(lo, hi, f, workers_for(std::size_t(hi - lo), parallel_sieve_grain));
+}
+
+// Number of primes in [lo, hi), every worker counts its chunk with popcount.
+inline
+std::uint64_t parallel_count_primes(std::uint64_t lo, std::uint64_t hi, std::size_t workers) {
+    //precondition: lo <= hi && workers > 0
+    if (workers <= 1) return count_primes(lo, hi);
+
+    std::vector<std::uint64_t> partial(workers);
+    run_workers(workers, [&](std::size_t i) {
+        partial[i] = count_primes(detail::parallel_sieve_bound(lo, hi, i, workers),
+                                  detail::parallel_sieve_bound(lo, hi, i + 1, workers));
+    });
+
+    std::uint64_t c = 0;
+    for (auto x : partial) c += x;
+    return c;
+}
+
+inline
+std::uint64_t parallel_count_primes(std::uint64_t lo, std::uint64_t hi) {
+    //precondition: lo <= hi
+    return parallel_count_primes(lo, hi, workers_for(std::size_t(hi - lo), parallel_sieve_grain));
+}
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_PARALLEL_SIEVE_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+TEST_CASE("[parallel_sieve] testing parallel_count_primes against count_primes") {
+    using namespace tao::algorithm;
+
+    CHECK(parallel_count_primes(0, 10000000) == 664579);
+    CHECK(parallel_count_primes(0, 0, 4) == 0);
+    CHECK(parallel_count_primes(0, 3, 4) == 1);
+
+    std::uint64_t const lo = 10000000000ull;
+    std::uint64_t const hi = lo + 3000000;
+    std::uint64_t const expected = count_primes(lo, hi);
+    // Small segments put most sieving primes in the bucket lists.
+    CHECK(count_primes<64>(lo, hi) == expected);
+    for (std::size_t workers : {1, 2, 3, 7}) {
+        CHECK(parallel_count_primes(lo, hi, workers) == expected);
+        CHECK(parallel_count_primes(0, 1000000, workers) == 78498);
+    }
+}
+
+TEST_CASE("[parallel_sieve] testing parallel_sieve reports every prime once") {
+    using namespace tao::algorithm;
+
+    std::vector<std::uint64_t> expected;
+    for_each_prime(0, 2000000, [&](std::uint64_t p) { expected.push_back(p); });
+
+    for (std::size_t workers : {1, 2, 5}) {
+        std::mutex m;
+        std::vector<std::uint64_t> primes;
+        parallel_sieve(0, 2000000, [&](std::uint64_t p) {
+            std::lock_guard<std::mutex> lock(m);
+            primes.push_back(p);
+        }, workers);
+        std::sort(primes.begin(), primes.end());
+        CHECK(primes == expected);
+    }
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
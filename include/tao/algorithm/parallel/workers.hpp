@@ -0,0 +1,80 @@
+//! \file tao/algorithm/parallel/workers.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_PARALLEL_WORKERS_HPP_
+#define TAO_ALGORITHM_PARALLEL_WORKERS_HPP_
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include <tao/algorithm/concepts.hpp>
+
+namespace tao { namespace algorithm {
+
+inline
+std::size_t default_workers() {
+    auto n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : std::size_t(n);
+}
+
+// Number of workers worth using for n units of work: never more than
+// requested, never less than grain units per worker.
+inline
+std::size_t workers_for(std::size_t n, std::size_t grain, std::size_t workers = default_workers()) {
+    //precondition: grain > 0
+    std::size_t w = (n + grain - 1) / grain;
+    if (w > workers) w = workers;
+    return w == 0 ? 1 : w;
+}
+
+// Calls p(i) for every i in [0, workers), each one on its own thread.
+// Worker 0 runs on the calling thread. The first exception thrown by a
+// worker is rethrown once all of them have finished. If a thread cannot be
+// started, the ones already running are joined and the std::system_error
+// is rethrown; worker 0 and the workers not started do not run.
+template <Procedure P>
+    requires(Procedure<P> && Arity<P> == 1)
+void run_workers(std::size_t workers, P p) {
+    //precondition: workers > 0
+    std::vector<std::exception_ptr> errors(workers);
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+
+    try {
+        for (std::size_t i = 1; i < workers; ++i) {
+            threads.emplace_back([&p, &errors, i] {
+                try {
+                    p(i);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+    } catch (...) {
+        for (auto& t : threads) t.join();
+        throw;
+    }
+
+    try {
+        p(std::size_t(0));
+    } catch (...) {
+        errors[0] = std::current_exception();
+    }
+
+    for (auto& t : threads) t.join();
+
+    for (auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+}
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_PARALLEL_WORKERS_HPP_*/
@@ -11,19 +11,135 @@
 
 // #include <utility>
 // #include <functional>   //std::not_fn(), C++17
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
 
 #include <tao/algorithm/concepts.hpp>
 #include <tao/algorithm/integers.hpp>
+#include <tao/algorithm/simd.hpp>
 #include <tao/algorithm/type_attributes.hpp>
 
 namespace tao { namespace algorithm {
 
+// Searches advanced together by partition_point_batch.
+constexpr std::size_t partition_point_batch_width = 16;
+
+// Below this many bytes the rest of a search is assumed to be in cache and
+// the probes are not prefetched: the prefetches would cost more than they
+// hide.
+constexpr std::size_t partition_point_prefetch_bytes = 1 << 15;
+
+// Above this many bytes partition_point_n is the branchy loop of
+// std::lower_bound: the top steps miss the caches and the TLB either way,
+// and the speculation past a predicted branch starts the next miss as early
+// as the prefetches do.
+constexpr std::size_t partition_point_branchy_bytes = 1 << 23;
+
+namespace detail {
+
+template <typename I>
+constexpr bool is_random_access_iterator_v =
+    std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<I>::iterator_category>::value;
+
+template <typename I>
+TAO_ALGORITHM_ALWAYS_INLINE
+void prefetch_element(I f, DistanceType<I> i) {
+    //precondition: readable_counted_range(f, i + 1)
+    if constexpr (std::is_lvalue_reference<typename std::iterator_traits<I>::reference>::value) {
+        TAO_ALGORITHM_PREFETCH(std::addressof(f[i]));
+    }
+}
+
+// Length above which partition_point_branchless_n and partition_point_group
+// prefetch, never less than 4 so that the next probes exist.
+template <typename I>
+constexpr DistanceType<I> prefetch_length() {
+    constexpr std::size_t k = partition_point_prefetch_bytes / sizeof(ValueType<I>);
+    return DistanceType<I>(k < 4 ? 4 : k);
+}
+
+template <typename I>
+constexpr DistanceType<I> branchy_length() {
+    constexpr std::size_t k = partition_point_branchy_bytes / sizeof(ValueType<I>);
+    return DistanceType<I>(k < 4 ? 4 : k);
+}
+
+// Branch-free halving: the probe is the last element of the lower half and
+// the base moves by a conditional move. While the range is large both probes
+// of the next step are prefetched, one of them is the one that will be read.
+// Ranges above branchy_length are searched by the branchy loop instead; base
+// and n both depend on the probe so that it stays a branch.
+template <RandomAccessIterator I, UnaryPredicate P>
+I partition_point_branchless_n(I f, DistanceType<I> n, P p) {
+    //precondition:  readable_counted_range(f, n) && partitioned_n(f, n, p)
+    using N = DistanceType<I>;
+    if (n == 0) return f;
+    N base = 0;
+    if (n > branchy_length<I>()) {
+        while (n != 0) {
+            N const h = half(n);
+            if (p(f[base + h])) {
+                n = h;
+            } else {
+                base += h + 1;
+                n -= h + 1;
+            }
+        }
+        return f + base;
+    }
+    while (n > prefetch_length<I>()) {
+        N const h = half(n);
+        N const next = half(n - h);
+        prefetch_element(f, base + next - 1);
+        prefetch_element(f, base + h + next - 1);
+        base += p(f[base + h - 1]) ? N(0) : h;
+        n -= h;
+    }
+    while (n > 1) {
+        N const h = half(n);
+        base += p(f[base + h - 1]) ? N(0) : h;
+        n -= h;
+    }
+    return f + (base + N( ! p(f[base])));
+}
+
+// The searches of a group have the same length at every step, only their
+// bases differ. Once the base of a search is moved its next probe is known
+// and prefetched, the other searches of the group are advanced meanwhile.
+// test(i, x) applies the i-th predicate of the group to x.
+template <RandomAccessIterator I, typename Test>
+void partition_point_group(I f, DistanceType<I> n, std::size_t m, Test test, DistanceType<I>* base) {
+    //precondition:  readable_counted_range(f, n) && n > 0 && m <= partition_point_batch_width
+    using N = DistanceType<I>;
+    std::fill(base, base + m, N(0));
+    while (n > 1) {
+        N const h = half(n);
+        N const next = half(n - h);
+        bool const prefetch = n > prefetch_length<I>();
+        for (std::size_t i = 0; i != m; ++i) {
+            base[i] += test(i, f[base[i] + h - 1]) ? N(0) : h;
+            if (prefetch) prefetch_element(f, base[i] + next - 1);
+        }
+        n -= h;
+    }
+    for (std::size_t i = 0; i != m; ++i) base[i] += N( ! test(i, f[base[i]]));
+}
+
+} // namespace detail
+
 template <ForwardIterator I, UnaryPredicate P>
     requires(Readable<I> && Domain<P, ValueType<I>>)
 I partition_point_n(I f, DistanceType<I> n, P p) {
     //precondition:  readable_counted_range(f, n) && partitioned_n(f, n, p)
     //complexity:    O(log2(n))
 
+    if constexpr (detail::is_random_access_iterator_v<I>) {
+        return detail::partition_point_branchless_n(f, n, p);
+    }
     while (n != 0) {
         auto h = half(n);
         I m = std::next(f, h);
@@ -64,12 +180,69 @@ I potential_partition_point(I f, I l, P p) {
     f = std::find_if(f, l, p);
     if (f == l) return f;
 
-    I j = std::next(f);
-    while (j == l) {
-        if ( ! p(*j)) ++f;
-        ++j;
+    // Counted without branches, then one advance.
+    DistanceType<I> k(0);
+    for (I j = std::next(f); j != l; ++j) k += DistanceType<I>( ! p(*j));
+    return std::next(f, k);
+}
+
+//Complexity:
+//      Runtime:
+//          O(m log2(n)) applications of the predicates, m being the number
+//          of queries
+//      Space:
+//          O(partition_point_batch_width)
+//
+// Writes partition_point_n(f, n, q) for every predicate q of [qf, ql) to
+// out, in order. The searches run partition_point_batch_width at a time in
+// lockstep, so that the cache misses of the group overlap.
+template <RandomAccessIterator I, ForwardIterator Q, Iterator O>
+    requires(Readable<I> && Readable<Q> && Writable<O> && Domain<ValueType<Q>, ValueType<I>>)
+O partition_point_batch(I f, DistanceType<I> n, Q qf, Q ql, O out) {
+    //precondition:  readable_counted_range(f, n) && readable_bounded_range(qf, ql)
+    //               && for every q in [qf, ql): partitioned_n(f, n, q)
+    constexpr std::size_t W = partition_point_batch_width;
+    if (n == 0) {
+        for (; qf != ql; ++qf, ++out) *out = f;
+        return out;
     }
-    return f;
+    Q group[W];
+    DistanceType<I> base[W];
+    while (qf != ql) {
+        std::size_t m = 0;
+        for (; m != W && qf != ql; ++m, ++qf) group[m] = qf;
+        detail::partition_point_group(f, n, m, [&](std::size_t i, auto const& x) { return (*group[i])(x); }, base);
+        for (std::size_t i = 0; i != m; ++i, ++out) *out = f + base[i];
+    }
+    return out;
+}
+
+// Writes the lower bound of every key of [xf, xl) in [f, f + n) to out.
+template <RandomAccessIterator I, ForwardIterator X, Iterator O, StrictWeakOrdering R>
+    requires(Readable<I> && Readable<X> && Writable<O> && ValueType<X> == ValueType<I> && Domain<R> == ValueType<I>)
+O lower_bound_batch(I f, DistanceType<I> n, X xf, X xl, O out, R r) {
+    //precondition:  readable_counted_range(f, n) && sorted_n(f, n, r) && readable_bounded_range(xf, xl)
+    constexpr std::size_t W = partition_point_batch_width;
+    if (n == 0) {
+        for (; xf != xl; ++xf, ++out) *out = f;
+        return out;
+    }
+    X group[W];
+    DistanceType<I> base[W];
+    while (xf != xl) {
+        std::size_t m = 0;
+        for (; m != W && xf != xl; ++m, ++xf) group[m] = xf;
+        detail::partition_point_group(f, n, m, [&](std::size_t i, auto const& y) { return ! r(y, *group[i]); }, base);
+        for (std::size_t i = 0; i != m; ++i, ++out) *out = f + base[i];
+    }
+    return out;
+}
+
+template <RandomAccessIterator I, ForwardIterator X, Iterator O>
+    requires(Readable<I> && Readable<X> && Writable<O> && ValueType<X> == ValueType<I>)
+O lower_bound_batch(I f, DistanceType<I> n, X xf, X xl, O out) {
+    //precondition:  readable_counted_range(f, n) && sorted_n(f, n) && readable_bounded_range(xf, xl)
+    return lower_bound_batch(f, n, xf, xl, out, std::less<>());
 }
 
 }} /*tao::algorithm*/
@@ -100,3 +273,108 @@ I potential_partition_point(I f, I l, P p) {
 // }
 
 // #endif /*DOCTEST_LIBRARY_INCLUDED*/
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <vector>
+
+TEST_CASE("[partition_point] testing the branch-free partition_point_n against std::lower_bound") {
+    using namespace tao::algorithm;
+
+    std::mt19937 gen(5);
+    for (std::size_t n = 0; n != 300; ++n) {
+        std::vector<int> v(n);
+        for (auto& x : v) x = int(gen() % 100);
+        std::sort(v.begin(), v.end());
+        std::list<int> const l(v.begin(), v.end());
+        for (int x = -1; x < 102; x += 3) {
+            auto p = [x](int y) { return ! (y < x); };
+            auto const expected = std::lower_bound(v.begin(), v.end(), x);
+            CHECK(partition_point_n(v.begin(), std::ptrdiff_t(n), p) == expected);
+            CHECK(tao::algorithm::partition_point(v.begin(), v.end(), p) == expected);
+            CHECK(std::distance(l.begin(), tao::algorithm::partition_point(l.begin(), l.end(), p)) == expected - v.begin());
+        }
+    }
+}
+
+TEST_CASE("[partition_point] testing partition_point_n and lower_bound_batch above the prefetch length") {
+    using namespace tao::algorithm;
+
+    // Long enough for the prefetching steps of partition_point_branchless_n
+    // and partition_point_group, and for the branchy loop above them.
+    using It = std::vector<int>::iterator;
+    for (std::size_t n : {3 * std::size_t(detail::prefetch_length<It>()) + 5, std::size_t(detail::branchy_length<It>()) + 5}) {
+        std::mt19937 gen(49);
+        std::vector<int> v(n);
+        for (auto& x : v) x = int(gen() % 100000);
+        std::sort(v.begin(), v.end());
+
+        std::vector<int> keys;
+        for (int x = -1; x < 100002; x += 97) keys.push_back(x);
+        std::vector<It> res(keys.size());
+        lower_bound_batch(v.begin(), std::ptrdiff_t(n), keys.begin(), keys.end(), res.begin());
+        for (std::size_t i = 0; i != keys.size(); ++i) {
+            int const x = keys[i];
+            auto const expected = std::lower_bound(v.begin(), v.end(), x);
+            CHECK(partition_point_n(v.begin(), std::ptrdiff_t(n), [x](int y) { return ! (y < x); }) == expected);
+            CHECK(res[i] == expected);
+        }
+    }
+}
+
+TEST_CASE("[partition_point] testing potential_partition_point") {
+    using namespace tao::algorithm;
+
+    auto p = [](int x) { return x != 0; };
+    std::vector<int> a;
+    CHECK(potential_partition_point(a.begin(), a.end(), p) == a.end());
+    a = {0, 0, 0, 0};
+    CHECK(potential_partition_point(a.begin(), a.end(), p) == a.end());
+    a = {0, 0, 1, 1};
+    CHECK(potential_partition_point(a.begin(), a.end(), p) == a.begin() + 2);
+    a = {0, 0, 1, 0};
+    CHECK(potential_partition_point(a.begin(), a.end(), p) == a.begin() + 3);
+    a = {1, 0, 1, 0, 0};
+    CHECK(potential_partition_point(a.begin(), a.end(), p) == a.begin() + 3);
+}
+
+TEST_CASE("[partition_point] testing partition_point_batch and lower_bound_batch") {
+    using namespace tao::algorithm;
+
+    std::mt19937 gen(6);
+    for (std::size_t n : {0, 1, 2, 3, 7, 16, 17, 1000, 4099}) {
+        std::vector<std::uint32_t> v(n);
+        for (auto& x : v) x = gen() % 5000;
+        std::sort(v.begin(), v.end());
+
+        std::vector<std::uint32_t> keys(n % 7 * 11 + 37);
+        for (auto& x : keys) x = gen() % 5100;
+        std::vector<std::vector<std::uint32_t>::iterator> res(keys.size());
+        CHECK(lower_bound_batch(v.begin(), std::ptrdiff_t(n), keys.begin(), keys.end(), res.begin()) == res.end());
+        for (std::size_t i = 0; i != keys.size(); ++i) {
+            CHECK(res[i] == std::lower_bound(v.begin(), v.end(), keys[i]));
+        }
+
+        std::list<std::uint32_t> const descending(keys.begin(), keys.end());
+        std::vector<std::uint32_t const*> upper;
+        lower_bound_batch(v.data(), std::ptrdiff_t(n), descending.begin(), descending.end(), std::back_inserter(upper), std::less_equal<>());
+        CHECK(upper.size() == keys.size());
+        for (std::size_t i = 0; i != keys.size(); ++i) {
+            CHECK(upper[i] == v.data() + (std::upper_bound(v.begin(), v.end(), keys[i]) - v.begin()));
+        }
+
+        auto predicate = [](std::uint32_t x) { return [x](std::uint32_t y) { return x <= y; }; };
+        std::vector<decltype(predicate(0))> ps;
+        for (auto x : keys) ps.push_back(predicate(x));
+        std::vector<std::uint32_t const*> pp(ps.size());
+        partition_point_batch(v.data(), std::ptrdiff_t(n), ps.begin(), ps.end(), pp.begin());
+        for (std::size_t i = 0; i != keys.size(); ++i) {
+            CHECK(pp[i] == v.data() + (std::lower_bound(v.begin(), v.end(), keys[i]) - v.begin()));
+        }
+    }
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -0,0 +1,519 @@
+//! \file tao/algorithm/partition/static_index.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_PARTITION_STATIC_INDEX_HPP_
+#define TAO_ALGORITHM_PARTITION_STATIC_INDEX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/find.hpp>
+#include <tao/algorithm/integers.hpp>
+#include <tao/algorithm/simd.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao { namespace algorithm {
+
+// ------------------------------------------------------------------------
+// Static search indexes
+// ------------------------------------------------------------------------
+// Copies of a sorted range laid out for searching, built once. The queries
+// return the position in the sorted range that partition_point,
+// std::lower_bound or std::upper_bound would return.
+//
+// eytzinger_index: the keys in BFS order, node k has children 2k and
+// 2k + 1. The descent is branchless (k = 2k + !p(key)) and prefetches the
+// descendants of the first level down that fill a cache line (for 4-byte
+// keys: four levels, 16 keys, one line, since the array is cache line
+// aligned). Any T and predicate. The position is the in-order rank of the
+// final node, computed from k and n.
+//
+// s_tree_index: a static B+ tree (S+ tree) of integers, float or double
+// whose nodes are one cache line, 64 / sizeof(T) keys. The leaves are the
+// sorted keys themselves, the internal nodes hold the first key of every
+// child but the first, so a level costs one cache miss and one vector
+// comparison plus popcount; log_17(n) levels for 4-byte keys.
+
+namespace detail {
+
+template <typename T>
+struct cache_aligned_allocator {
+    using value_type = T;
+    static constexpr std::size_t alignment = 64;
+
+    cache_aligned_allocator() = default;
+
+    template <typename U>
+    cache_aligned_allocator(cache_aligned_allocator<U> const&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+    }
+
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(alignment));
+    }
+
+    template <typename U>
+    bool operator==(cache_aligned_allocator<U> const&) const { return true; }
+
+    template <typename U>
+    bool operator!=(cache_aligned_allocator<U> const&) const { return false; }
+};
+
+// In-order rank of the node k of the Eytzinger layout of n keys. Levels
+// 0 to L - 1 are full and the last level L holds n - 2^L + 1 keys, the
+// leftmost ones. In the perfect tree of L + 1 levels the rank is
+// (2 (k - 2^d) + 1) 2^(L - d) - 1, d being the depth of k; the missing
+// keys of level L are the ones of even perfect rank from 2 (n - 2^L + 1)
+// on, and those before k are subtracted.
+inline
+std::size_t eytzinger_rank(std::size_t k, std::size_t n) {
+    //precondition: 1 <= k <= n
+    int const levels = 63 - count_leading_zeros(n);
+    int const depth = 63 - count_leading_zeros(k);
+    std::size_t const last = n - (std::size_t(1) << levels) + 1;
+    std::size_t const perfect = ((2 * (k - (std::size_t(1) << depth)) + 1) << (levels - depth)) - 1;
+    std::size_t const before = (perfect + 1) / 2;
+    return perfect - (before > last ? before - last : 0);
+}
+
+// Descendants of a node on the first level down where they take at least
+// a cache line: the smallest power of two d with d * size >= 64. Other
+// strides do not land on descendants and are no better than no prefetch.
+constexpr
+std::size_t eytzinger_prefetch_stride(std::size_t size) {
+    std::size_t d = 1;
+    while (d * size < 64) d *= 2;
+    return d;
+}
+
+} // namespace detail
+
+template <Regular T, StrictWeakOrdering R = std::less<>>
+class eytzinger_index {
+public:
+    // The descent prefetches keys_[k * prefetch_stride].
+    static constexpr std::size_t prefetch_stride = detail::eytzinger_prefetch_stride(sizeof(T));
+
+    //Complexity:
+    //      Runtime:
+    //          O(n)
+    //      Space:
+    //          O(n)
+    template <ForwardIterator I>
+        requires(Readable<I> && ValueType<I> == T)
+    eytzinger_index(I f, I l, R r = R())
+        : n_(std::size_t(std::distance(f, l)))
+        , keys_(n_ + 1)
+        , r_(r)
+    {
+        //precondition: readable_bounded_range(f, l) && sorted(f, l, r)
+        build(f, 1);
+    }
+
+    std::size_t size() const { return n_; }
+
+    //Complexity:
+    //      Runtime:
+    //          floor(log2(n)) + 1 applications of p
+    //      Space:
+    //          O(1)
+    template <UnaryPredicate P>
+        requires(Domain<P> == T)
+    std::size_t partition_point(P p) const {
+        //precondition: partitioned(sorted keys, p)
+        // The descendants of k that are log2(prefetch_stride) levels down
+        // are the prefetch_stride keys from k * prefetch_stride on. The
+        // address is computed as an integer, it is past the keys near the
+        // leaves.
+        auto const base = reinterpret_cast<std::uintptr_t>(keys_.data());
+        std::size_t k = 1;
+        while (k <= n_) {
+            TAO_ALGORITHM_PREFETCH(reinterpret_cast<char const*>(base + k * prefetch_stride * sizeof(T)));
+            k = 2 * k + std::size_t( ! p(keys_[k]));
+        }
+        // Undo the right turns after the last left one: that node is the
+        // first key that satisfies p.
+        k >>= count_trailing_zeros(~std::uint64_t(k)) + 1;
+        return k == 0 ? n_ : detail::eytzinger_rank(k, n_);
+    }
+
+    std::size_t lower_bound(T const& x) const {
+        return partition_point([&](T const& y) { return ! r_(y, x); });
+    }
+
+    std::size_t upper_bound(T const& x) const {
+        return partition_point([&](T const& y) { return r_(x, y); });
+    }
+
+private:
+    template <typename I>
+    void build(I& f, std::size_t k) {
+        if (k > n_) return;
+        build(f, 2 * k);
+        keys_[k] = *f;
+        ++f;
+        build(f, 2 * k + 1);
+    }
+
+    std::size_t n_;
+    std::vector<T, detail::cache_aligned_allocator<T>> keys_;    // keys_[0] is unused
+    R r_;
+};
+
+namespace detail {
+
+// Keys of a node that are below x (K == less) or above x (K == greater).
+template <compare_kind K, typename T>
+std::size_t node_count_scalar(T const* node, T x) {
+    constexpr std::size_t B = 64 / sizeof(T);
+    std::size_t res = 0;
+    for (std::size_t i = 0; i != B; ++i) {
+        res += std::size_t(K == compare_kind::less ? node[i] < x : x < node[i]);
+    }
+    return res;
+}
+
+// Position in the leaves of the descent: in every node the number i of
+// keys below x (lower bound) or not above x (upper bound) picks the child.
+template <compare_kind K, typename T, typename Count>
+std::size_t s_tree_descend(T const* keys, std::size_t const* offsets, std::size_t layers, T x, Count count) {
+    constexpr std::size_t B = 64 / sizeof(T);
+    std::size_t k = 0;
+    for (std::size_t h = 0; h + 1 != layers; ++h) {
+        std::size_t const c = count(keys + offsets[h] + k * B, x);
+        k = k * (B + 1) + (K == compare_kind::less ? c : B - c);
+    }
+    std::size_t const c = count(keys + offsets[layers - 1] + k * B, x);
+    return k * B + (K == compare_kind::less ? c : B - c);
+}
+
+#if defined(TAO_ALGORITHM_SIMD_X86)
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_SSE2 TAO_ALGORITHM_ALWAYS_INLINE
+std::size_t node_count_sse2(T const* node, __m128i a) {
+    auto const p = reinterpret_cast<__m128i const*>(node);
+    std::uint64_t const m = std::uint64_t(_mm_movemask_epi8(compare_lanes_sse2<K, T>(_mm_load_si128(p), a, a))) |
+                            std::uint64_t(_mm_movemask_epi8(compare_lanes_sse2<K, T>(_mm_load_si128(p + 1), a, a))) << 16 |
+                            std::uint64_t(_mm_movemask_epi8(compare_lanes_sse2<K, T>(_mm_load_si128(p + 2), a, a))) << 32 |
+                            std::uint64_t(_mm_movemask_epi8(compare_lanes_sse2<K, T>(_mm_load_si128(p + 3), a, a))) << 48;
+    return std::size_t(popcount(m)) / sizeof(T);
+}
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_SSE2
+std::size_t s_tree_descend_sse2(T const* keys, std::size_t const* offsets, std::size_t layers, T x) {
+    constexpr std::size_t B = 64 / sizeof(T);
+    __m128i const a = broadcast_sse2(x);
+    std::size_t k = 0;
+    for (std::size_t h = 0; h + 1 != layers; ++h) {
+        std::size_t const c = node_count_sse2<K>(keys + offsets[h] + k * B, a);
+        k = k * (B + 1) + (K == compare_kind::less ? c : B - c);
+    }
+    std::size_t const c = node_count_sse2<K>(keys + offsets[layers - 1] + k * B, a);
+    return k * B + (K == compare_kind::less ? c : B - c);
+}
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_ALWAYS_INLINE
+std::size_t node_count_avx2(T const* node, __m256i a) {
+    auto const p = reinterpret_cast<__m256i const*>(node);
+    std::uint64_t const m = std::uint64_t(std::uint32_t(_mm256_movemask_epi8(compare_lanes_avx2<K, T>(_mm256_load_si256(p), a, a)))) |
+                            std::uint64_t(std::uint32_t(_mm256_movemask_epi8(compare_lanes_avx2<K, T>(_mm256_load_si256(p + 1), a, a)))) << 32;
+    return std::size_t(popcount(m)) / sizeof(T);
+}
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_AVX2
+std::size_t s_tree_descend_avx2(T const* keys, std::size_t const* offsets, std::size_t layers, T x) {
+    constexpr std::size_t B = 64 / sizeof(T);
+    __m256i const a = broadcast_avx2(x);
+    std::size_t k = 0;
+    for (std::size_t h = 0; h + 1 != layers; ++h) {
+        std::size_t const c = node_count_avx2<K>(keys + offsets[h] + k * B, a);
+        k = k * (B + 1) + (K == compare_kind::less ? c : B - c);
+    }
+    std::size_t const c = node_count_avx2<K>(keys + offsets[layers - 1] + k * B, a);
+    return k * B + (K == compare_kind::less ? c : B - c);
+}
+
+template <compare_kind K, typename T>
+TAO_ALGORITHM_TARGET_AVX512
+std::size_t s_tree_descend_avx512(T const* keys, std::size_t const* offsets, std::size_t layers, T x) {
+    constexpr std::size_t B = 64 / sizeof(T);
+    __m512i const a = broadcast_avx512(x);
+    std::size_t k = 0;
+    for (std::size_t h = 0; h + 1 != layers; ++h) {
+        std::size_t const c = std::size_t(popcount(compare_lanes_avx512<K, T>(_mm512_load_si512(keys + offsets[h] + k * B), a, a)));
+        k = k * (B + 1) + (K == compare_kind::less ? c : B - c);
+    }
+    std::size_t const c = std::size_t(popcount(compare_lanes_avx512<K, T>(_mm512_load_si512(keys + offsets[layers - 1] + k * B), a, a)));
+    return k * B + (K == compare_kind::less ? c : B - c);
+}
+
+#endif
+
+} // namespace detail
+
+template <typename T>
+class s_tree_index {
+    static_assert(is_simd_arithmetic_v<T>, "s_tree_index works on integers, float and double");
+
+public:
+    static constexpr std::size_t node_keys = 64 / sizeof(T);
+
+    //Complexity:
+    //      Runtime:
+    //          O(n)
+    //      Space:
+    //          n + O(n / node_keys) keys
+    template <ForwardIterator I>
+        requires(Readable<I> && ValueType<I> == T)
+    s_tree_index(I f, I l) : n_(std::size_t(std::distance(f, l))) {
+        //precondition: readable_bounded_range(f, l) && sorted(f, l) && no NaN in [f, l)
+        constexpr std::size_t B = node_keys;
+        std::vector<std::size_t> blocks(1, (std::max)(std::size_t(1), (n_ + B - 1) / B));
+        while (blocks.back() > 1) blocks.push_back((blocks.back() + B) / (B + 1));
+        layers_ = blocks.size();
+
+        // Root first, leaves last.
+        offsets_.resize(layers_);
+        std::size_t total = 0;
+        for (std::size_t h = 0; h != layers_; ++h) {
+            offsets_[h] = total;
+            total += blocks[layers_ - 1 - h] * B;
+        }
+        keys_.assign(total, padding());
+
+        T* const leaves = keys_.data() + offsets_[layers_ - 1];
+        for (std::size_t i = 0; i != n_; ++i, ++f) leaves[i] = *f;
+
+        // Key j of the node k of layer h: the first key of its child j + 1,
+        // that is of the leftmost leaf below it.
+        for (std::size_t h = 0; h + 1 != layers_; ++h) {
+            std::size_t span = 1;       // leaves below a node of layer h + 1
+            for (std::size_t g = h + 2; g != layers_; ++g) span *= B + 1;
+            for (std::size_t k = 0; k != blocks[layers_ - 1 - h]; ++k) {
+                for (std::size_t j = 0; j != B; ++j) {
+                    std::size_t const leaf = (k * (B + 1) + j + 1) * span;
+                    if (leaf * B < n_) keys_[offsets_[h] + k * B + j] = leaves[leaf * B];
+                }
+            }
+        }
+    }
+
+    std::size_t size() const { return n_; }
+
+    //Complexity:
+    //      Runtime:
+    //          ceil(log_(node_keys + 1)(n / node_keys)) + 1 nodes
+    //      Space:
+    //          O(1)
+    std::size_t lower_bound(T x) const {
+        //precondition: x is not NaN
+        return search<detail::compare_kind::less>(x);
+    }
+
+    std::size_t upper_bound(T x) const {
+        //precondition: x is not NaN
+        // The padding keys would count as not above x.
+        if ( ! (x < padding())) return n_;
+        return search<detail::compare_kind::greater>(x);
+    }
+
+    // Scalar: a node costs node_keys applications of p.
+    template <UnaryPredicate P>
+        requires(Domain<P> == T)
+    std::size_t partition_point(P p) const {
+        //precondition: p(y) implies p(z) for every y < z
+        // Then p holds on the padding keys too, unless it fails on the
+        // largest key.
+        if (n_ == 0 || ! p(keys_[offsets_[layers_ - 1] + n_ - 1])) return n_;
+        auto const count = [&p](T const* node, T) {
+            std::size_t res = 0;
+            for (std::size_t i = 0; i != node_keys; ++i) res += std::size_t( ! p(node[i]));
+            return res;
+        };
+        std::size_t const res = detail::s_tree_descend<detail::compare_kind::less>(keys_.data(), offsets_.data(), layers_, T(), count);
+        return res < n_ ? res : n_;
+    }
+
+private:
+    // Greater than every key but the maximum, and than every query.
+    static constexpr T padding() {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    }
+
+    template <detail::compare_kind K>
+    std::size_t search(T x) const {
+        T const* const keys = keys_.data();
+        std::size_t const* const offsets = offsets_.data();
+        std::size_t res;
+#if defined(TAO_ALGORITHM_SIMD_X86)
+        switch (simd_isa_level()) {
+            case simd_isa::avx512: res = detail::s_tree_descend_avx512<K>(keys, offsets, layers_, x); break;
+            case simd_isa::avx2: res = detail::s_tree_descend_avx2<K>(keys, offsets, layers_, x); break;
+            case simd_isa::sse2:
+                if constexpr (sizeof(T) < 8 || std::is_floating_point<T>::value) {
+                    res = detail::s_tree_descend_sse2<K>(keys, offsets, layers_, x);
+                    break;
+                }
+                // fall through
+            default:
+                res = detail::s_tree_descend<K>(keys, offsets, layers_, x, detail::node_count_scalar<K, T>);
+                break;
+        }
+#else
+        res = detail::s_tree_descend<K>(keys, offsets, layers_, x, detail::node_count_scalar<K, T>);
+#endif
+        return res < n_ ? res : n_;
+    }
+
+    std::size_t n_;
+    std::size_t layers_;
+    std::vector<std::size_t> offsets_;      // first key of every layer, root first
+    std::vector<T, detail::cache_aligned_allocator<T>> keys_;
+};
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_PARTITION_STATIC_INDEX_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("[static_index] testing eytzinger_rank against an in-order traversal") {
+    using namespace tao::algorithm;
+
+    for (std::size_t n = 1; n != 300; ++n) {
+        std::vector<std::size_t> order;
+        std::vector<std::size_t> stack;
+        std::size_t k = 1;
+        while (k <= n || ! stack.empty()) {
+            for (; k <= n; k *= 2) stack.push_back(k);
+            k = stack.back();
+            stack.pop_back();
+            order.push_back(k);
+            k = 2 * k + 1;
+        }
+        for (std::size_t r = 0; r != n; ++r) CHECK(detail::eytzinger_rank(order[r], n) == r);
+    }
+}
+
+TEST_CASE("[static_index] testing eytzinger_index and s_tree_index against std::lower_bound and std::upper_bound") {
+    using namespace tao::algorithm;
+
+    auto check = [](auto zero, std::size_t n, int spread) {
+        using T = decltype(zero);
+        std::mt19937 gen{unsigned(n)};
+        std::vector<T> v(n);
+        for (auto& x : v) x = T(int(gen() % unsigned(2 * spread + 1)) - spread);
+        if (std::is_unsigned<T>::value) for (auto& x : v) x = T(x + T(spread));
+        std::sort(v.begin(), v.end());
+
+        eytzinger_index<T> const e(v.begin(), v.end());
+        s_tree_index<T> const s(v.begin(), v.end());
+        CHECK(e.size() == n);
+        CHECK(s.size() == n);
+
+        std::vector<T> queries = {std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max()};
+        int const step = spread / 100 + 1;
+        for (int q = -spread - 2; q <= spread + 2; q += step) queries.push_back(T(q));
+        if (std::is_unsigned<T>::value) for (int q = 0; q <= 2 * spread + 2; q += step) queries.push_back(T(q));
+        for (std::size_t i = 0; i < n; i += n / 50 + 1) queries.push_back(v[i]);
+        for (T x : queries) {
+            auto const lower = std::size_t(std::lower_bound(v.begin(), v.end(), x) - v.begin());
+            auto const upper = std::size_t(std::upper_bound(v.begin(), v.end(), x) - v.begin());
+            CHECK(e.lower_bound(x) == lower);
+            CHECK(e.upper_bound(x) == upper);
+            CHECK(e.partition_point([&](T y) { return ! (y < x); }) == lower);
+            CHECK(s.lower_bound(x) == lower);
+            CHECK(s.upper_bound(x) == upper);
+            CHECK(s.partition_point([&](T y) { return ! (y < x); }) == lower);
+            CHECK(s.partition_point([&](T y) { return x < y; }) == upper);
+        }
+    };
+
+    for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+        set_simd_isa_limit(isa);
+        for (std::size_t n : {0, 1, 2, 3, 15, 16, 17, 100, 272, 273, 1000, 4913, 5000}) {
+            check(std::int32_t(), n, 50);
+            check(std::int32_t(), n, 1000000);
+            check(std::uint8_t(), n, 100);
+            check(std::int16_t(), n, 300);
+            check(std::uint64_t(), n, 1000);
+            check(std::int64_t(), n, 1000);
+            check(float(), n, 500);
+            check(double(), n, 500);
+        }
+    }
+    set_simd_isa_limit(simd_isa::avx512);
+}
+
+TEST_CASE("[static_index] testing eytzinger_index with 12 and 24-byte keys") {
+    using namespace tao::algorithm;
+
+    CHECK(eytzinger_index<std::int32_t>::prefetch_stride == 16);
+    CHECK(eytzinger_index<std::int64_t>::prefetch_stride == 8);
+
+    auto check = [](auto key) {
+        using K = decltype(key);
+        auto const less = [](K const& a, K const& b) { return a[0] < b[0]; };
+        CHECK(eytzinger_index<K, decltype(less)>::prefetch_stride == (sizeof(K) == 12 ? 8 : 4));
+
+        std::mt19937 gen(48);
+        for (std::size_t n : {0, 1, 5, 6, 7, 100, 1000, 5000}) {
+            std::vector<K> v(n);
+            for (auto& k : v) k[0] = std::int32_t(gen() % 3000);
+            std::sort(v.begin(), v.end(), less);
+            eytzinger_index<K, decltype(less)> const e(v.begin(), v.end(), less);
+            for (std::int32_t q = -1; q <= 3001; q += 7) {
+                K y{};
+                y[0] = q;
+                CHECK(e.lower_bound(y) == std::size_t(std::lower_bound(v.begin(), v.end(), y, less) - v.begin()));
+                CHECK(e.upper_bound(y) == std::size_t(std::upper_bound(v.begin(), v.end(), y, less) - v.begin()));
+            }
+        }
+    };
+    check(std::array<std::int32_t, 3>{});
+    check(std::array<std::int32_t, 6>{});
+}
+
+TEST_CASE("[static_index] testing eytzinger_index with strings and a descending order") {
+    using namespace tao::algorithm;
+
+    std::vector<std::string> v;
+    for (int i = 0; i != 500; ++i) v.push_back(std::to_string(i % 170));
+    std::sort(v.begin(), v.end(), std::greater<>());
+    eytzinger_index<std::string, std::greater<>> const e(v.begin(), v.end());
+    for (int i = -5; i != 200; ++i) {
+        std::string const x = std::to_string(i);
+        CHECK(e.lower_bound(x) == std::size_t(std::lower_bound(v.begin(), v.end(), x, std::greater<>()) - v.begin()));
+        CHECK(e.upper_bound(x) == std::size_t(std::upper_bound(v.begin(), v.end(), x, std::greater<>()) - v.begin()));
+    }
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -10,11 +10,17 @@
 #define TAO_ALGORITHM_POWER_HPP_
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/integers.hpp>
 #include <tao/algorithm/type_attributes.hpp>
 
 namespace tao { namespace algorithm {
@@ -92,14 +98,501 @@ A power_group(A a, N n, Op op) {
     return power_monoid(a, n, op);
 }
 
+// ------------------------------------------------------------------------
+// Powers with a constant exponent
+// ------------------------------------------------------------------------
+// power<N>(a, op) evaluates an addition chain for N computed at compile
+// time: 1 = c0 < c1 < ... < cr = N, every ci = cj + ck with j, k < i.
+// Each step is one call to op, a^ci = op(a^cj, a^ck).
+// Exponents up to power_tree_limit use Knuth's power tree (optimal for
+// every exponent below 77, close to optimal beyond); larger ones use the
+// left to right sliding window method, with the window size that
+// minimizes the number of steps.
 
+constexpr std::size_t power_tree_limit = 1024;
+constexpr std::size_t addition_chain_capacity = 128;
 
+namespace detail {
 
+struct addition_chain_step {
+    std::uint8_t i;
+    std::uint8_t j;
+};
+
+struct addition_chain {
+    constexpr
+    std::uint8_t add(std::uint8_t i, std::uint8_t j) {
+        steps[size] = addition_chain_step{i, j};
+        ++size;
+        return std::uint8_t(size);      // c0 is a, so step s computes c[s + 1]
+    }
+
+    std::size_t size = 0;
+    std::array<addition_chain_step, addition_chain_capacity> steps{};
+};
+
+// parent[m] is the parent of m in the power tree, the path from the root
+// to m is an addition chain for m. Level by level, the children of every
+// node n are n + c for every c on its path, if not already in the tree.
+constexpr
+std::array<std::uint16_t, power_tree_limit + 1> make_power_tree() {
+    std::array<std::uint16_t, power_tree_limit + 1> parent{};
+    std::array<std::uint16_t, power_tree_limit> order{};
+    std::size_t head = 0;
+    std::size_t tail = 0;
+    order[tail++] = 1;
+    while (head < tail) {
+        std::uint16_t const n = order[head++];
+        std::array<std::uint16_t, 32> path{};
+        std::size_t length = 0;
+        for (std::uint16_t m = n; m != 0; m = parent[m]) path[length++] = m;
+        while (length != 0) {
+            std::size_t const c = n + path[--length];
+            if (c <= power_tree_limit && c != 1 && parent[c] == 0) {
+                parent[c] = n;
+                order[tail++] = std::uint16_t(c);
+            }
+        }
+    }
+    return parent;
+}
+
+constexpr
+addition_chain make_power_tree_chain(std::uint64_t n) {
+    auto const parent = make_power_tree();
+    std::array<std::uint16_t, 32> path{};
+    std::size_t length = 0;
+    for (std::uint64_t m = n; m != 0; m = parent[m]) path[length++] = std::uint16_t(m);
+
+    // path[length - 1] == 1 is c0.
+    addition_chain chain;
+    for (std::size_t s = length - 1; s-- > 0; ) {
+        std::uint16_t const d = path[s] - path[s + 1];
+        std::size_t k = length - 1;
+        while (path[k] != d) --k;
+        chain.add(std::uint8_t(length - 1 - (s + 1)), std::uint8_t(length - 1 - k));
+    }
+    return chain;
+}
+
+template <Integer N>
+constexpr
+int bit_length(N n) {
+    // precondition: n >= 0
+    int r = 0;
+    while (n != N(0)) {
+        n = half(n);
+        ++r;
+    }
+    return r;
+}
+
+// Left to right, windows of at most k bits ending in a one; a^w is
+// precomputed for every odd w < 2^k.
+constexpr
+addition_chain make_sliding_window_chain(std::uint64_t n, int k) {
+    int const bits = bit_length(n);
+
+    // odd[w / 2]: index of a^w.
+    addition_chain chain;
+    std::array<std::uint8_t, 32> odd{};
+    odd[0] = 0;
+    if (k > 1) {
+        std::uint8_t const square = chain.add(0, 0);
+        for (int w = 1; w < (1 << (k - 1)); ++w) odd[w] = chain.add(odd[w - 1], square);
+    }
+
+    bool first = true;
+    std::uint8_t r = 0;
+    int i = bits - 1;
+    while (i >= 0) {
+        if (((n >> i) & 1) == 0) {
+            r = chain.add(r, r);
+            --i;
+            continue;
+        }
+        // Longest window n[i..j] of at most k bits ending in a one.
+        int j = i - k + 1 < 0 ? 0 : i - k + 1;
+        while (((n >> j) & 1) == 0) ++j;
+        std::uint64_t const w = (n >> j) & ((std::uint64_t(1) << (i - j + 1)) - 1);
+        if (first) {
+            r = odd[w / 2];
+            first = false;
+        } else {
+            for (int s = j; s <= i; ++s) r = chain.add(r, r);
+            r = chain.add(r, odd[w / 2]);
+        }
+        i = j - 1;
+    }
+    return chain;
+}
 
+constexpr
+addition_chain make_addition_chain(std::uint64_t n) {
+    //precondition: n > 0
+    if (n <= power_tree_limit) return make_power_tree_chain(n);
+    addition_chain best = make_sliding_window_chain(n, 1);
+    for (int k = 2; k <= 6; ++k) {
+        addition_chain const chain = make_sliding_window_chain(n, k);
+        if (chain.size < best.size) best = chain;
+    }
+    return best;
+}
 
+template <std::uint64_t N>
+inline constexpr addition_chain addition_chain_v = make_addition_chain(N);
 
+template <std::uint64_t N, Regular A, SemigroupOperation Op, std::size_t... S>
+A power_addition_chain(A const& a, Op op, std::index_sequence<S...>) {
+    constexpr auto const& chain = addition_chain_v<N>;
+    std::array<A, sizeof...(S) + 1> c;
+    c[0] = a;
+    ((c[S + 1] = op(c[chain.steps[S].i], c[chain.steps[S].j])), ...);
+    return c[sizeof...(S)];
+}
 
+} // namespace detail
+
+// Number of calls to op made by power<N>.
+template <std::uint64_t N>
+constexpr std::size_t power_operations = N == 0 ? 0 : detail::addition_chain_v<N>.size;
+
+//Complexity:
+//      Runtime:
+//          power_operations<|N|> calls to op (plus one to the inverse if N < 0)
+//      Space:
+//          O(power_operations<|N|>) values of A
+template <auto N, Regular A, SemigroupOperation Op>
+    requires(Domain<Op, A>)
+A power(A a, Op op) {
+    // precondition: N > 0 for a semigroup operation, N >= 0 for a monoid operation
+    static_assert(std::is_integral<decltype(N)>::value, "the exponent must be an integer");
+    if constexpr (std::is_signed<decltype(N)>::value && N < 0) {
+        return power<std::uint64_t(-(N + 1)) + 1>(inverse_operation(op)(a), op);
+    } else if constexpr (N == 0) {
+        return identity_element(op);
+    } else if constexpr (N == 1) {
+        return a;
+    } else {
+        constexpr std::uint64_t n = std::uint64_t(N);
+        return detail::power_addition_chain<n>(a, op,
+            std::make_index_sequence<detail::addition_chain_v<n>.size>{});
+    }
+}
+
+// ------------------------------------------------------------------------
+// Fixed base and simultaneous powers
+// ------------------------------------------------------------------------
+
+// Powers of a fixed a for many exponents. a^(d 2^(w i)) is precomputed for
+// every digit d in [1, 2^w) and every window i of the exponents, so a^n is
+// the product of one table entry per nonzero base 2^w digit of n: at most
+// bits / w - 1 calls to op per query and no squarings.
+template <Regular A, SemigroupOperation Op>
+    requires(Domain<Op, A>)
+struct fixed_base_power {
+    fixed_base_power(A const& a, Op op, int bits = 64, int window = 4)
+        : op(op)
+        , window(window)
+        , windows((bits + window - 1) / window)
+    {
+        // precondition: bits > 0 && 0 < window < bits(size_t)
+        std::size_t const digits = (std::size_t(1) << window) - 1;
+        table.reserve(std::size_t(windows) * digits);
+        A base = a;
+        for (int i = 0; i < windows; ++i) {
+            table.push_back(base);
+            for (std::size_t d = 1; d < digits; ++d) table.push_back(op(table.back(), base));
+            if (i + 1 < windows) base = op(table.back(), base);
+        }
+    }
+
+    //Complexity:
+    //      Runtime:
+    //          (number of nonzero base 2^window digits of n) - 1 calls to op
+    template <Integer N>
+    A operator()(N n) const {
+        // precondition: 0 < n < 2^bits
+        std::size_t const digits = (std::size_t(1) << window) - 1;
+        N const mask = N(digits);
+        // r starts as the entry of the lowest nonzero digit.
+        std::size_t i = 0;
+        while ((n & mask) == N(0)) {
+            n = n >> window;
+            ++i;
+        }
+        A r = table[i * digits + std::size_t(n & mask) - 1];
+        n = n >> window;
+        for (++i; n != N(0); ++i) {
+            std::size_t const d = std::size_t(n & mask);
+            if (d != 0) r = op(r, table[i * digits + d - 1]);
+            n = n >> window;
+        }
+        return r;
+    }
+
+    std::vector<A> table;       // table[i (2^w - 1) + d - 1] == a^(d 2^(w i))
+    Op op;
+    int window;
+    int windows;
+};
+
+//Complexity:
+//      Runtime:
+//          max(log n, log m) squarings and at most as many other calls to op
+//
+// Shamir's trick: a^n b^m with the squarings shared, one pass over the
+// bits of both exponents multiplying by a, b or the precomputed ab.
+template <Regular A, Integer N, SemigroupOperation Op>
+    requires(Domain<Op, A>)
+A power_product_semigroup(A a, N n, A b, N m, Op op) {
+    // precondition: n >= 0 && m >= 0 && (n > 0 || m > 0)
+    //               && op(a, b) == op(b, a) (a and b commute)
+    if (n == N(0)) return power_semigroup(b, m, op);
+    if (m == N(0)) return power_semigroup(a, n, op);
+    A const ab = op(a, b);
+    int const bits = (std::max)(detail::bit_length(n), detail::bit_length(m));
+    A r = odd(n >> (bits - 1)) ? (odd(m >> (bits - 1)) ? ab : a) : b;
+    for (int i = bits - 2; i >= 0; --i) {
+        r = op(r, r);
+        bool const bn = odd(n >> i);
+        bool const bm = odd(m >> i);
+        if (bn && bm) r = op(r, ab);
+        else if (bn) r = op(r, a);
+        else if (bm) r = op(r, b);
+    }
+    return r;
+}
+
+namespace detail {
+
+// Window size of the sliding window method for bits-bit exponents.
+constexpr
+int power_window(int bits) {
+    return bits <= 8 ? 1 : bits <= 24 ? 2 : bits <= 48 ? 3 : bits <= 160 ? 4 : 5;
+}
+
+} // namespace detail
+
+//Complexity:
+//      Runtime:
+//          log(max e) squarings, about log(e_i) / (w_i + 1) + 2^(w_i - 1)
+//          other calls to op per base, w_i = detail::power_window(log(e_i))
+//      Space:
+//          2^(w_i - 1) values of A per base
+//
+// Straus' method: the product of the powers of the bases in [f, l) to the
+// exponents starting at e, interleaving their sliding windows so that all
+// of them share one sequence of squarings. The windows of each exponent
+// are found with count_leading_zeros, one step per window.
+template <Iterator I, Iterator J, SemigroupOperation Op>
+    requires(Readable<I> && Readable<J> && Integer<ValueType<J>> && Domain<Op, ValueType<I>>)
+ValueType<I> multi_power_semigroup(I f, I l, J e, Op op) {
+    // precondition: readable_bounded_range(f, l) && readable_weak_range(e, l - f)
+    //               && 0 <= every exponent < 2^64 && some exponent > 0
+    //               && op is commutative on the powers of the bases
+    using A = ValueType<I>;
+    static_assert(sizeof(ValueType<J>) <= 8, "multi_power_semigroup works up to 64-bit exponents");
+
+    // window[64 t + j] == 1 + index in odd_table of the window of the t-th
+    // exponent ending at bit j, or 0.
+    std::vector<A> odd_table;
+    std::vector<std::uint32_t> window;
+    odd_table.reserve(64);          // four 64-bit exponents without reallocating
+    window.reserve(4 * 64);
+    int bits = 0;
+    while (f != l) {
+        auto u = std::uint64_t(*e);
+        if (u != 0) {
+            int const length = 64 - count_leading_zeros(u);
+            int const w = detail::power_window(length);
+            auto const offset = std::uint32_t(odd_table.size());
+            odd_table.push_back(*f);
+            if (w > 1) {
+                A const square = op(odd_table.back(), odd_table.back());
+                for (int j = 1; j < (1 << (w - 1)); ++j) odd_table.push_back(op(odd_table.back(), square));
+            }
+            std::size_t const row = window.size();
+            window.resize(row + 64, 0);
+            while (u != 0) {
+                int const top = 63 - count_leading_zeros(u);
+                int const low = (std::max)(top - w + 1, 0);
+                std::uint64_t const d = u >> low;
+                int const zeros = count_trailing_zeros(d);
+                window[row + std::size_t(low + zeros)] = offset + std::uint32_t(d >> (zeros + 1)) + 1;
+                u &= (std::uint64_t(1) << low) - 1;
+            }
+            bits = (std::max)(bits, length);
+        }
+        ++f;
+        ++e;
+    }
+
+    // r starts as the first window ending at the highest bit that ends any,
+    // the squarings above it would be of nothing.
+    int i = bits - 1;
+    std::size_t row = std::size_t(i);
+    while (window[row] == 0) {
+        row += 64;
+        if (row >= window.size()) row = std::size_t(--i);
+    }
+    A r = odd_table[window[row] - 1];
+    for (row += 64; row < window.size(); row += 64) {
+        if (window[row] != 0) r = op(r, odd_table[window[row] - 1]);
+    }
+    for (--i; i >= 0; --i) {
+        r = op(r, r);
+        for (row = std::size_t(i); row < window.size(); row += 64) {
+            std::uint32_t const x = window[row];
+            if (x != 0) r = op(r, odd_table[x - 1]);
+        }
+    }
+    return r;
+}
 
 }} /*tao::algorithm*/
 
 #endif /*TAO_ALGORITHM_POWER_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <tao/benchmark/instrumented.hpp>
+
+TEST_CASE("[power] testing power<N> against power_semigroup") {
+    using namespace tao::algorithm;
+
+    // Shortest addition chain lengths l(n), n = 1..32.
+    constexpr std::size_t optimal[] = {0, 1, 2, 2, 3, 3, 4, 3, 4, 4, 5, 4, 5, 5, 5, 4,
+                                       5, 5, 6, 5, 6, 6, 6, 5, 6, 6, 6, 6, 7, 6, 7, 5};
+    auto check_optimal = [&](auto n) {
+        CHECK(power_operations<decltype(n)::value> == optimal[decltype(n)::value - 1]);
+    };
+    check_optimal(std::integral_constant<std::uint64_t, 1>{});
+    check_optimal(std::integral_constant<std::uint64_t, 5>{});
+    check_optimal(std::integral_constant<std::uint64_t, 7>{});
+    check_optimal(std::integral_constant<std::uint64_t, 15>{});
+    check_optimal(std::integral_constant<std::uint64_t, 19>{});
+    check_optimal(std::integral_constant<std::uint64_t, 23>{});
+    check_optimal(std::integral_constant<std::uint64_t, 29>{});
+    check_optimal(std::integral_constant<std::uint64_t, 31>{});
+    check_optimal(std::integral_constant<std::uint64_t, 32>{});
+
+    std::uint64_t const m = 1000000007;
+    auto mult = [m](std::uint64_t a, std::uint64_t b) { return a * b % m; };
+    auto check = [&](auto n) {
+        constexpr std::uint64_t N = decltype(n)::value;
+        for (std::uint64_t a : {2, 3, 12345}) {
+            CHECK(power<N>(a, mult) == power_semigroup(a, N, mult));
+        }
+    };
+    check(std::integral_constant<std::uint64_t, 2>{});
+    check(std::integral_constant<std::uint64_t, 5>{});
+    check(std::integral_constant<std::uint64_t, 15>{});
+    check(std::integral_constant<std::uint64_t, 77>{});
+    check(std::integral_constant<std::uint64_t, 1000>{});
+    check(std::integral_constant<std::uint64_t, 1024>{});
+    check(std::integral_constant<std::uint64_t, 1025>{});
+    check(std::integral_constant<std::uint64_t, 65537>{});
+    check(std::integral_constant<std::uint64_t, 1000000005>{});
+    check(std::integral_constant<std::uint64_t, 0xffffffffffffffffull>{});
+
+    CHECK(power<0>(7, std::multiplies<int>()) == 1);
+    CHECK(power<1>(7, std::plus<int>()) == 7);
+    CHECK(power<-3>(2.0, std::multiplies<double>()) == 0.125);
+    CHECK(power<-5>(3, std::plus<int>()) == -15);
+}
+
+TEST_CASE("[power] testing power<N> operation counts with instrumented") {
+    using namespace tao::algorithm;
+    using T = instrumented<std::uint64_t>;
+
+    // Every call to op constructs one value.
+    auto op = [](T const& a, T const& b) { return T(a.value * b.value); };
+    auto count = [](auto f) {
+        instrumented_base::initialize(0);
+        f();
+        return instrumented_base::counts[instrumented_base::construction];
+    };
+
+    CHECK(count([&] { power<15>(T(3), op); }) == 1 + 5);
+    CHECK(count([&] { power_semigroup(T(3), 15, op); }) == 1 + 6);
+    CHECK(count([&] { power<5>(T(3), op); }) == 1 + 3);
+    CHECK(count([&] { power<63>(T(3), op); }) == 1 + 8);
+    CHECK(count([&] { power_semigroup(T(3), 63, op); }) == 1 + 10);
+
+    constexpr std::uint64_t big = 0xfedcba9876543210ull;
+    double const chain = count([&] { power<big>(T(3), op); });
+    double const binary = count([&] { power_semigroup(T(3), big, op); });
+    CHECK(chain == 1 + power_operations<big>);
+    CHECK(chain < binary);
+    CHECK(power<big>(T(3), op).value == power_semigroup(T(3), big, op).value);
+}
+
+TEST_CASE("[power] testing fixed_base_power, power_product_semigroup and multi_power_semigroup") {
+    using namespace tao::algorithm;
+
+    std::uint64_t const m = 1000000007;
+    auto mult = [m](std::uint64_t a, std::uint64_t b) { return a * b % m; };
+    auto pw = [&](std::uint64_t a, std::uint64_t n) { return n == 0 ? 1 : power_semigroup(a, n, mult); };
+
+    fixed_base_power<std::uint64_t, decltype(mult)> p3(3, mult);
+    fixed_base_power<std::uint64_t, decltype(mult)> p5(5, mult, 20, 3);
+    for (std::uint64_t n : {1ull, 2ull, 15ull, 16ull, 17ull, 1000000006ull, 0xffffffffffffffffull, 0x8000000000000000ull}) {
+        CHECK(p3(n) == power_semigroup(std::uint64_t(3), n, mult));
+    }
+    for (std::uint64_t n = 1; n < (1u << 20); n += 997) {
+        CHECK(p5(n) == power_semigroup(std::uint64_t(5), n, mult));
+    }
+
+    for (std::uint64_t n : {0ull, 1ull, 6ull, 123456789ull, 0xfffffffffffull}) {
+        for (std::uint64_t k : {1ull, 2ull, 7ull, 987654321987ull}) {
+            std::uint64_t const expected = mult(pw(7, n),
+                                                pw(11, k));
+            CHECK(power_product_semigroup(std::uint64_t(7), n, std::uint64_t(11), k, mult) == expected);
+            CHECK(power_product_semigroup(std::uint64_t(11), k, std::uint64_t(7), n, mult) == expected);
+        }
+    }
+
+    std::vector<std::uint64_t> const bases = {2, 3, 5, 7, 11, 13};
+    std::vector<std::uint64_t> const exponents = {0, 1, 12345, 0xffffffffffffffffull, 64, 999999999999ull};
+    for (std::size_t k = 2; k <= bases.size(); ++k) {
+        std::uint64_t expected = 1;
+        for (std::size_t i = 0; i < k; ++i) expected = mult(expected, pw(bases[i], exponents[i]));
+        CHECK(multi_power_semigroup(bases.begin(), bases.begin() + k, exponents.begin(), mult) == expected);
+    }
+}
+
+TEST_CASE("[power] testing fixed_base_power and simultaneous power operation counts") {
+    using namespace tao::algorithm;
+    using T = instrumented<std::uint64_t>;
+
+    std::uint64_t const m = 1000000007;
+    auto op = [m](T const& a, T const& b) { return T(a.value * b.value % m); };
+    auto count = [](auto f) {
+        instrumented_base::initialize(0);
+        f();
+        return instrumented_base::counts[instrumented_base::construction];
+    };
+
+    std::uint64_t const n = 0xfedcba9876543210ull;
+    std::uint64_t const k = 0x0123456789abcdefull;
+    fixed_base_power<T, decltype(op)> p(T(3), op);
+    // 16 digits, one of them zero: 14 products and no squarings.
+    CHECK(count([&] { p(n); }) == 14);
+    CHECK(count([&] { power_semigroup(T(3), n, op); }) > 90);
+
+    double const separate = count([&] { op(power_semigroup(T(3), n, op), power_semigroup(T(5), k, op)); });
+    double const shamir = count([&] { power_product_semigroup(T(3), n, T(5), k, op); });
+    std::vector<T> const bases = {T(3), T(5)};
+    std::vector<std::uint64_t> const exponents = {n, k};
+    double const straus = count([&] { multi_power_semigroup(bases.begin(), bases.end(), exponents.begin(), op); });
+    CHECK(shamir < separate);
+    CHECK(straus < shamir);
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
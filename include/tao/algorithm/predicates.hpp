@@ -26,4 +26,63 @@ struct predicate_negator {
     }
 };
 
+namespace tao { namespace algorithm {
+
+// Comparisons with fixed values. Besides being ordinary predicates, they
+// are recognized by the vectorized find_if and count_if on contiguous
+// ranges of arithmetic values.
+
+template <Regular T>
+struct equal_to_value {
+    T x;
+
+    explicit
+    equal_to_value(T x) : x(x) {}
+
+    bool operator()(T const& y) const { return y == x; }
+};
+
+template <Regular T>
+struct not_equal_to_value {
+    T x;
+
+    explicit
+    not_equal_to_value(T x) : x(x) {}
+
+    bool operator()(T const& y) const { return y != x; }
+};
+
+template <TotallyOrdered T>
+struct less_than_value {
+    T x;
+
+    explicit
+    less_than_value(T x) : x(x) {}
+
+    bool operator()(T const& y) const { return y < x; }
+};
+
+template <TotallyOrdered T>
+struct greater_than_value {
+    T x;
+
+    explicit
+    greater_than_value(T x) : x(x) {}
+
+    bool operator()(T const& y) const { return x < y; }
+};
+
+// a <= y < b
+template <TotallyOrdered T>
+struct within_range {
+    T a;
+    T b;
+
+    within_range(T a, T b) : a(a), b(b) {}
+
+    bool operator()(T const& y) const { return ! (y < a) && y < b; }
+};
+
+}} /*tao::algorithm*/
+
 #endif //TAO_ALGORITHM_PREDICATES_HPP_
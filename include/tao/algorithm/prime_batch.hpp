@@ -0,0 +1,484 @@
+//! \file tao/algorithm/prime_batch.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_PRIME_BATCH_HPP_
+#define TAO_ALGORITHM_PRIME_BATCH_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/integers.hpp>
+#include <tao/algorithm/primes.hpp>
+#include <tao/algorithm/simd.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao { namespace algorithm {
+
+// ------------------------------------------------------------------------
+// Batch primality test
+// ------------------------------------------------------------------------
+// Candidates are processed in blocks:
+//  1. Trial division by the primes up to 41 is three table lookups: bitmasks
+//     of the residues coprime to 2*3*5*7*11*13, 17*19*23*29 and 31*37*41.
+//  2. The survivors below 2^32 run the strong probable prime tests to the
+//     bases {2, 7, 61} in Montgomery form across SIMD lanes (8 lanes with
+//     AVX-512, 4 with AVX2). The survivors below 2^52 use AVX-512 IFMA
+//     52-bit multiplies with the bases 2..23 (no pseudoprimes below
+//     3.8 * 10^18). The remaining ones, or all of them without SIMD, run
+//     the same tests one at a time with scalar Montgomery products (the
+//     primes up to 37 as bases above 2^52, as prime() does).
+
+namespace detail {
+
+// Bitmask of the residues modulo p1 * p2 * ... coprime to all of them.
+// The modulus is a constant, n % modulus is a multiplication.
+template <std::uint32_t... Primes>
+struct prime_sieve_mask {
+    static constexpr std::uint32_t modulus = (Primes * ...);
+
+    prime_sieve_mask() : bits((modulus + 63) / 64, 0) {
+        for (std::uint32_t r = 0; r < modulus; ++r) {
+            if (((r % Primes != 0) && ...)) bits[r / 64] |= std::uint64_t(1) << (r % 64);
+        }
+    }
+
+    bool coprime(std::uint64_t n) const {
+        std::uint32_t const r = std::uint32_t(n % modulus);
+        return (bits[r / 64] >> (r % 64)) & 1;
+    }
+
+    std::vector<std::uint64_t> bits;
+};
+
+struct prime_sieve_masks_t {
+    bool coprime(std::uint64_t n) const {
+        return m1.coprime(n) && m2.coprime(n) && m3.coprime(n);
+    }
+
+    prime_sieve_mask<2, 3, 5, 7, 11, 13> m1;
+    prime_sieve_mask<17, 19, 23, 29> m2;
+    prime_sieve_mask<31, 37, 41> m3;
+};
+
+inline
+prime_sieve_masks_t const& prime_sieve_masks() {
+    static prime_sieve_masks_t const masks;
+    return masks;
+}
+
+// Smallest n not settled by the masks alone: 43^2.
+constexpr std::uint64_t prime_batch_trial_limit = 43 * 43;
+
+// Strong probable prime test of every n[i] (odd, n[i] > 1) to the given
+// bases, scalar Montgomery arithmetic. res[i] = 1 if all of them pass.
+template <typename U, std::size_t Bases>
+void miller_rabin_batch_scalar(U const* n, std::size_t count, std::uint8_t* res,
+                               std::uint8_t const (&bases)[Bases]) {
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const q_k = miller_rabin_q_k(n[i]);
+        montgomery_multiply<U> op(n[i]);
+        bool p = true;
+        for (auto w : bases) {
+            if ( ! miller_rabin_test(op, q_k.first, q_k.second, U(w))) {
+                p = false;
+                break;
+            }
+        }
+        res[i] = p;
+    }
+}
+
+inline constexpr std::uint8_t miller_rabin_bases32[] = {2, 7, 61};
+inline constexpr std::uint8_t miller_rabin_bases52[] = {2, 3, 5, 7, 11, 13, 17, 19, 23};
+inline constexpr std::uint8_t miller_rabin_bases64[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+// Per lane constants of Lanes Montgomery moduli: n^-1 mod R, R mod n and
+// n - 1 = 2^k q, with R = 2^Bits. The last lanes are padded with n = 3.
+// R^2 mod n is computed by the kernels, doubling R mod n Bits times across
+// the lanes, instead of a double width division per lane.
+template <int Bits, std::size_t Lanes>
+struct montgomery_lanes {
+    template <typename U>
+    montgomery_lanes(U const* np, std::size_t count) {
+        //precondition: count <= Lanes && odd(np[i]) && np[i] > 2
+        for (std::size_t j = 0; j < Lanes; ++j) {
+            std::uint64_t const x = j < count ? std::uint64_t(np[j]) : 3;
+            n[j] = x;
+            if (Bits == 32) {
+                inverse[j] = montgomery_multiply<std::uint32_t>::modular_inverse(std::uint32_t(x));
+                one[j] = std::uint32_t(0 - std::uint32_t(x)) % std::uint32_t(x);
+            } else {
+                inverse[j] = montgomery_multiply<std::uint64_t>::modular_inverse(x) & ((std::uint64_t(1) << Bits) - 1);
+                one[j] = (std::uint64_t(1) << Bits) % x;
+            }
+            k[j] = std::uint64_t(count_trailing_zeros(x - 1));
+            q[j] = (x - 1) >> k[j];
+            max_q = q[j] > max_q ? q[j] : max_q;
+            max_k = k[j] > max_k ? k[j] : max_k;
+        }
+    }
+
+    int q_bits() const {
+        //precondition: max_q > 0, which holds since every n is odd and
+        //              greater than 2, so every q >= 1
+        return 64 - count_leading_zeros(max_q);
+    }
+
+    alignas(64) std::uint64_t n[Lanes];
+    alignas(64) std::uint64_t inverse[Lanes];
+    alignas(64) std::uint64_t one[Lanes];
+    alignas(64) std::uint64_t q[Lanes];
+    alignas(64) std::uint64_t k[Lanes];
+    std::uint64_t max_q = 0;
+    std::uint64_t max_k = 0;
+};
+
+#if defined(TAO_ALGORITHM_SIMD_X86)
+
+// The kernels work on G independent vectors at a time: a Montgomery product
+// is a chain of three dependent multiplications, a single vector would leave
+// the multipliers idle. The powers are computed right to left, so the
+// squarings of the base and the products into the result are independent
+// too. Every lane computes all the steps of the longest exponent.
+
+// 32-bit moduli, one per 64-bit lane. _mm*_mul_epu32 multiplies the low
+// halves of the lanes into 64-bit products.
+
+TAO_ALGORITHM_TARGET_AVX2 TAO_ALGORITHM_ALWAYS_INLINE
+__m256i montgomery_multiply_avx2(__m256i a, __m256i b, __m256i n, __m256i inv) {
+    __m256i t = _mm256_mul_epu32(a, b);
+    __m256i m = _mm256_mul_epu32(t, inv);               // low half is t * n^-1 mod 2^32
+    __m256i mn = _mm256_mul_epu32(m, n);
+    __m256i th = _mm256_srli_epi64(t, 32);
+    __m256i mh = _mm256_srli_epi64(mn, 32);
+    __m256i r = _mm256_sub_epi64(th, mh);
+    __m256i borrow = _mm256_cmpgt_epi64(mh, th);         // values below 2^32
+    return _mm256_add_epi64(r, _mm256_and_si256(borrow, n));
+}
+
+template <std::size_t G>
+TAO_ALGORITHM_TARGET_AVX2
+void miller_rabin_batch_avx2(std::uint32_t const* np, std::size_t count, std::uint8_t* res) {
+    constexpr std::size_t lanes = 4;
+    for (std::size_t i = 0; i < count; i += lanes * G) {
+        std::size_t const m = (std::min)(count - i, lanes * G);
+        montgomery_lanes<32, lanes * G> c(np + i, m);
+        __m256i n[G], inv[G], one[G], minus_one[G], r2[G], pass[G];
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t g = 0; g < G; ++g) {
+            n[g] = _mm256_load_si256((__m256i const*)(c.n + g * lanes));
+            inv[g] = _mm256_load_si256((__m256i const*)(c.inverse + g * lanes));
+            one[g] = _mm256_load_si256((__m256i const*)(c.one + g * lanes));
+            minus_one[g] = _mm256_sub_epi64(n[g], one[g]);
+            r2[g] = one[g];
+            for (int j = 0; j < 32; ++j) {
+                r2[g] = _mm256_add_epi64(r2[g], r2[g]);
+                r2[g] = _mm256_sub_epi64(r2[g], _mm256_andnot_si256(_mm256_cmpgt_epi64(n[g], r2[g]), n[g]));
+            }
+            pass[g] = _mm256_set1_epi64x(-1);
+        }
+        int const qbits = c.q_bits();
+
+        for (auto b : miller_rabin_bases32) {
+            __m256i x[G], y[G];
+            TAO_ALGORITHM_UNROLL
+            for (std::size_t g = 0; g < G; ++g) {
+                y[g] = montgomery_multiply_avx2(_mm256_set1_epi64x(b), r2[g], n[g], inv[g]);
+                x[g] = one[g];
+            }
+            for (int bit = 0; bit < qbits; ++bit) {
+                __m256i const mask = _mm256_set1_epi64x(std::int64_t(1) << bit);
+                TAO_ALGORITHM_UNROLL
+                for (std::size_t g = 0; g < G; ++g) {
+                    __m256i const q = _mm256_load_si256((__m256i const*)(c.q + g * lanes));
+                    __m256i const set = _mm256_cmpeq_epi64(_mm256_and_si256(q, mask), mask);
+                    x[g] = _mm256_blendv_epi8(x[g], montgomery_multiply_avx2(x[g], y[g], n[g], inv[g]), set);
+                    y[g] = montgomery_multiply_avx2(y[g], y[g], n[g], inv[g]);
+                }
+            }
+            __m256i any = _mm256_setzero_si256();
+            TAO_ALGORITHM_UNROLL
+            for (std::size_t g = 0; g < G; ++g) {
+                __m256i const k = _mm256_load_si256((__m256i const*)(c.k + g * lanes));
+                __m256i ok = _mm256_or_si256(_mm256_cmpeq_epi64(x[g], one[g]), _mm256_cmpeq_epi64(x[g], minus_one[g]));
+                for (std::uint64_t s = 1; s < c.max_k; ++s) {
+                    x[g] = montgomery_multiply_avx2(x[g], x[g], n[g], inv[g]);
+                    __m256i const in = _mm256_cmpgt_epi64(k, _mm256_set1_epi64x(std::int64_t(s)));
+                    ok = _mm256_or_si256(ok, _mm256_and_si256(in, _mm256_cmpeq_epi64(x[g], minus_one[g])));
+                }
+                pass[g] = _mm256_and_si256(pass[g], ok);
+                any = _mm256_or_si256(any, pass[g]);
+            }
+            if (_mm256_testz_si256(any, any)) break;
+        }
+        for (std::size_t j = 0; j < m; ++j) {
+            int const mask = _mm256_movemask_pd(_mm256_castsi256_pd(pass[j / lanes]));
+            res[i + j] = (mask >> (j % lanes)) & 1;
+        }
+    }
+}
+
+// The zero-masking forms with a full mask: GCC 12 reports the undefined
+// pass-through of the plain _mm512_mul_epu32 and _mm512_srli_epi64 as
+// maybe-uninitialized.
+TAO_ALGORITHM_TARGET_AVX512 TAO_ALGORITHM_ALWAYS_INLINE
+__m512i montgomery_multiply_avx512(__m512i a, __m512i b, __m512i n, __m512i inv) {
+    __m512i t = _mm512_maskz_mul_epu32(0xff, a, b);
+    __m512i m = _mm512_maskz_mul_epu32(0xff, t, inv);
+    __m512i mn = _mm512_maskz_mul_epu32(0xff, m, n);
+    __m512i th = _mm512_maskz_srli_epi64(0xff, t, 32);
+    __m512i mh = _mm512_maskz_srli_epi64(0xff, mn, 32);
+    __m512i r = _mm512_sub_epi64(th, mh);
+    return _mm512_mask_add_epi64(r, _mm512_cmplt_epu64_mask(th, mh), r, n);
+}
+
+// 52-bit moduli with AVX-512 IFMA, R = 2^52. madd52lo/hi give the low and
+// high 52 bits of the 104-bit product of the low 52 bits of the lanes.
+
+TAO_ALGORITHM_TARGET_AVX512_IFMA TAO_ALGORITHM_ALWAYS_INLINE
+__m512i montgomery_multiply_ifma(__m512i a, __m512i b, __m512i n, __m512i inv) {
+    __m512i const zero = _mm512_setzero_si512();
+    __m512i tl = _mm512_madd52lo_epu64(zero, a, b);
+    __m512i th = _mm512_madd52hi_epu64(zero, a, b);
+    __m512i m = _mm512_madd52lo_epu64(zero, tl, inv);   // tl * n^-1 mod 2^52
+    __m512i mh = _mm512_madd52hi_epu64(zero, m, n);
+    __m512i r = _mm512_sub_epi64(th, mh);
+    return _mm512_mask_add_epi64(r, _mm512_cmplt_epu64_mask(th, mh), r, n);
+}
+
+// The AVX-512 kernel, for 32-bit moduli (Multiply = montgomery_multiply_avx512)
+// and for 52-bit moduli (Multiply = montgomery_multiply_ifma). Defined
+// through a macro: every instantiation needs its own target attribute.
+#define TAO_ALGORITHM_MILLER_RABIN_BATCH_AVX512(name, target, U, Bits, multiply, bases)             \
+template <std::size_t G>                                                                            \
+target                                                                                              \
+void name(U const* np, std::size_t count, std::uint8_t* res) {                                      \
+    constexpr std::size_t lanes = 8;                                                                \
+    for (std::size_t i = 0; i < count; i += lanes * G) {                                            \
+        std::size_t const m = (std::min)(count - i, lanes * G);                                     \
+        montgomery_lanes<Bits, lanes * G> c(np + i, m);                                             \
+        __m512i n[G], inv[G], one[G], minus_one[G], r2[G];                                          \
+        __mmask8 pass[G];                                                                           \
+        TAO_ALGORITHM_UNROLL                                                                        \
+        for (std::size_t g = 0; g < G; ++g) {                                                       \
+            n[g] = _mm512_load_si512(c.n + g * lanes);                                              \
+            inv[g] = _mm512_load_si512(c.inverse + g * lanes);                                      \
+            one[g] = _mm512_load_si512(c.one + g * lanes);                                          \
+            minus_one[g] = _mm512_sub_epi64(n[g], one[g]);                                          \
+            r2[g] = one[g];                                                                         \
+            for (int j = 0; j < Bits; ++j) {                                                        \
+                r2[g] = _mm512_add_epi64(r2[g], r2[g]);                                             \
+                r2[g] = _mm512_mask_sub_epi64(r2[g], _mm512_cmpge_epu64_mask(r2[g], n[g]), r2[g], n[g]); \
+            }                                                                                       \
+            pass[g] = 0xff;                                                                         \
+        }                                                                                           \
+        int const qbits = c.q_bits();                                                               \
+                                                                                                    \
+        for (auto b : bases) {                                                                      \
+            __m512i x[G], y[G];                                                                     \
+            TAO_ALGORITHM_UNROLL                                                                    \
+            for (std::size_t g = 0; g < G; ++g) {                                                   \
+                y[g] = multiply(_mm512_set1_epi64(b), r2[g], n[g], inv[g]);                         \
+                x[g] = one[g];                                                                      \
+            }                                                                                       \
+            for (int bit = 0; bit < qbits; ++bit) {                                                 \
+                __m512i const mask = _mm512_set1_epi64(std::int64_t(1) << bit);                     \
+                TAO_ALGORITHM_UNROLL                                                                \
+                for (std::size_t g = 0; g < G; ++g) {                                               \
+                    __mmask8 const set = _mm512_test_epi64_mask(_mm512_load_si512(c.q + g * lanes), mask); \
+                    x[g] = _mm512_mask_mov_epi64(x[g], set, multiply(x[g], y[g], n[g], inv[g]));    \
+                    y[g] = multiply(y[g], y[g], n[g], inv[g]);                                      \
+                }                                                                                   \
+            }                                                                                       \
+            __mmask8 any = 0;                                                                       \
+            TAO_ALGORITHM_UNROLL                                                                    \
+            for (std::size_t g = 0; g < G; ++g) {                                                   \
+                __m512i const k = _mm512_load_si512(c.k + g * lanes);                               \
+                __mmask8 ok = _mm512_cmpeq_epu64_mask(x[g], one[g]) | _mm512_cmpeq_epu64_mask(x[g], minus_one[g]); \
+                for (std::uint64_t s = 1; s < c.max_k; ++s) {                                       \
+                    x[g] = multiply(x[g], x[g], n[g], inv[g]);                                      \
+                    __mmask8 const in = _mm512_cmpgt_epu64_mask(k, _mm512_set1_epi64(std::int64_t(s))); \
+                    ok |= in & _mm512_cmpeq_epu64_mask(x[g], minus_one[g]);                         \
+                }                                                                                   \
+                pass[g] &= ok;                                                                      \
+                any |= pass[g];                                                                     \
+            }                                                                                       \
+            if (any == 0) break;                                                                    \
+        }                                                                                           \
+        for (std::size_t j = 0; j < m; ++j) res[i + j] = (pass[j / lanes] >> (j % lanes)) & 1;      \
+    }                                                                                               \
+}
+
+TAO_ALGORITHM_MILLER_RABIN_BATCH_AVX512(miller_rabin_batch_avx512, TAO_ALGORITHM_TARGET_AVX512,
+                                        std::uint32_t, 32, montgomery_multiply_avx512, miller_rabin_bases32)
+TAO_ALGORITHM_MILLER_RABIN_BATCH_AVX512(miller_rabin_batch_ifma, TAO_ALGORITHM_TARGET_AVX512_IFMA,
+                                        std::uint64_t, 52, montgomery_multiply_ifma, miller_rabin_bases52)
+
+#undef TAO_ALGORITHM_MILLER_RABIN_BATCH_AVX512
+
+#endif /*TAO_ALGORITHM_SIMD_X86*/
+
+inline
+void miller_rabin_batch32(std::uint32_t const* n, std::size_t count, std::uint8_t* res) {
+#if defined(TAO_ALGORITHM_SIMD_X86)
+    switch (simd_isa_level()) {
+        case simd_isa::avx512: miller_rabin_batch_avx512<4>(n, count, res); return;
+        case simd_isa::avx2:   miller_rabin_batch_avx2<4>(n, count, res); return;
+        default: break;
+    }
+#endif
+    miller_rabin_batch_scalar(n, count, res, miller_rabin_bases32);
+}
+
+inline
+void miller_rabin_batch52(std::uint64_t const* n, std::size_t count, std::uint8_t* res) {
+#if defined(TAO_ALGORITHM_SIMD_X86)
+    if (simd_ifma_available()) {
+        miller_rabin_batch_ifma<4>(n, count, res);
+        return;
+    }
+#endif
+    miller_rabin_batch_scalar(n, count, res, miller_rabin_bases52);
+}
+
+constexpr std::size_t prime_batch_block = 256;
+
+// Tests a block of candidates (as unsigned, negative ones already false).
+inline
+void prime_batch_block_test(std::uint64_t const* n, std::uint8_t const* valid, std::size_t count, std::uint8_t* res) {
+    auto const& masks = prime_sieve_masks();
+
+    std::uint32_t n32[prime_batch_block];
+    std::uint64_t n52[prime_batch_block];
+    std::uint64_t n64[prime_batch_block];
+    std::uint16_t i32[prime_batch_block];
+    std::uint16_t i52[prime_batch_block];
+    std::uint16_t i64[prime_batch_block];
+    std::size_t c32 = 0;
+    std::size_t c52 = 0;
+    std::size_t c64 = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t const x = n[i];
+        res[i] = 0;
+        if ( ! valid[i]) continue;
+        if (x < prime_batch_trial_limit) {
+            res[i] = prime(x);
+            continue;
+        }
+        if ( ! masks.coprime(x)) continue;
+
+        if (x < (std::uint64_t(1) << 32)) {
+            n32[c32] = std::uint32_t(x);
+            i32[c32++] = std::uint16_t(i);
+        } else if (x < (std::uint64_t(1) << 52)) {
+            n52[c52] = x;
+            i52[c52++] = std::uint16_t(i);
+        } else {
+            n64[c64] = x;
+            i64[c64++] = std::uint16_t(i);
+        }
+    }
+
+    std::uint8_t r[prime_batch_block];
+    miller_rabin_batch32(n32, c32, r);
+    for (std::size_t j = 0; j < c32; ++j) res[i32[j]] = r[j];
+    miller_rabin_batch52(n52, c52, r);
+    for (std::size_t j = 0; j < c52; ++j) res[i52[j]] = r[j];
+    miller_rabin_batch_scalar(n64, c64, r, miller_rabin_bases64);
+    for (std::size_t j = 0; j < c64; ++j) res[i64[j]] = r[j];
+}
+
+} // namespace detail
+
+//Complexity:
+//      Runtime:
+//          O(n) table lookups, O(log m) Montgomery products per survivor m,
+//          several survivors per SIMD instruction
+//      Space:
+//          O(1)
+//
+// Writes prime(x) for every x of [f, l) to out, returns the final out.
+template <Iterator I, Iterator O>
+    requires(Readable<I> && Integer<ValueType<I>> && Writable<O>)
+O prime_batch(I f, I l, O out) {
+    //precondition: readable_bounded_range(f, l) && sizeof(ValueType<I>) <= 8
+    using T = ValueType<I>;
+    static_assert(sizeof(T) <= 8, "prime_batch works up to 64-bit integers");
+
+    constexpr std::size_t block = detail::prime_batch_block;
+    std::uint64_t n[block];
+    std::uint8_t valid[block];
+    std::uint8_t res[block];
+
+    while (f != l) {
+        std::size_t count = 0;
+        while (f != l && count < block) {
+            T const x = *f;
+            valid[count] = ! (x < T(0));
+            n[count] = valid[count] ? std::uint64_t(x) : 0;
+            ++count;
+            ++f;
+        }
+        detail::prime_batch_block_test(n, valid, count, res);
+        for (std::size_t i = 0; i < count; ++i) {
+            *out = bool(res[i]);
+            ++out;
+        }
+    }
+    return out;
+}
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_PRIME_BATCH_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <vector>
+
+TEST_CASE("[prime_batch] testing prime_batch against prime on every instruction set") {
+    using namespace tao::algorithm;
+
+    std::vector<std::uint64_t> v;
+    for (std::uint64_t x = 0; x < 20000; ++x) v.push_back(x);
+    for (std::uint64_t base : {1000000000ull, 4294967296ull - 5000, 4503599627370496ull - 5000,
+                               1000000000000000000ull, 18446744073709551615ull - 5000}) {
+        for (std::uint64_t x = base; x < base + 5000; ++x) v.push_back(x);
+    }
+    for (std::uint64_t x : {3215031751ull, 2152302898747ull, 3474749660383ull,
+                            341550071728321ull, 3825123056546413051ull, 4294967291ull,
+                            2305843009213693951ull, 1000000000000000003ull, 4503599627370449ull}) {
+        v.push_back(x);
+    }
+
+    std::vector<std::uint8_t> expected;
+    for (auto x : v) expected.push_back(prime(x));
+
+    for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+        set_simd_isa_limit(isa);
+        std::vector<std::uint8_t> res(v.size());
+        CHECK(prime_batch(v.begin(), v.end(), res.begin()) == res.end());
+        CHECK(res == expected);
+    }
+    set_simd_isa_limit(simd_isa::avx512);
+
+    std::vector<int> w = {-7, -1, 0, 1, 2, 3, 4, 1681, 1847, 1849, 7919, 2147483647};
+    std::vector<bool> r;
+    prime_batch(w.begin(), w.end(), std::back_inserter(r));
+    CHECK(r == std::vector<bool>{false, false, false, false, true, true, false, false, true, false, true, true});
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -8,27 +8,240 @@
 #ifndef TAO_ALGORITHM_PRIMES_HPP_
 #define TAO_ALGORITHM_PRIMES_HPP_
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
 #include <random>
+#include <type_traits>
 #include <utility>
 #include <iostream>
+#include <vector>
 
 #include <tao/algorithm/concepts.hpp>
 #include <tao/algorithm/integers.hpp>
 #include <tao/algorithm/power.hpp>
+#include <tao/algorithm/simd.hpp>
 #include <tao/algorithm/type_attributes.hpp>
+#include <tao/algorithm/uint_n.hpp>
 
 namespace tao { namespace algorithm {
 
+// (n * m) mod modulus without overflow: for the builtin integers up to 64
+// bits the product is computed in a type twice as wide as I; the other
+// integers double and add, every partial result staying below modulus.
 template <Integer I>
 struct modulo_multiply {
     I modulus;
     modulo_multiply(I const& i) : modulus(i) {}
 
     I operator()(I const& n, I const& m) const {
-        return (n * m) % modulus;
+        // precondition: n >= 0 && m >= 0 && modulus > 0
+        if constexpr (std::is_integral<I>::value && sizeof(I) <= 8) {
+            using U = detail::modular_unsigned_t<I>;
+            using W = detail::wider_unsigned_t<U>;
+            return I(W(U(n)) * W(U(m)) % W(U(modulus)));
+        } else {
+            I a = n % modulus;
+            I b = m;
+            I r(0);
+            while (b != I(0)) {
+                if (odd(b)) r = add(r, a);
+                a = add(a, a);
+                b = half(b);
+            }
+            return r;
+        }
+    }
+
+    I add(I const& a, I const& b) const {
+        // precondition: a < modulus && b < modulus
+        I const c = modulus - b;
+        return a >= c ? I(a - c) : I(a + b);
     }
 };
 
+// Barrett reduction for the wide integers, on 64-bit limbs (HAC 14.42):
+// with k the limbs of the modulus and mu = floor(2^(128 k) / modulus),
+// q = ((x >> 64 (k - 1)) * mu) >> 64 (k + 1) is at most 2 below
+// x / modulus, so x - q * modulus needs at most two subtractions. The
+// shifts are limb offsets, the division is done once.
+template <std::size_t Bits>
+struct modulo_multiply<uint_n<Bits>> {
+    using U = uint_n<Bits>;
+    using X = uint_n<Bits + 64>;
+
+    modulo_multiply(U const& i)
+        : modulus(i)
+        , k(limbs_of(i))
+        , mu(X((uint_n<2 * Bits + 64>(1) << int(128 * k)) / uint_n<2 * Bits + 64>(i)))
+    {
+        // precondition: modulus > 0
+    }
+
+    static
+    std::size_t limbs_of(U const& x) {
+        std::size_t r = U::limbs;
+        while (r > 1 && x.limb[r - 1] == 0) --r;
+        return r;
+    }
+
+    U operator()(U const& n, U const& m) const {
+        // precondition: n < modulus && m < modulus
+        // The offsets are constants when the modulus fills its limbs.
+        return k == U::limbs ? reduce(wide_multiply(n, m), U::limbs) : reduce(wide_multiply(n, m), k);
+    }
+
+    TAO_ALGORITHM_ALWAYS_INLINE
+    U reduce(uint_n<2 * Bits> const& x, std::size_t k) const {
+        X q1;
+        for (std::size_t i = 0; i <= k; ++i) q1.limb[i] = x.limb[k - 1 + i];
+        auto const q2 = wide_multiply(q1, mu);
+        X q3;
+        for (std::size_t i = 0; i <= k; ++i) q3.limb[i] = q2.limb[k + 1 + i];
+        // x - q3 * modulus < 3 * modulus, exact modulo 2^(Bits + 64).
+        X const nx = X(modulus);
+        X r = X(x) - q3 * nx;
+        if (r >= nx) r -= nx;
+        if (r >= nx) r -= nx;
+        return U(r);
+    }
+
+    U modulus;
+    std::size_t k;
+    X mu;
+};
+
+// Montgomery multiplication modulo an odd n: a is represented by
+// a * R mod n, R = 2^bits(U). The product of two representations is
+// reduced without any division (REDC).
+template <typename U>
+struct montgomery_multiply {
+    using W = detail::wider_unsigned_t<U>;
+    static constexpr int bits = std::numeric_limits<U>::digits;
+
+    explicit
+    montgomery_multiply(U n)
+        : modulus(n)
+        , inverse(modular_inverse(n))
+        , r2(U(W(U(U(0) - n) % n) * W(U(U(0) - n) % n) % n))
+    {
+        // precondition: odd(n) && n > 1
+    }
+
+    // n^-1 mod R, Newton's iteration doubles the correct bits every step.
+    static
+    U modular_inverse(U n) {
+        U x = n;                // correct to 3 bits, n * n == 1 mod 8
+        for (int i = 3; i < bits; i *= 2) x *= U(2) - n * x;
+        return x;
+    }
+
+    U reduce(W t) const {
+        // precondition: t < modulus * R
+        // t - m * n is divisible by R and has the same low half as t.
+        U m = U(t) * inverse;
+        U hi = U(t >> bits);
+        U mn = U((W(m) * modulus) >> bits);
+        U const r = U(hi - mn);
+        return U(r + (modulus & U(U(0) - U(hi < mn))));     // branchless, the sign is random
+    }
+
+    U operator()(U a, U b) const { return reduce(W(a) * b); }
+
+    U to_montgomery(U a) const { return reduce(W(a % modulus) * r2); }
+    U from_montgomery(U a) const { return reduce(W(a)); }
+    U one() const { return U(U(0) - modulus) % modulus; }
+
+    U modulus;
+    U inverse;
+    U r2;
+};
+
+// Montgomery multiplication of wide integers, R = 2^Bits. The product and
+// the reduction are interleaved limb by limb (CIOS, coarsely integrated
+// operand scanning): every step adds a * b[i] and the multiple of the
+// modulus that clears the low limb, then drops that limb.
+template <std::size_t Bits>
+struct montgomery_multiply<uint_n<Bits>> {
+    using U = uint_n<Bits>;
+    static constexpr int bits = int(Bits);
+    static constexpr std::size_t limbs = U::limbs;
+
+    explicit
+    montgomery_multiply(U const& n)
+        : modulus(n)
+        , inverse(std::uint64_t(0) - montgomery_multiply<std::uint64_t>::modular_inverse(n.limb[0]))
+        , r1((U(0) - n) % n)
+        , r2(U(wide_multiply(r1, r1) % uint_n<2 * Bits>(n)))
+    {
+        // precondition: odd(n) && n > 1
+    }
+
+    U operator()(U const& a, U const& b) const {
+        // precondition: a < modulus && b < modulus
+        std::uint64_t t[limbs + 2] = {};
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t i = 0; i < limbs; ++i) {
+            std::uint64_t carry = 0;
+            TAO_ALGORITHM_UNROLL
+            for (std::size_t j = 0; j < limbs; ++j) {
+                std::uint64_t hi = 0;
+                std::uint64_t lo = detail::multiply_64(a.limb[j], b.limb[i], hi);
+                lo += carry;
+                hi += lo < carry;
+                lo += t[j];
+                hi += lo < t[j];
+                t[j] = lo;
+                carry = hi;
+            }
+            t[limbs] += carry;
+            t[limbs + 1] = t[limbs] < carry;
+
+            std::uint64_t const m = t[0] * inverse;
+            std::uint64_t hi = 0;
+            std::uint64_t lo = detail::multiply_64(m, modulus.limb[0], hi);
+            carry = hi + (lo + t[0] < lo);      // the low limb becomes 0
+            TAO_ALGORITHM_UNROLL
+            for (std::size_t j = 1; j < limbs; ++j) {
+                lo = detail::multiply_64(m, modulus.limb[j], hi);
+                lo += carry;
+                hi += lo < carry;
+                lo += t[j];
+                hi += lo < t[j];
+                t[j - 1] = lo;
+                carry = hi;
+            }
+            t[limbs - 1] = t[limbs] + carry;
+            t[limbs] = t[limbs + 1] + (t[limbs - 1] < carry);
+        }
+
+        // t < 2 modulus
+        U r;
+        std::uint64_t borrow = 0;
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t j = 0; j < limbs; ++j) r.limb[j] = detail::subtract_borrow(t[j], modulus.limb[j], borrow);
+        // Keep t when t < modulus, selected with a mask: the branch would be random.
+        std::uint64_t const keep = std::uint64_t(0) - std::uint64_t(t[limbs] == 0 && borrow != 0);
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t j = 0; j < limbs; ++j) r.limb[j] = (t[j] & keep) | (r.limb[j] & ~keep);
+        return r;
+    }
+
+    U to_montgomery(U const& a) const { return (*this)(a % modulus, r2); }
+    U from_montgomery(U const& a) const { return (*this)(a, U(1)); }
+    U one() const { return r1; }
+
+    U modulus;
+    std::uint64_t inverse;      // -modulus^-1 mod 2^64
+    U r1;                       // R mod modulus
+    U r2;                       // R^2 mod modulus
+};
+
 template <Integer I>
 bool miller_rabin_test(I n, I q, I k, I w) {
     // precondition: n > 1 && n - 1 == (2^k)*q && odd(q)
@@ -48,25 +261,228 @@ bool miller_rabin_test(I n, I q, I k, I w) {
     return false;
 }
 
+// Same test in Montgomery form, n is op.modulus.
+template <typename U>
+bool miller_rabin_test(montgomery_multiply<U> const& op, U q, U k, U w) {
+    // precondition: n > 1 && n - 1 == (2^k)*q && odd(q)
+    U const one = op.one();
+    U const minus_one = op.modulus - one;
+
+    U x = op.to_montgomery(w);
+    if (x == U(0)) return true;                 // w multiple of n
+    x = power_semigroup(x, q, op);
+
+    if (x == one || x == minus_one) return true;
+
+    for (U i(1); i < k; ++i) {
+        // invariant: x == w^((2^(i-1))*q)
+
+        x = op(x, x);
+        if (x == minus_one) return true;
+        if (x == one)       return false;
+    }
+    return false;
+}
+
 template <Integer I>
 std::pair<I, I> miller_rabin_q_k(I n) {
-    // precondition: odd(n) && ??? TODO(fernando)
+    // precondition: odd(n) && n > 1
 
     // n - 1 = (2^k)*q
+    I q = n - I(1);
+    I k(0);
+    while (even(q)) {
+        q = half(q);
+        ++k;
+    }
+    return {q, k};
+}
+
+// Deterministic primality test for integers up to 64 bits.
+// Small factors are removed by trial division; then strong probable prime
+// tests with the witnesses {2, 7, 61} (n < 2^32) or Sinclair's seven
+// witnesses (n < 2^64) have no pseudoprimes, done in Montgomery form with
+// double width products. The witnesses above 2^32 are below n.
+template <Integer I>
+bool prime(I n) {
+    static_assert(sizeof(I) <= 8, "prime(n) is deterministic up to 64-bit integers");
+    if (n <= I(1)) return false;
 
-    I k(1);
+    constexpr std::uint8_t small_primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    for (auto p : small_primes) {
+        if (n % I(p) == I(0)) return n == I(p);
+    }
+    if (std::uint64_t(n) < 37 * 37) return true;
+
+    auto const x = std::uint64_t(n);
+    if (x < (std::uint64_t(1) << 32)) {
+        auto const y = std::uint32_t(x);
+        auto const q_k = miller_rabin_q_k(y);
+        montgomery_multiply<std::uint32_t> op(y);
+        for (std::uint32_t w : {2, 7, 61}) {
+            if ( ! miller_rabin_test(op, q_k.first, q_k.second, w)) return false;
+        }
+        return true;
+    }
+
+    auto const q_k = miller_rabin_q_k(x);
+    montgomery_multiply<std::uint64_t> op(x);
+    for (std::uint64_t w : {2, 325, 9375, 28178, 450775, 9780504, 1795265022}) {
+        if ( ! miller_rabin_test(op, q_k.first, q_k.second, w)) return false;
+    }
+    return true;
+}
+
+namespace detail {
+
+// Jacobi symbol (a / n), odd n.
+inline
+int jacobi(std::uint64_t a, std::uint64_t n) {
+    // precondition: odd(n)
+    int r = 1;
+    a %= n;
+    while (a != 0) {
+        int const z = count_trailing_zeros(a);
+        a >>= z;
+        if ((z & 1) != 0 && ((n & 7) == 3 || (n & 7) == 5)) r = -r;
+        if ((a & 3) == 3 && (n & 3) == 3) r = -r;
+        std::swap(a, n);
+        a %= n;
+    }
+    return n == 1 ? r : 0;
+}
+
+// (a / n) for a small odd a and a wide odd n, reciprocity brings it to 64 bits.
+template <std::size_t Bits>
+int jacobi(std::int64_t a, uint_n<Bits> const& n) {
+    // precondition: odd(a) && odd(n) && n > |a|
+    auto const n0 = std::uint64_t(n);
+    int r = 1;
+    if (a < 0) {
+        a = -a;
+        if ((n0 & 3) == 3) r = -r;                  // (-1 / n)
+    }
+    auto const b = std::uint64_t(a);
+    if ((b & 3) == 3 && (n0 & 3) == 3) r = -r;
+    return r * jacobi(std::uint64_t(n % uint_n<Bits>(b)), b);
+}
+
+template <std::size_t Bits>
+bool perfect_square(uint_n<Bits> const& n) {
+    using U = uint_n<Bits>;
+    U x = U(1) << ((bit_length(n) + 1) / 2);     // x >= sqrt(n)
     while (true) {
-        I two_to_the_k = power_semigroup(2, k, std::multiplies<I>());
-        if ((n - 1) % two_to_the_k == 0) {
-            I q = (n - 1) / two_to_the_k;
-            if (odd(q)) return {q, k};
+        U const y = half(x + n / x);
+        if (y >= x) break;
+        x = y;
+    }
+    return x * x == n;
+}
+
+// Strong Lucas probable prime test with Selfridge's parameters: D is the
+// first of 5, -7, 9, -11, ... with (D / n) == -1, P = 1, Q = (1 - D) / 4.
+// U_k, V_k and Q^k, n + 1 = 2^s k, are computed in Montgomery form from
+// the top bit of k down (halving modulo n keeps Montgomery form).
+template <std::size_t Bits>
+bool strong_lucas_test(montgomery_multiply<uint_n<Bits>> const& op) {
+    // precondition: odd(n) && n > 2^64, n = op.modulus
+    using U = uint_n<Bits>;
+    U const& n = op.modulus;
+
+    std::int64_t d = 5;
+    for (int i = 0; ; ++i) {
+        int const j = jacobi(d, n);
+        if (j == -1) break;
+        if (j == 0) return false;                   // |d| < n shares a factor with n
+        if (i == 8 && perfect_square(n)) return false;  // no such D exists
+        d = d > 0 ? -(d + 2) : -d + 2;
+    }
+
+    auto add = [&](U const& a, U const& b) { return a >= n - b ? U(a - (n - b)) : U(a + b); };
+    auto sub = [&](U const& a, U const& b) { return a >= b ? U(a - b) : U(a + (n - b)); };
+    auto halve = [&](U const& a) { return even(a) ? half(a) : U(half(a) + half(n) + U(1)); };
+    auto from_signed = [&](std::int64_t x) {
+        U const a = op.to_montgomery(U(std::uint64_t(x < 0 ? -x : x)));
+        return x < 0 && a != U(0) ? U(n - a) : a;
+    };
+    U const dm = from_signed(d);
+    U const qm = from_signed((1 - d) / 4);
+
+    U k = n + U(1);
+    int s = 0;
+    while (even(k)) {
+        k = half(k);
+        ++s;
+    }
+
+    U uk = op.one();                                // U_1 = 1
+    U vk = op.one();                                // V_1 = P = 1
+    U qk = qm;                                      // Q^1
+    for (int i = bit_length(k) - 2; i >= 0; --i) {
+        uk = op(uk, vk);                            // U_2j = U_j V_j
+        vk = sub(op(vk, vk), add(qk, qk));          // V_2j = V_j^2 - 2 Q^j
+        qk = op(qk, qk);
+        if (odd(k >> i)) {
+            U const u = halve(add(uk, vk));         // U_j+1 = (P U_j + V_j) / 2
+            vk = halve(add(op(dm, uk), vk));        // V_j+1 = (D U_j + P V_j) / 2
+            uk = u;
+            qk = op(qk, qm);
         }
-        ++k;
     }
+    if (uk == U(0) || vk == U(0)) return true;
+    for (int r = 1; r < s; ++r) {
+        vk = sub(op(vk, vk), add(qk, qk));
+        if (vk == U(0)) return true;
+        qk = op(qk, qk);
+    }
+    return false;
 }
 
+} // namespace detail
+
+// Primality of wide integers. Up to 2^64 the deterministic test above;
+// below 3317044064679887385961981 (about 2^81.5) the strong probable prime
+// tests to the primes from 2 to 41 have no pseudoprimes (Sorenson and
+// Webster); beyond, the Baillie-PSW test, a strong probable prime test to
+// base 2 and a strong Lucas test, with no known pseudoprimes.
+template <std::size_t Bits>
+bool prime(uint_n<Bits> const& n) {
+    using U = uint_n<Bits>;
+    if ((n >> 64) == U(0)) return prime(std::uint64_t(n));
+
+    // One division by 2 * 3 * ... * 47 instead of one per prime.
+    constexpr std::uint8_t small_primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47};
+    auto const r = std::uint64_t(n % U(614889782588491410ull));
+    for (auto p : small_primes) {
+        if (r % p == 0) return false;
+    }
+
+    auto const q_k = miller_rabin_q_k(n);
+    montgomery_multiply<U> const op(n);
+    U const bound = (U(0x2be69) << 64) | U(0x51adc5b22410a5fdull);
+    if (n < bound) {
+        for (std::uint64_t w : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41}) {
+            if ( ! miller_rabin_test(op, q_k.first, q_k.second, U(w))) return false;
+        }
+        return true;
+    }
+    return miller_rabin_test(op, q_k.first, q_k.second, U(2)) && detail::strong_lucas_test(op);
+}
+
+namespace detail {
+
+inline
+std::mt19937_64& miller_rabin_engine() {
+    thread_local std::mt19937_64 engine(std::random_device{}());
+    return engine;
+}
+
+} // namespace detail
+
+// Probabilistic test with witnesses_n random witnesses from [1, witnesses_n].
+// The random engine is created once per thread.
 template <Integer I>
-bool prime(I n, I witnesses_n = I(100)) {
+bool prime(I n, I witnesses_n) {
     if (n <= I(1)) return false;
     if (n == I(2)) return true;
     if (even(n)) return false;
@@ -77,20 +493,26 @@ bool prime(I n, I witnesses_n = I(100)) {
 
     witnesses_n = (std::min)(n - I(1), witnesses_n);
 
-    using dis_t = std::uniform_int_distribution<I>;
-	std::random_device rd;
-	std::mt19937 mt(rd());
-	dis_t dis(1, witnesses_n);
+    // Wide integers draw their witnesses from the 64-bit range.
+    using W = std::conditional_t<std::is_integral<I>::value, I, std::uint64_t>;
+    using dis_t = std::uniform_int_distribution<W>;
+    auto& mt = detail::miller_rabin_engine();
+    dis_t dis(1, witnesses_n < I(supremum<W>) ? W(witnesses_n) : supremum<W>);
 
     for (I i(0); i < witnesses_n; ++i) {
-        if ( ! miller_rabin_test(n, q, k, dis(mt)) ) return false;
+        if ( ! miller_rabin_test(n, q, k, I(dis(mt))) ) return false;
     }
 
     return true;
 }
 
 template <Integer I>
-bool composite(I n, I witnesses_n = I(100)) {
+bool composite(I n) {
+    return !prime(n);
+}
+
+template <Integer I>
+bool composite(I n, I witnesses_n) {
     return !prime(n, witnesses_n);
 }
 
@@ -137,80 +559,666 @@ void sift(I first, N n) {
     sift_nofill(first, n);
 }
 
-template <Integer N, size_t S = 256> //TODO(fernando): size_t or N ?
-struct sift_gen {
-    sift_gen()
-        : i(0)
-        , buffer(S, true)
+// segmented sieve ----------------------
+// The sieve stores one bit per number coprime to 30: byte k holds the
+// numbers 30k + r for r in {1, 7, 11, 13, 17, 19, 23, 29}. Numbers are
+// sieved in segments of SegmentBytes bytes (30 * SegmentBytes numbers) that
+// fit in L2; primes with many multiples sieve them in L1 blocks of
+// prime_block_bytes. Every sieving prime keeps the position of its next
+// multiple and its place in the wheel between segments.
+// Multiples of the primes from 7 to 41 are not crossed off, the segment is
+// initialized from precomputed periodic patterns instead.
+
+inline constexpr std::size_t prime_segment_bytes = 256 * 1024;
+inline constexpr std::size_t prime_block_bytes = 32 * 1024;
+
+namespace detail {
+
+inline constexpr std::uint8_t wheel30_residues[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+inline constexpr std::uint8_t wheel30_steps[8] = {6, 4, 2, 4, 2, 4, 6, 2};
+
+struct wheel30_tables {
+    // bit[r]: bit of the residue r in a sieve byte, 8 if gcd(r, 30) != 1.
+    std::uint8_t bit[30];
+    // Crossing off the multiples p * m of p = 30q + wheel30_residues[i],
+    // with m = 30k + wheel30_residues[j]:
+    //   mask[i][j]: bit of p * m in its byte,
+    //   carry[i][j]: the byte of p * (m + wheel30_steps[j]) is
+    //                q * wheel30_steps[j] + carry[i][j] bytes further.
+    std::uint8_t mask[8][8];
+    std::uint8_t carry[8][8];
+};
+
+constexpr
+wheel30_tables make_wheel30_tables() {
+    wheel30_tables t{};
+    for (int r = 0; r < 30; ++r) t.bit[r] = 8;
+    for (int i = 0; i < 8; ++i) t.bit[wheel30_residues[i]] = std::uint8_t(i);
+
+    for (int i = 0; i < 8; ++i) {
+        int r = wheel30_residues[i];
+        for (int j = 0; j < 8; ++j) {
+            int w = wheel30_residues[j];
+            int d = wheel30_steps[j];
+            t.mask[i][j] = std::uint8_t(1u << t.bit[(r * w) % 30]);
+            t.carry[i][j] = std::uint8_t((r * (w + d)) / 30 - (r * w) / 30);
+        }
+    }
+    return t;
+}
+
+inline constexpr wheel30_tables wheel30 = make_wheel30_tables();
+
+// First m >= n with gcd(m, 30) == 1.
+inline
+std::uint64_t wheel30_ceil(std::uint64_t n) {
+    std::uint64_t k = n / 30;
+    std::uint64_t r = n % 30;
+    for (auto w : wheel30_residues) {
+        if (w >= r) return 30 * k + w;
+    }
+    return 30 * (k + 1) + 1;
+}
+
+struct sieving_prime {
+    sieving_prime(std::uint64_t p, std::uint64_t m, std::uint64_t base)
+        : q(std::uint32_t(p / 30))
+        , i(wheel30.bit[p % 30])
+        , j(wheel30.bit[m % 30])
+        , pos(p * m / 30 - base)
     {
-        sift_nofill(buffer.begin(), buffer.size());
+        //precondition: gcd(p, 30) == 1 && gcd(m, 30) == 1 && p * m >= 30 * base
     }
 
-    //TODO(fernando): Improvements: 1. Put a sentinel in the buffer
-    //                              2.
+    std::uint64_t prime() const { return std::uint64_t(q) * 30 + wheel30_residues[i]; }
 
-    N operator()() {
-        while (true) {
-            while (i < buffer.size() && ! buffer[i]) ++i;
+    std::uint32_t q;
+    std::uint8_t i;   // wheel index of p
+    std::uint8_t j;   // wheel index of the multiplier of the next multiple
+    std::uint64_t pos;  // byte of the next multiple, relative to the next segment
+};
 
-            if (i < buffer.size()) return 2 * (i++) + 3;
+// Crosses off the multiples of p = 30q + wheel30_residues[I] in [s, s + n),
+// the next multiple has the multiplier index J. A whole turn of the wheel
+// (m to m + 30) moves exactly p bytes, so the eight crossings of a turn have
+// fixed offsets; the masks are immediates, one instantiation per (I, J).
+template <unsigned I, unsigned J>
+void cross_off_wheel(std::uint8_t* s, std::uint64_t n, sieving_prime& sp) {
+    constexpr auto m = [](unsigned k) {
+        return std::uint8_t(~wheel30.mask[I][(J + k) & 7]);
+    };
+    constexpr auto steps = [](unsigned k) {
+        unsigned r = 0;
+        for (unsigned t = 0; t < k; ++t) r += wheel30_steps[(J + t) & 7];
+        return std::uint64_t(r);
+    };
+    constexpr auto carries = [](unsigned k) {
+        unsigned r = 0;
+        for (unsigned t = 0; t < k; ++t) r += wheel30.carry[I][(J + t) & 7];
+        return std::uint64_t(r);
+    };
 
-            buffer.insert(buffer.end(), S, true);
-            sift_nofill(buffer.begin(), buffer.size());
+    std::uint64_t const q = sp.q;
+    std::uint64_t const o[8] = {0,
+        q * steps(1) + carries(1), q * steps(2) + carries(2),
+        q * steps(3) + carries(3), q * steps(4) + carries(4),
+        q * steps(5) + carries(5), q * steps(6) + carries(6),
+        q * steps(7) + carries(7)};
+    std::uint64_t const p = q * 30 + wheel30_residues[I];
+    std::uint64_t pos = sp.pos;
+
+    if (pos + o[7] < n) {
+        std::uint64_t const lim = n - o[7];
+        while (pos < lim) {
+            std::uint8_t* x = s + pos;
+            TAO_ALGORITHM_UNROLL
+            for (unsigned k = 0; k < 8; ++k) x[o[k]] &= m(k);
+            pos += p;
         }
     }
 
+    // Less than a turn left: pos + o[7] >= n. The crossings beyond the
+    // segment go to a sink, no branch mispredictions.
+    std::uint8_t sink = 0;
+    unsigned k = 0;
+    TAO_ALGORITHM_UNROLL
+    for (unsigned t = 0; t < 7; ++t) {
+        bool in = pos + o[t] < n;
+        *(in ? s + pos + o[t] : &sink) &= m(t);
+        k += in;
+    }
+    sp.pos = pos + o[k] - n;
+    sp.j = std::uint8_t((J + k) & 7);
+}
+
+using cross_off_wheel_t = void (*)(std::uint8_t*, std::uint64_t, sieving_prime&);
 
-    sift_gen& operator++() {
-        if (i < buffer.size()) ++i;
+template <std::size_t... K>
+constexpr
+std::array<cross_off_wheel_t, 64> make_cross_off_wheel(std::index_sequence<K...>) {
+    return {{&cross_off_wheel<K / 8, K % 8>...}};
+}
+
+inline constexpr std::array<cross_off_wheel_t, 64> cross_off_wheel_table =
+    make_cross_off_wheel(std::make_index_sequence<64>{});
+
+// Crosses off the multiples of sp in [s, s + n) and moves sp to the next segment.
+inline
+void cross_off(std::uint8_t* s, std::uint64_t n, sieving_prime& sp) {
+    if (sp.pos >= n) {
+        sp.pos -= n;
+        return;
+    }
+    cross_off_wheel_table[sp.i * 8 + sp.j](s, n, sp);
+}
+
+// One period of the sieve with the multiples of a few primes (including
+// themselves) crossed off: 7 * 11 * 13 * 17, 19 * 23 * 29 and 31 * 37 * 41
+// bytes. Segments are the AND of the three patterns.
+inline
+std::array<std::vector<std::uint8_t>, 3> const& presieve_patterns() {
+    static std::array<std::vector<std::uint8_t>, 3> const patterns = [] {
+        std::initializer_list<std::uint64_t> const primes[3] = {
+            {7, 11, 13, 17}, {19, 23, 29}, {31, 37, 41}};
+        std::array<std::vector<std::uint8_t>, 3> res;
+        for (std::size_t i = 0; i < 3; ++i) {
+            std::uint64_t period = 1;
+            for (auto p : primes[i]) period *= p;
+            res[i].assign(period, 0xff);
+            for (auto p : primes[i]) {
+                sieving_prime sp(p, 1, 0);
+                cross_off(res[i].data(), res[i].size(), sp);
+            }
+        }
+        return res;
+    }();
+    return patterns;
+}
+
+// Copies (or ANDs) the pattern into [s, s + n), s is the byte base of the sieve.
+template <typename Op>
+void apply_presieve_pattern(std::uint8_t* s, std::size_t n, std::uint64_t base,
+                            std::vector<std::uint8_t> const& pattern, Op op) {
+    std::size_t const period = pattern.size();
+    std::size_t off = std::size_t(base % period);
+    std::size_t k = 0;
+    while (k < n) {
+        std::size_t c = (std::min)(n - k, period - off);
+        op(pattern.data() + off, c, s + k);
+        k += c;
+        off = 0;
+    }
+}
+
+inline
+std::uint64_t load_le64(std::uint8_t const* p) {
+    std::uint64_t x;
+    std::memcpy(&x, p, sizeof(x));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    x = __builtin_bswap64(x);
+#endif
+    return x;
+}
+
+TAO_ALGORITHM_ALWAYS_INLINE
+std::uint64_t count_bits_generic(std::uint8_t const* p, std::size_t n) {
+    //precondition: n % 8 == 0
+    std::uint64_t c = 0;
+    for (std::size_t k = 0; k < n; k += 8) c += popcount(load_le64(p + k));
+    return c;
+}
+
+#if defined(TAO_ALGORITHM_SIMD_X86)
+TAO_ALGORITHM_TARGET_AVX2
+inline
+std::uint64_t count_bits_popcnt(std::uint8_t const* p, std::size_t n) {
+    return count_bits_generic(p, n);
+}
+#endif
+
+// Number of set bits of [p, p + n).
+inline
+std::uint64_t count_bits(std::uint8_t const* p, std::size_t n) {
+#if defined(TAO_ALGORITHM_SIMD_X86)
+    if (simd_isa_level() >= simd_isa::avx2) return count_bits_popcnt(p, n);
+#endif
+    return count_bits_generic(p, n);
+}
+
+} // namespace detail
+
+// Sieves [lo, hi) one segment at a time:
+//
+//    segmented_sieve<> s(lo, hi);
+//    while (s.next()) s.for_each([](std::uint64_t p) { ... });
+//
+// Only primes >= 7 are reported, 2, 3 and 5 are not on the wheel.
+template <std::size_t SegmentBytes = prime_segment_bytes>
+struct segmented_sieve {
+    static_assert(SegmentBytes > 0, "SegmentBytes must be positive");
+
+    segmented_sieve(std::uint64_t lo, std::uint64_t hi)
+        : lo(lo)
+        , hi(hi)
+        , base(lo / 30)
+        , first_base(lo / 30)
+        , last(hi / 30 + (hi % 30 != 0))
+        , buffer(((SegmentBytes + 7) / 8) * 8)
+    {
+        //precondition: lo <= hi
+    }
+
+    // Sieves the next segment, returns false when [lo, hi) is exhausted.
+    bool next() {
+        base += n;
+        if (base >= last) {
+            n = 0;
+            return false;
+        }
+        n = std::size_t((std::min)(std::uint64_t(SegmentBytes), last - base));
+
+        fill_presieved();
+        add_sieving_primes();
+        // Small primes sieve the segment block by block in L1, the larger
+        // ones (few multiples per block) sieve the whole segment at once.
+        for (std::size_t b = 0; b < n; b += prime_block_bytes) {
+            std::size_t m = (std::min)(prime_block_bytes, n - b);
+            for (auto& sp : sieving_small) detail::cross_off(buffer.data() + b, m, sp);
+        }
+        for (auto& sp : sieving_large) detail::cross_off(buffer.data(), n, sp);
+        cross_off_bucket();
+        clamp();
+        return true;
+    }
+
+    // First number covered by the current segment, a multiple of 30.
+    std::uint64_t low() const { return 30 * base; }
+
+    // Bytes in the current segment, each one covers 30 numbers.
+    std::size_t size() const { return n; }
+
+    std::uint8_t const* data() const { return buffer.data(); }
+
+    // Calls f(p) for every prime p of the current segment, in increasing order.
+    template <typename F>
+    void for_each(F f) const {
+        for (std::size_t k = 0; k < n; k += 8) {
+            std::uint64_t w = detail::load_le64(buffer.data() + k);
+            while (w != 0) {
+                int b = count_trailing_zeros(w);
+                f(30 * (base + k + (b >> 3)) + detail::wheel30_residues[b & 7]);
+                w &= w - 1;
+            }
+        }
+    }
+
+    // Number of primes in the current segment.
+    std::uint64_t count() const {
+        return detail::count_bits(buffer.data(), ((n + 7) / 8) * 8);
+    }
+
+    // The i-th (0-based) prime of the current segment.
+    std::uint64_t nth(std::uint64_t i) const {
+        //precondition: i < count()
+        std::size_t k = 0;
+        std::uint64_t w = detail::load_le64(buffer.data());
+        std::uint64_t c = std::uint64_t(popcount(w));
+        while (c <= i) {
+            i -= c;
+            k += 8;
+            w = detail::load_le64(buffer.data() + k);
+            c = std::uint64_t(popcount(w));
+        }
+        while (i != 0) {
+            w &= w - 1;
+            --i;
+        }
+        int b = count_trailing_zeros(w);
+        return 30 * (base + k + (b >> 3)) + detail::wheel30_residues[b & 7];
+    }
 
+    void fill_presieved() {
+        auto const& patterns = detail::presieve_patterns();
+        detail::apply_presieve_pattern(buffer.data(), n, base, patterns[0],
+            [](std::uint8_t const* p, std::size_t c, std::uint8_t* s) { std::copy_n(p, c, s); });
+        for (std::size_t i = 1; i < patterns.size(); ++i) {
+            detail::apply_presieve_pattern(buffer.data(), n, base, patterns[i],
+                [](std::uint8_t const* p, std::size_t c, std::uint8_t* s) {
+                    std::size_t k = 0;
+                    for (; k + 8 <= c; k += 8) {
+                        std::uint64_t a;
+                        std::uint64_t b;
+                        std::memcpy(&a, s + k, 8);
+                        std::memcpy(&b, p + k, 8);
+                        a &= b;
+                        std::memcpy(s + k, &a, 8);
+                    }
+                    for (; k < c; ++k) s[k] &= p[k];
+                });
+        }
+        // Bytes beyond n are read by for_each() and count() in 64-bit words.
+        std::fill(buffer.begin() + n, buffer.end(), std::uint8_t(0));
+
+        // 1 is not prime, the primes from 7 to 41 were crossed off by the patterns.
+        if (base == 0) {
+            buffer[0] = 0xfe;
+            if (n > 1) buffer[1] |= 0x07;
+        } else if (base == 1) {
+            buffer[0] |= 0x07;
+        }
+    }
+
+    void add_sieving_primes() {
+        // Primes p with p^2 below the end of the segment, p <= 2^32 - 1.
+        std::uint64_t const end = 30 * (base + n);
         while (true) {
-            while (i < buffer.size() && ! buffer[i]) ++i;
+            if (next_small == small.size()) {
+                if ( ! grow_small_primes(end)) return;
+                continue;
+            }
+            std::uint64_t p = small[next_small];
+            if (p * p >= end) return;
+            ++next_small;
+            if (p <= 41) continue;
+
+            std::uint64_t m = detail::wheel30_ceil((std::max)(p, (30 * base + p - 1) / p));
+            if ((p / 30) * 2 >= SegmentBytes) {
+                add_to_bucket(detail::sieving_prime(p, m, 0));
+            } else if (p < prime_block_bytes / 4) {
+                sieving_small.emplace_back(p, m, base);
+            } else {
+                sieving_large.emplace_back(p, m, base);
+            }
+        }
+    }
+
+    // Bucket sieve: a prime whose smallest step (2q bytes) spans the whole
+    // segment has at most one multiple per segment. Instead of visiting it
+    // on every segment, it waits in the bucket of the segment of its next
+    // multiple, buckets form a ring indexed by segment number. The positions
+    // of bucket primes are absolute bytes.
 
-            if (i < buffer.size()) return *this;
+    std::vector<detail::sieving_prime>& bucket_of(std::uint64_t pos) {
+        return buckets[std::size_t(((pos - first_base) / SegmentBytes) & (buckets.size() - 1))];
+    }
 
-            buffer.insert(buffer.end(), S, true);
-            sift_nofill(buffer.begin(), buffer.size());
+    void add_to_bucket(detail::sieving_prime const& sp) {
+        // The largest step is 6q + 6 bytes, the ring must span it.
+        std::uint64_t const ahead = (std::uint64_t(sp.q) * 6 + 6) / SegmentBytes + 2;
+        if (ahead > buckets.size()) {
+            std::size_t size = buckets.empty() ? 1 : buckets.size();
+            while (size < ahead) size *= 2;
+            auto old = std::move(buckets);
+            buckets.assign(size, {});
+            for (auto& b : old) {
+                for (auto const& x : b) bucket_of(x.pos).push_back(x);
+            }
         }
+        bucket_of(sp.pos).push_back(sp);
     }
 
-    // sift_gen& operator+=(N k) {
-    //     while (true) {
-    //         if (i < buffer.size()) ++i;
-    //         while (i < buffer.size() && ! buffer[i]) ++i;
+    void cross_off_bucket() {
+        if (buckets.empty()) return;
+        auto& bucket = bucket_of(base);
+        for (auto sp : bucket) {
+            // The last segment may be shorter than SegmentBytes.
+            if (sp.pos - base >= n) continue;
+            auto const& mask = detail::wheel30.mask[sp.i];
+            auto const& carry = detail::wheel30.carry[sp.i];
+            buffer[std::size_t(sp.pos - base)] &= std::uint8_t(~mask[sp.j]);
+            sp.pos += std::uint64_t(sp.q) * detail::wheel30_steps[sp.j] + carry[sp.j];
+            sp.j = std::uint8_t((sp.j + 1) & 7);
+            bucket_of(sp.pos).push_back(sp);
+        }
+        bucket.clear();
+    }
 
-    //         if (i < buffer.size()) {
-    //             return *this;
-    //         }
+    bool grow_small_primes(std::uint64_t end) {
+        constexpr std::uint64_t max_limit = 0xffffffffu;
+        if (small_limit >= max_limit) return false;
+        std::uint64_t limit = small_limit;
+        do {
+            limit = (std::min)(2 * limit, max_limit);
+        } while (limit < max_limit && limit * limit < end);
 
-    //         buffer.insert(buffer.end(), S, true);
-    //         sift_nofill(buffer.begin(), buffer.size());
-    //     }
-    // }
+        // sift() works over the odd numbers 3, 5, 7, ..., 2n + 1.
+        std::vector<std::uint8_t> odd_sieve((limit - 1) / 2);
+        sift(odd_sieve.begin(), std::ptrdiff_t(odd_sieve.size()));
+        std::vector<std::uint32_t> primes;
+        for (std::size_t i = 0; i < odd_sieve.size(); ++i) {
+            if (odd_sieve[i]) primes.push_back(std::uint32_t(2 * i + 3));
+        }
+        // The old primes are a prefix of the new ones, next_small stays valid.
+        small = std::move(primes);
+        small_limit = limit;
+        return true;
+    }
+
+    void clamp() {
+        // Removes the numbers outside [lo, hi) from the first and last bytes.
+        std::uint64_t const first = 30 * base;
+        if (first < lo) {
+            std::uint64_t r = lo - first;
+            for (int b = 0; b < 8; ++b) {
+                if (detail::wheel30_residues[b] < r) buffer[0] &= std::uint8_t(~(1u << b));
+            }
+        }
+        std::uint64_t const k = n - 1;
+        std::uint64_t const lastfirst = 30 * (base + k);
+        if (hi - lastfirst < 30) {
+            std::uint64_t r = hi - lastfirst;
+            for (int b = 0; b < 8; ++b) {
+                if (detail::wheel30_residues[b] >= r) buffer[k] &= std::uint8_t(~(1u << b));
+            }
+        }
+    }
+
+    std::uint64_t lo;
+    std::uint64_t hi;
+    std::uint64_t base;       // first byte of the current segment
+    std::uint64_t first_base; // first byte of the first segment
+    std::uint64_t last;       // one past the last byte of [lo, hi)
+    std::size_t n = 0;        // bytes in the current segment
+    std::vector<std::uint8_t> buffer;
+    std::vector<detail::sieving_prime> sieving_small;
+    std::vector<detail::sieving_prime> sieving_large;
+    std::vector<std::vector<detail::sieving_prime>> buckets;
+    std::vector<std::uint32_t> small;
+    std::size_t next_small = 0;
+    std::uint64_t small_limit = 256;
+};
+
+// Calls f(p) for every prime p in [lo, hi), in increasing order.
+template <std::size_t SegmentBytes = prime_segment_bytes, typename F>
+void for_each_prime(std::uint64_t lo, std::uint64_t hi, F f) {
+    //precondition: lo <= hi
+    for (std::uint64_t p : {2, 3, 5}) {
+        if (lo <= p && p < hi) f(p);
+    }
+    segmented_sieve<SegmentBytes> s(lo, hi);
+    while (s.next()) s.for_each(f);
+}
+
+// Number of primes in [lo, hi), counted with popcount over the sieve segments.
+template <std::size_t SegmentBytes = prime_segment_bytes>
+std::uint64_t count_primes(std::uint64_t lo, std::uint64_t hi) {
+    //precondition: lo <= hi
+    std::uint64_t c = 0;
+    for (std::uint64_t p : {2, 3, 5}) {
+        if (lo <= p && p < hi) ++c;
+    }
+    segmented_sieve<SegmentBytes> s(lo, hi);
+    while (s.next()) c += s.count();
+    return c;
+}
+
+// Prime generator over the segmented sieve. operator* is the current
+// prime, operator++ moves to the next one and operator() returns the
+// current prime and moves to the next one.
+// The generator starts at the first prime >= first (3 by default); S is the
+// size in bytes of the sieve segments.
+template <Integer N, size_t S = prime_segment_bytes>
+struct sift_gen {
+    explicit
+    sift_gen(N first = N(3))
+        : sieve(std::uint64_t(first), std::numeric_limits<std::uint64_t>::max())
+    {
+        small = 0;
+        while (small < 3 && small_primes[small] < std::uint64_t(first)) ++small;
+        if (small == 3) advance();
+    }
+
+    N operator()() {
+        N p = **this;
+        ++*this;
+        return p;
+    }
+
+    sift_gen& operator++() {
+        if (small < 3) {
+            ++small;
+            if (small < 3) return *this;
+        } else {
+            bits &= bits - 1;
+        }
+        advance();
+        return *this;
+    }
 
     N operator*() const {
-        return 2 * i + 3;
+        if (small < 3) return N(small_primes[small]);
+        return N(30 * (sieve.base + k + (count_trailing_zeros(bits) >> 3)) +
+                 detail::wheel30_residues[count_trailing_zeros(bits) & 7]);
     }
 
-    size_t i;
-    std::vector<uint8_t> buffer;
+    void advance() {
+        // Moves to the next set bit of the sieve, sieving segments as needed.
+        while (bits == 0) {
+            k += 8;
+            if (k >= sieve.size()) {
+                sieve.next();
+                k = 0;
+            }
+            bits = detail::load_le64(sieve.data() + k);
+        }
+    }
+
+    static constexpr std::uint64_t small_primes[3] = {2, 3, 5};
+
+    segmented_sieve<S> sieve;
+    std::size_t small;
+    std::size_t k = 0;
+    std::uint64_t bits = 0;
 };
 
 
+// prime counting ----------------------
+
+namespace detail {
+
+inline
+std::uint64_t isqrt(std::uint64_t x) {
+    std::uint64_t r = std::uint64_t(std::sqrt(double(x)));
+    while (r > 0 && r > x / r) --r;
+    while ((r + 1) <= x / (r + 1)) ++r;
+    return r;
+}
+
+} // namespace detail
+
+//Complexity:
+//      Runtime:
+//          O(x^(3/4))
+//      Space:
+//          O(x^(1/2))
+//
+// Number of primes <= x, Lucy Hedgehog's dynamic programming form of
+// Legendre's sieve. S(v) counts the numbers in [2, v] not crossed off by the
+// primes below p; only the values v = x / i are needed, and every prime p
+// updates them as S(v) -= S(v / p) - S(p - 1) for v >= p^2.
+template <Integer N>
+N prime_pi(N x) {
+    // precondition: x >= 0
+    std::uint64_t const n = std::uint64_t(x);
+    if (n < 2) return N(0);
+
+    std::uint64_t const r = detail::isqrt(n);
+    std::vector<std::uint64_t> small(r + 1);  // small[v] = S(v)
+    std::vector<std::uint64_t> large(r + 1);  // large[i] = S(n / i)
+    for (std::uint64_t v = 1; v <= r; ++v) {
+        small[v] = v - 1;
+        large[v] = n / v - 1;
+    }
+
+    for (std::uint64_t p = 2; p <= r; ++p) {
+        if (small[p] == small[p - 1]) continue;    // p is not prime
+        std::uint64_t const sp = small[p - 1];
+        std::uint64_t const p2 = p * p;
+
+        std::uint64_t const lim = (std::min)(r, n / p2);
+        std::uint64_t const cut = r / p;            // i * p <= r for i <= cut
+        for (std::uint64_t i = 1; i <= lim; ++i) {
+            std::uint64_t const s = i <= cut ? large[i * p] : small[n / (i * p)];
+            large[i] -= s - sp;
+        }
+        for (std::uint64_t v = r; v >= p2; --v) {
+            small[v] -= small[v / p] - sp;
+        }
+    }
+    return N(large[1]);
+}
+
+namespace detail {
+
+// Approximation of the k-th (1-based) prime, k >= 6 (Cipolla).
+inline
+std::uint64_t prime_nth_estimate(std::uint64_t k) {
+    double const l = std::log(double(k));
+    double const ll = std::log(l);
+    return std::uint64_t(double(k) * (l + ll - 1.0 + (ll - 2.0) / l));
+}
+
+} // namespace detail
+
+//Complexity:
+//      Runtime:
+//          O(p^(3/4)) for the prime p returned
+//      Space:
+//          O(p^(1/2))
+//
+// The n-th prime, 0-based: prime_nth(0) == 2.
+// p_(n+1) is estimated analytically, prime_pi() counts the primes up to the
+// estimate and a short segmented sieve walks from there to the prime.
 template <Integer N>
 N prime_nth(N n) {
     // precondition: n >= 0
+    std::uint64_t const k = std::uint64_t(n) + 1;
+    if (k <= 3) return N(k == 1 ? 2 : k == 2 ? 3 : 5);
 
-    if (n == 0) return 2;
-    --n;
-
-    sift_gen<N> gen;
+    std::uint64_t x = 5;
+    std::uint64_t c = 3;                            // c == prime_pi(x)
+    if (k >= 6) {
+        x = (std::max)(x, detail::prime_nth_estimate(k));
+        c = prime_pi(x);
+        // The estimate may overshoot, step back until prime_pi(x) < k.
+        while (c >= k) {
+            std::uint64_t const d = x / 1024 + 1024;
+            std::uint64_t const lo = x - d > 5 ? x - d : 5;
+            c -= count_primes(lo + 1, x + 1);
+            x = lo;
+        }
+    }
 
-    while (n != 0) {
-        ++gen;
-        --n;
+    // The (k - c)-th prime after x, no prime below 7 is left. The walk is
+    // short, small segments avoid sieving far beyond the prime.
+    std::uint64_t left = k - c;
+    segmented_sieve<4096> s(x + 1, std::numeric_limits<std::uint64_t>::max());
+    while (s.next()) {
+        std::uint64_t const m = s.count();
+        if (left <= m) return N(s.nth(left - 1));
+        left -= m;
     }
-    return *gen;
+    return N(0);    // unreachable
 }
 
 }} /*tao::algorithm*/
@@ -273,9 +1281,11 @@ TEST_CASE("[primes] testing the Primality Test functionality") {
     CHECK(prime_nth(900-1) == 6997);
     CHECK(prime_nth(1000-1) == 7919);
     CHECK(prime_nth(10000-1) == 104729);
-    // CHECK(prime_nth(100000-1) ==  1299709);
-    // CHECK(prime_nth(1000000-1) == 15485863);
-    // CHECK(prime_nth(10000000-1) == 179424673);
+    CHECK(prime_nth(100000-1) ==  1299709);
+    CHECK(prime_nth(1000000-1) == 15485863);
+    CHECK(prime_nth(10000000-1) == 179424673);
+    CHECK(prime_nth(std::uint64_t(100000000-1)) == 2038074743);
+    CHECK(prime_nth(std::uint64_t(1000000000-1)) == 22801763489ull);
 
     // The 100000000th prime is 2038074743.
     // The 1000000000th prime is 22801763489
@@ -285,5 +1295,261 @@ TEST_CASE("[primes] testing the Primality Test functionality") {
 
 }
 
+TEST_CASE("[primes] testing segmented_sieve against sift") {
+    using namespace tao::algorithm;
+
+    std::size_t const n = 300000;
+    std::vector<std::uint8_t> odd(n);
+    sift(odd.begin(), std::ptrdiff_t(n));
+    std::vector<std::uint64_t> expected = {2};
+    for (std::size_t i = 0; i < n; ++i) {
+        if (odd[i]) expected.push_back(2 * i + 3);
+    }
+    std::uint64_t const limit = 2 * n + 2;
+
+    auto check_range = [&](std::uint64_t lo, std::uint64_t hi) {
+        std::vector<std::uint64_t> primes;
+        for_each_prime(lo, hi, [&](std::uint64_t p) { primes.push_back(p); });
+        auto f = std::lower_bound(expected.begin(), expected.end(), lo);
+        auto l = std::lower_bound(expected.begin(), expected.end(), hi);
+        CHECK(std::equal(primes.begin(), primes.end(), f, l));
+        CHECK(primes.size() == std::size_t(l - f));
+    };
+
+    check_range(0, limit);
+    check_range(0, 0);
+    check_range(0, 7);
+    check_range(7, 8);
+    check_range(8, 11);
+    check_range(29, 31);
+    check_range(31, 60);
+    check_range(37, 90);
+    check_range(1000, 1030);
+    check_range(123457, 131071);
+    check_range(30 * 17017 - 31, 30 * 17017 + 31);
+
+    // Tiny segments cross the boundaries of every segment and of the presieve pattern.
+    std::vector<std::uint64_t> primes;
+    segmented_sieve<24> s(0, limit);
+    std::uint64_t count = 0;
+    while (s.next()) {
+        s.for_each([&](std::uint64_t p) { primes.push_back(p); });
+        count += s.count();
+    }
+    CHECK(count == expected.size() - 3);
+    CHECK(std::equal(primes.begin(), primes.end(), expected.begin() + 3));
+}
+
+TEST_CASE("[primes] testing sift_gen over segments") {
+    using namespace tao::algorithm;
+
+    sift_gen<std::uint64_t, 10> gen;
+    sift_gen<std::uint64_t> ref(2);
+    CHECK(*ref == 2);
+    ++ref;
+    for (int i = 0; i < 100000; ++i) {
+        CHECK(*gen == *ref);
+        CHECK(gen() == ref());
+    }
+
+    sift_gen<std::uint32_t> from(1000000);
+    CHECK(*from == 1000003);
+    CHECK(from() == 1000003);
+    CHECK(from() == 1000033);
+
+    std::uint64_t pi = 0;
+    sift_gen<std::uint64_t> all(2);
+    while (*all < 10000000) {
+        ++pi;
+        ++all;
+    }
+    CHECK(pi == 664579);
+}
+
+TEST_CASE("[primes] testing prime_pi") {
+    using namespace tao::algorithm;
+
+    CHECK(prime_pi(0) == 0);
+    CHECK(prime_pi(1) == 0);
+    CHECK(prime_pi(2) == 1);
+    CHECK(prime_pi(3) == 2);
+    CHECK(prime_pi(4) == 2);
+    CHECK(prime_pi(100) == 25);
+    CHECK(prime_pi(1000000) == 78498);
+    CHECK(prime_pi(std::uint64_t(1000000000)) == 50847534);
+    CHECK(prime_pi(std::uint64_t(10000000000ull)) == 455052511);
+
+    std::vector<std::uint64_t> primes;
+    for_each_prime(0, 5000, [&](std::uint64_t p) { primes.push_back(p); });
+    for (std::uint64_t x = 0; x < 5000; x += 7) {
+        auto pi = std::upper_bound(primes.begin(), primes.end(), x) - primes.begin();
+        CHECK(prime_pi(x) == std::uint64_t(pi));
+    }
+    for (std::uint64_t x : {999983ull, 999984ull, 12345678ull}) {
+        CHECK(prime_pi(x) == count_primes(0, x + 1));
+    }
+    CHECK(prime_pi(std::uint64_t(4294967295ull)) == 203280221);
+
+    sift_gen<int> gen(2);
+    for (int n = 0; n < 2000; ++n) {
+        CHECK(prime_nth(n) == *gen);
+        ++gen;
+    }
+}
+TEST_CASE("[primes] testing deterministic Miller-Rabin") {
+    using namespace tao::algorithm;
+
+    // (10^18 * (10^18 - 1)) mod (10^18 + 9) overflowed 64 bits.
+    modulo_multiply<std::uint64_t> mm(1000000000000000009ull);
+    CHECK(mm(1000000000000000000ull, 999999999999999999ull) == 90);
+
+#if defined(__SIZEOF_INT128__)
+    // No wider builtin type, double and add: 3^(2^127 - 2) == 1 mod 2^127 - 1.
+    using V = unsigned __int128;
+    V const m127 = (V(1) << 127) - 1;
+    modulo_multiply<V> mv(m127);
+    CHECK((mv(m127 - 1, m127 - 1) == 1));
+    modulo_multiply<uint_n<128>> barrett(m127);
+    std::mt19937_64 eng(34);
+    for (int i = 0; i < 1000; ++i) {
+        V const a = ((V(eng()) << 64) | eng()) % m127;
+        V const b = ((V(eng()) << 64) | eng()) % m127;
+        CHECK(uint_n<128>(mv(a, b)) == barrett(a, b));
+    }
+    CHECK((power_semigroup(V(3), m127 - 1, mv) == 1));
+    CHECK((power_semigroup(V(3), m127 - 2, mv) != 1));
+#endif
+
+    montgomery_multiply<std::uint64_t> op(1000000000000000009ull);
+    auto a = op.to_montgomery(1000000000000000000ull);
+    auto b = op.to_montgomery(999999999999999999ull);
+    CHECK(op.from_montgomery(op(a, b)) == 90);
+    CHECK(op.from_montgomery(op.one()) == 1);
+
+    // Strong pseudoprimes to the first bases, Carmichael numbers.
+    for (std::uint64_t n : {561ull, 41041ull, 825265ull, 3215031751ull, 2152302898747ull,
+                            3474749660383ull, 341550071728321ull, 3825123056546413051ull,
+                            18446744073709551615ull, 4294967297ull}) {
+        CHECK( ! prime(n));
+        CHECK(composite(n));
+    }
+    for (std::uint64_t n : {2305843009213693951ull, 18446744073709551557ull, 4294967291ull,
+                            4294967311ull, 1000000000000000003ull}) {
+        CHECK(prime(n));
+    }
+
+    std::vector<std::uint8_t> is_prime(3000000);
+    for_each_prime(0, is_prime.size(), [&](std::uint64_t p) { is_prime[p] = 1; });
+    for (std::uint32_t n = 0; n < is_prime.size(); ++n) {
+        if (prime(n) != bool(is_prime[n])) {
+            CHECK(prime(n) == bool(is_prime[n]));
+        }
+    }
+
+    // Sinclair's witnesses against the Baillie-PSW test of uint_n, on odd
+    // numbers and on products of two primes above 2^31.
+    std::mt19937_64 gen(341);
+    for (int i = 0; i < 20000; ++i) {
+        std::uint64_t const n = gen() | 1;
+        if (prime(n) != prime(uint_n<128>(n))) CHECK(prime(n) == prime(uint_n<128>(n)));
+    }
+    for (int i = 0; i < 200; ++i) {
+        std::uint64_t p = (gen() >> 32) | (std::uint64_t(1) << 31) | 1;
+        std::uint64_t q = (gen() >> 32) | (std::uint64_t(1) << 31) | 1;
+        while ( ! prime(p)) p += 2;
+        while ( ! prime(q)) q += 2;
+        CHECK( ! prime(p * q));
+    }
+
+    // Across the 32-bit boundary.
+    std::uint64_t const lo = (std::uint64_t(1) << 32) - 200000;
+    std::uint64_t const hi = (std::uint64_t(1) << 32) + 200000;
+    std::uint64_t count = 0;
+    for (std::uint64_t n = lo; n < hi; ++n) count += prime(n);
+    CHECK(count == count_primes(lo, hi));
+
+    CHECK(prime(int(7919)));
+    CHECK( ! prime(int(-7)));
+    CHECK(prime(10007, 20));
+    CHECK( ! prime(10001, 20));
+}
+
+TEST_CASE("[primes] testing Barrett and Montgomery multiplication on uint_n") {
+    using namespace tao::algorithm;
+    using V = uint256_t;
+
+    std::mt19937_64 eng(3);
+    auto random = [&]() {
+        V x;
+        for (auto& l : x.limb) l = eng();
+        return x;
+    };
+    for (int i = 0; i < 2000; ++i) {
+        V n = random() >> int(eng() % 190);
+        n.limb[0] |= 1;
+        if (n < V(3)) continue;
+        V const a = random() % n;
+        V const b = random() % n;
+        V const expected = V(wide_multiply(a, b) % uint_n<512>(n));
+        CHECK(modulo_multiply<V>(n)(a, b) == expected);
+        montgomery_multiply<V> const op(n);
+        CHECK(op.from_montgomery(op(op.to_montgomery(a), op.to_montgomery(b))) == expected);
+        CHECK(op.from_montgomery(op.one()) == V(1));
+    }
+
+    // Fermat's little theorem, the exponent is a uint_n too.
+    using U = uint128_t;
+    U const m127 = (U(1) << 127) - U(1);
+    CHECK(power_semigroup(U(3), m127 - U(1), modulo_multiply<U>(m127)) == U(1));
+    montgomery_multiply<U> const op(m127);
+    CHECK(op.from_montgomery(power_semigroup(op.to_montgomery(U(3)), m127 - U(1), op)) == U(1));
+}
+
+TEST_CASE("[primes] testing prime on 128 and 256-bit integers") {
+    using namespace tao::algorithm;
+    using U = uint128_t;
+    using V = uint256_t;
+
+    // Mersenne primes, the primes closest to 2^64, 2^128 and 2^256, NIST P-192, P-224 and P-256, 2^255 - 19.
+    for (U n : {(U(1) << 89) - U(1), (U(1) << 107) - U(1), (U(1) << 127) - U(1),
+                (U(1) << 64) + U(13), U(0) - U(159), U(18446744073709551557ull)}) {
+        CHECK(prime(n));
+    }
+    for (V n : {(V(1) << 255) - V(19), V(0) - V(189), (V(1) << 192) - (V(1) << 64) - V(1),
+                (V(1) << 224) - (V(1) << 96) + V(1),
+                V(0) - (V(1) << 224) + (V(1) << 192) + (V(1) << 96) - V(1)}) {
+        CHECK(prime(n));
+    }
+
+    U const m61 = (U(1) << 61) - U(1);
+    U const m89 = (U(1) << 89) - U(1);
+    U const p64 = U(18446744073709551557ull);
+    // Strong pseudoprimes to the primes up to 37 and up to 41: psi_12 and psi_13.
+    U const psi12 = U::from_decimal("318665857834031151167461");
+    U const psi13 = U::from_decimal("3317044064679887385961981");
+    for (U n : {psi12, psi13, m61 * m89, p64 * p64, p64 * U(18446744073709551533ull),
+                (U(1) << 64) + U(1), U(0) - U(1), U(0) - U(157)}) {
+        CHECK( ! prime(n));
+    }
+    CHECK( ! prime(V(m89) * V(m89)));
+    CHECK( ! prime(V(0) - V(1)));
+    CHECK( ! prime(V((U(1) << 127) - U(1)) * V(U(0) - U(159))));
+
+    // The Baillie-PSW branch against 30 random strong probable prime tests.
+    montgomery_multiply<U> const op(psi13);
+    CHECK( ! detail::strong_lucas_test(op));
+    for (U lo : {U(1) << 64, U(1) << 100, U(0) - U(2000)}) {
+        std::size_t count = 0;
+        for (U n = lo; n != lo + U(2000); ++n) {
+            bool const p = prime(n);
+            count += p;
+            if (p != prime(n, U(30))) CHECK(p == prime(n, U(30)));
+        }
+        CHECK(count > 10);
+    }
+    for (std::uint64_t n = 18446744073709551615ull - 3000; n != 0; ++n) {
+        if (prime(U(n)) != prime(n)) CHECK(prime(U(n)) == prime(n));
+    }
+}
 
 #endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <tuple>
 #include <utility>
 
 #include <tao/algorithm/concepts.hpp>
@@ -36,28 +37,125 @@ I1 remove_range_first(I1 f, I1 l, I2 fs, I2 ls) {
     return std::rotate(f, fn, l);
 }
 
+// Removes the non-overlapping occurrences of [fs, ls) found scanning
+// [f, l) from left to right. The kept elements are moved down, each at
+// most once, behind a write cursor; the searcher is built once. Returns
+// the new end, the elements in [new end, l) are left moved-from (as with
+// std::remove). An empty pattern removes nothing.
+
 //Complexity:
 //      Runtime:
-//          Amortized: O(n)
-//          Exact:     TODO???
+//          O(n) moves; the comparisons are those of the searcher
+//          (make_searcher), linear on average
 //      Space:
-//          O(TODO???)
+//          O(1) (Horspool's table for random access ranges)
 template <ForwardIterator I1, ForwardIterator I2>
 // requires(Readable(I1) && Readable(I2) && ValueType(I1) == ValueType(I2) TODO???)
 I1 remove_range(I1 f, I1 l, I2 fs, I2 ls) {
-    // precondition: readable_weak_range(f, l) && readable_weak_range(fs, ls) TODO???
+    // precondition: mutable_bounded_range(f, l) && readable_bounded_range(fs, ls)
+    if (fs == ls) return l;
+    auto const searcher = make_searcher<I1>(fs, ls);
     I1 fn;
-    std::tie(f, fn) = tao::algorithm::search(f, l, fs, ls);
+    std::tie(f, fn) = searcher(f, l);
+    if (f == l) return l;
 
-    while (f != l) {
-        l = std::rotate(f, fn, l);
-        std::tie(f, fn) = tao::algorithm::search(f, l, fs, ls);
+    I1 out = f;
+    while (true) {
+        I1 m;
+        std::tie(m, f) = searcher(fn, l);
+        out = std::move(fn, m, out);
+        if (m == l) return out;
+        fn = f;
     }
-    return l;
 }
 
-//TODO: implement remove_range_n. We need tao::rotate_n.
+//Complexity:
+//      Runtime:
+//          as remove_range, plus n steps to find the end of ForwardIterator ranges
+//      Space:
+//          O(1) (Horspool's table for random access ranges)
+template <ForwardIterator I1, ForwardIterator I2>
+// requires(Readable(I1) && Readable(I2) && ValueType(I1) == ValueType(I2) TODO???)
+I1 remove_range_n(I1 f, DistanceType<I1> n, I2 fs, DistanceType<I2> ns) {
+    // precondition: mutable_counted_range(f, n) && readable_counted_range(fs, ns)
+    return remove_range(f, std::next(f, n), fs, std::next(fs, ns));
+}
 
 }} /*tao::algorithm*/
 
 #endif /*TAO_ALGORITHM_REMOVE_RANGE_HPP*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// The previous algorithm: search, then rotate the rest over the match.
+template <typename C>
+C remove_range_by_rotation(C c, C const& p) {
+    auto f = c.begin();
+    auto l = c.end();
+    if (p.empty()) return c;
+    while (true) {
+        auto r = tao::algorithm::search(f, l, p.begin(), p.end());
+        if (r.first == l) break;
+        l = std::rotate(r.first, r.second, l);
+        f = r.first;
+    }
+    c.erase(l, c.end());
+    return c;
+}
+
+template <typename C>
+C remove_range_of(C c, C const& p) {
+    c.erase(tao::algorithm::remove_range(c.begin(), c.end(), p.begin(), p.end()), c.end());
+    return c;
+}
+
+template <typename C>
+C remove_range_n_of(C c, C const& p) {
+    auto const n = std::distance(c.begin(), c.end());
+    auto const ns = std::distance(p.begin(), p.end());
+    c.erase(tao::algorithm::remove_range_n(c.begin(), n, p.begin(), ns), c.end());
+    return c;
+}
+
+} // namespace
+
+TEST_CASE("[remove_range] testing remove_range against search and rotate") {
+    using namespace tao::algorithm;
+
+    CHECK(remove_range_of(std::string("aabbab"), std::string("ab")) == "ab");
+    CHECK(remove_range_of(std::string("aaaaa"), std::string("aa")) == "a");
+    CHECK(remove_range_of(std::string("abc"), std::string("")) == "abc");
+    CHECK(remove_range_of(std::string(""), std::string("x")) == "");
+    CHECK(remove_range_of(std::string("xyz"), std::string("xyz")) == "");
+
+    std::mt19937 gen(43);
+    for (int round = 0; round < 200; ++round) {
+        std::size_t const alphabet = 2 + round % 3;
+        std::vector<int> text(gen() % 200);
+        for (auto& x : text) x = int(gen() % alphabet);
+        std::vector<int> pattern(1 + gen() % 4);
+        for (auto& x : pattern) x = int(gen() % alphabet);
+        auto const expected = remove_range_by_rotation(text, pattern);
+
+        CHECK(remove_range_of(text, pattern) == expected);
+        CHECK(remove_range_n_of(text, pattern) == expected);
+
+        std::string const st(text.begin(), text.end());
+        std::string const sp(pattern.begin(), pattern.end());
+        CHECK(remove_range_of(st, sp) == std::string(expected.begin(), expected.end()));
+
+        std::list<int> const lt(text.begin(), text.end());
+        std::list<int> const lp(pattern.begin(), pattern.end());
+        CHECK(remove_range_n_of(lt, lp) == std::list<int>(expected.begin(), expected.end()));
+    }
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
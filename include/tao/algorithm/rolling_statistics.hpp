@@ -0,0 +1,424 @@
+//! \file tao/algorithm/rolling_statistics.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_ROLLING_STATISTICS_HPP_
+#define TAO_ALGORITHM_ROLLING_STATISTICS_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/integers.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao { namespace algorithm {
+
+namespace detail {
+
+// Monotonic queue over the last Window pushed values.
+// front() is the extreme (min for std::less, max for std::greater) of the window.
+template <Regular T, std::size_t Window, StrictWeakOrdering R>
+struct monotonic_queue {
+    void push(T const& x, std::uint64_t t) {
+        // t is the position of x in the stream, strictly increasing.
+        if (head != tail && times[head % Window] + Window <= t) ++head;
+        while (head != tail && ! r(back_value(), x)) --tail;
+        values[tail % Window] = x;
+        times[tail % Window] = t;
+        ++tail;
+    }
+
+    T const& front() const {
+        //precondition: head != tail
+        return values[head % Window];
+    }
+
+    T const& back_value() const { return values[(tail - 1) % Window]; }
+
+    void reset() { head = tail = 0; }
+
+    std::array<T, Window> values;
+    std::array<std::uint64_t, Window> times;
+    std::uint64_t head = 0;
+    std::uint64_t tail = 0;
+    R r;
+};
+
+} // namespace detail
+
+// ------------------------------------------------------------------------
+// Rolling statistics over the last Window samples.
+// Every push is O(1): mean and variance use Welford's update with the
+// sample leaving the window removed, min and max use monotonic queues.
+// The removals leave rounding errors behind, so once the window is full
+// the mean and variance are recomputed from it every Window pushes: O(1)
+// amortized.
+// ------------------------------------------------------------------------
+
+template <Real R = double, std::size_t Window = 64>
+struct rolling_statistics {
+    static_assert(Window > 0, "Window must be positive");
+
+    using value_type = R;
+    static constexpr std::size_t window = Window;
+
+    void push(R x) {
+        if (n == Window) {
+            // Replace the oldest sample, n stays the same.
+            R old = buffer[t % Window];
+            R old_mean = m;
+            m += (x - old) / R(Window);
+            m2 += (x - old) * (x - m + old - old_mean);
+            if (m2 < R(0)) m2 = R(0);
+        } else {
+            ++n;
+            R d = x - m;
+            m += d / R(n);
+            m2 += d * (x - m);
+        }
+        buffer[t % Window] = x;
+        mins.push(x, t);
+        maxs.push(x, t);
+        ++t;
+        if (n == Window && t % Window == 0) reanchor();
+    }
+
+    template <Iterator I>
+        requires(Readable<I>)
+    void push(I f, I l) {
+        //precondition: readable_bounded_range(f, l)
+        while (f != l) {
+            push(R(*f));
+            ++f;
+        }
+    }
+
+    // Mean and sum of squared deviations of the full window, two passes.
+    void reanchor() {
+        R s = R(0);
+        for (R x : buffer) s += x;
+        m = s / R(Window);
+        m2 = R(0);
+        for (R x : buffer) m2 += (x - m) * (x - m);
+    }
+
+    void reset() {
+        n = 0;
+        t = 0;
+        m = R(0);
+        m2 = R(0);
+        mins.reset();
+        maxs.reset();
+    }
+
+    std::size_t size() const { return n; }
+    bool full() const { return n == Window; }
+
+    R mean() const { return m; }
+
+    R population_variance() const {
+        //precondition: size() > 0
+        return m2 / R(n);
+    }
+
+    R sample_variance() const {
+        //precondition: size() > 1
+        return m2 / R(n - 1);
+    }
+
+    R population_std_dev() const { return std::sqrt(population_variance()); }
+    R sample_std_dev() const { return std::sqrt(sample_variance()); }
+
+    R min() const {
+        //precondition: size() > 0
+        return mins.front();
+    }
+
+    R max() const {
+        //precondition: size() > 0
+        return maxs.front();
+    }
+
+    std::array<R, Window> buffer;
+    std::size_t n = 0;
+    std::uint64_t t = 0;
+    R m = R(0);
+    R m2 = R(0);
+    detail::monotonic_queue<R, Window, std::less<R>> mins;
+    detail::monotonic_queue<R, Window, std::greater<R>> maxs;
+};
+
+
+// ------------------------------------------------------------------------
+// Batch API
+// ------------------------------------------------------------------------
+// Each algorithm writes one result per complete window of [f, l), that is
+// (l - f) - Window + 1 values, and returns the final output iterator.
+//
+// The window sums are maintained as s[i] = s[i - 1] + (x[i] - x[i - W]).
+// Work is done in blocks: the differences and the final scaling have no
+// loop-carried dependency and vectorize; only the prefix sum is serial.
+// Values are shifted by the first sample to limit cancellation in the
+// sum of squares (see variance_helper_2 in statistics.hpp). The rounding
+// errors of the running sums would grow with the distance from f, so the
+// sums are recomputed from the window itself at the start of a block once
+// max(Window, rolling_block) values have been added since the last time:
+// at most one more addition per result.
+
+namespace detail {
+
+constexpr std::ptrdiff_t rolling_block = 256;
+
+// Sum and sum of squares of x - k over [f, f + Window).
+template <std::size_t Window, RandomAccessIterator I, Real R>
+    requires(Readable<I>)
+void rolling_window_sums(I f, R k, R& s, R& q) {
+    s = R(0);
+    q = R(0);
+    for (std::size_t i = 0; i < Window; ++i) {
+        R x = R(f[i]) - k;
+        s += x;
+        q += x * x;
+    }
+}
+
+template <std::size_t Window, RandomAccessIterator I, Iterator O, Real R, typename Emit>
+    requires(Readable<I> && Writable<O>)
+O rolling_sums(I f, I l, O out, R k, Emit emit) {
+    //precondition: l - f >= Window
+    R s;
+    R q;
+    rolling_window_sums<Window>(f, k, s, q);
+    *out = emit(s, q);
+    ++out;
+
+    R ds[rolling_block];
+    R dq[rolling_block];
+
+    std::ptrdiff_t const anchor = (std::max)(std::ptrdiff_t(Window), rolling_block);
+    std::ptrdiff_t drift = 0;
+    I g = f + Window;
+    while (g != l) {
+        if (drift >= anchor) {
+            rolling_window_sums<Window>(g - std::ptrdiff_t(Window), k, s, q);
+            drift = 0;
+        }
+        std::ptrdiff_t b = (std::min)(rolling_block, std::ptrdiff_t(l - g));
+        drift += b;
+        for (std::ptrdiff_t j = 0; j < b; ++j) {
+            R a = R(g[j]) - k;
+            R o = R(g[j - std::ptrdiff_t(Window)]) - k;
+            ds[j] = a - o;
+            dq[j] = (a - o) * (a + o);
+        }
+        for (std::ptrdiff_t j = 0; j < b; ++j) {
+            s += ds[j];
+            q += dq[j];
+            ds[j] = s;
+            dq[j] = q;
+        }
+        for (std::ptrdiff_t j = 0; j < b; ++j) {
+            *out = emit(ds[j], dq[j]);
+            ++out;
+        }
+        g += b;
+    }
+    return out;
+}
+
+} // namespace detail
+
+template <std::size_t Window, RandomAccessIterator I, Iterator O, Real R = double>
+    requires(Readable<I> && Writable<O>)
+O rolling_mean(I f, I l, O out) {
+    //precondition: readable_bounded_range(f, l) && writable_weak_range(out, (l - f) - Window + 1)
+    if (std::size_t(l - f) < Window) return out;
+    R k = R(*f);
+    R const inv = R(1) / R(Window);
+    return detail::rolling_sums<Window>(f, l, out, k, [k, inv](R s, R) { return k + s * inv; });
+}
+
+template <std::size_t Window, RandomAccessIterator I, Iterator O, Real R = double>
+    requires(Readable<I> && Writable<O>)
+O rolling_sample_variance(I f, I l, O out) {
+    //precondition: readable_bounded_range(f, l) && writable_weak_range(out, (l - f) - Window + 1)
+    //              && Window > 1
+    if (std::size_t(l - f) < Window) return out;
+    R k = R(*f);
+    R const inv = R(1) / R(Window);
+    R const inv1 = R(1) / R(Window - 1);
+    return detail::rolling_sums<Window>(f, l, out, k, [inv, inv1](R s, R q) {
+        R v = (q - s * s * inv) * inv1;
+        return v < R(0) ? R(0) : v;
+    });
+}
+
+template <std::size_t Window, RandomAccessIterator I, Iterator O, Real R = double>
+    requires(Readable<I> && Writable<O>)
+O rolling_population_variance(I f, I l, O out) {
+    //precondition: readable_bounded_range(f, l) && writable_weak_range(out, (l - f) - Window + 1)
+    if (std::size_t(l - f) < Window) return out;
+    R k = R(*f);
+    R const inv = R(1) / R(Window);
+    return detail::rolling_sums<Window>(f, l, out, k, [inv](R s, R q) {
+        R v = (q - s * s * inv) * inv;
+        return v < R(0) ? R(0) : v;
+    });
+}
+
+template <std::size_t Window, Iterator I, Iterator O, StrictWeakOrdering Rel>
+    requires(Readable<I> && Writable<O>)
+O rolling_extreme(I f, I l, O out, Rel) {
+    //precondition: readable_bounded_range(f, l)
+    detail::monotonic_queue<ValueType<I>, Window, Rel> q;
+    std::uint64_t t = 0;
+    while (f != l) {
+        q.push(*f, t);
+        ++t;
+        if (t >= Window) {
+            *out = q.front();
+            ++out;
+        }
+        ++f;
+    }
+    return out;
+}
+
+template <std::size_t Window, Iterator I, Iterator O>
+    requires(Readable<I> && Writable<O>)
+inline
+O rolling_min(I f, I l, O out) {
+    return rolling_extreme<Window>(f, l, out, std::less<ValueType<I>>{});
+}
+
+template <std::size_t Window, Iterator I, Iterator O>
+    requires(Readable<I> && Writable<O>)
+inline
+O rolling_max(I f, I l, O out) {
+    return rolling_extreme<Window>(f, l, out, std::greater<ValueType<I>>{});
+}
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_ROLLING_STATISTICS_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <algorithm>
+#include <vector>
+
+#include <tao/algorithm/statistics.hpp>
+
+TEST_CASE("[rolling_statistics] testing incremental rolling_statistics against statistics.hpp") {
+    using namespace tao::algorithm;
+    constexpr std::size_t w = 8;
+
+    std::vector<double> v;
+    for (int i = 0; i < 100; ++i) v.push_back(double((i * 37) % 23) + 1000.0);
+
+    rolling_statistics<double, w> rs;
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        rs.push(v[i]);
+        std::size_t n = (std::min)(i + 1, w);
+        auto f = v.begin() + (i + 1 - n);
+
+        CHECK(rs.size() == n);
+        CHECK(rs.mean() == doctest::Approx(mean_n(f, n)));
+        CHECK(rs.min() == *std::min_element(f, f + n));
+        CHECK(rs.max() == *std::max_element(f, f + n));
+        if (n > 1) {
+            CHECK(rs.sample_variance() == doctest::Approx(sample_variance_n(f, n)));
+        }
+    }
+}
+
+TEST_CASE("[rolling_statistics] testing that rolling_statistics does not drift on long streams") {
+    using namespace tao::algorithm;
+    constexpr std::size_t w = 16;
+
+    std::vector<float> v;
+    for (int i = 0; i < (1 << 20); ++i) v.push_back(1000.0f + float((i * 37) % 101) * 0.37f);
+
+    // Against the window summed afresh in double, two passes.
+    rolling_statistics<float, w> rs;
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        rs.push(v[i]);
+        if (i < w || i % 997 != 0) continue;
+        double s = 0;
+        for (std::size_t j = i + 1 - w; j != i + 1; ++j) s += v[j];
+        double const mean = s / w;
+        double q = 0;
+        for (std::size_t j = i + 1 - w; j != i + 1; ++j) q += (v[j] - mean) * (v[j] - mean);
+        CHECK(rs.mean() == doctest::Approx(mean).epsilon(1e-6));
+        CHECK(rs.population_variance() == doctest::Approx(q / w).epsilon(1e-3));
+    }
+}
+
+TEST_CASE("[rolling_statistics] testing batch rolling_mean, rolling_sample_variance, rolling_min, rolling_max") {
+    using namespace tao::algorithm;
+    constexpr std::size_t w = 5;
+
+    std::vector<int> v;
+    for (int i = 0; i < 1000; ++i) v.push_back((i * 7919) % 101);
+
+    std::size_t const m = v.size() - w + 1;
+    std::vector<double> means(m);
+    std::vector<double> vars(m);
+    std::vector<int> mins(m);
+    std::vector<int> maxs(m);
+
+    CHECK(rolling_mean<w>(v.begin(), v.end(), means.begin()) == means.end());
+    CHECK(rolling_sample_variance<w>(v.begin(), v.end(), vars.begin()) == vars.end());
+    CHECK(rolling_min<w>(v.begin(), v.end(), mins.begin()) == mins.end());
+    CHECK(rolling_max<w>(v.begin(), v.end(), maxs.begin()) == maxs.end());
+
+    for (std::size_t i = 0; i < m; ++i) {
+        auto f = v.begin() + i;
+        CHECK(means[i] == doctest::Approx(mean_n(f, w)));
+        CHECK(vars[i] == doctest::Approx(sample_variance_n(f, w)));
+        CHECK(mins[i] == *std::min_element(f, f + w));
+        CHECK(maxs[i] == *std::max_element(f, f + w));
+    }
+
+    std::vector<double> none;
+    CHECK(rolling_mean<w>(v.begin(), v.begin() + 3, none.begin()) == none.begin());
+}
+
+TEST_CASE("[rolling_statistics] testing that the batch rolling sums do not drift on long ranges") {
+    using namespace tao::algorithm;
+    constexpr std::size_t w = 16;
+    using It = std::vector<float>::const_iterator;
+    using Out = std::vector<float>::iterator;
+
+    std::vector<float> v;
+    for (int i = 0; i < (1 << 20); ++i) v.push_back(1000.0f + float((i * 37) % 101) * 0.37f);
+    std::size_t const m = v.size() - w + 1;
+    std::vector<float> means(m);
+    std::vector<float> vars(m);
+    rolling_mean<w, It, Out, float>(v.cbegin(), v.cend(), means.begin());
+    rolling_population_variance<w, It, Out, float>(v.cbegin(), v.cend(), vars.begin());
+
+    // Against the window summed afresh in double.
+    for (std::size_t i = 0; i < m; i += 997) {
+        double s = 0;
+        for (std::size_t j = i; j != i + w; ++j) s += v[j];
+        double const mean = s / w;
+        double q = 0;
+        for (std::size_t j = i; j != i + w; ++j) q += (v[j] - mean) * (v[j] - mean);
+        CHECK(means[i] == doctest::Approx(mean).epsilon(1e-6));
+        CHECK(vars[i] == doctest::Approx(q / w).epsilon(1e-3));
+    }
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -0,0 +1,122 @@
+//! \file tao/algorithm/run_length.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_RUN_LENGTH_HPP_
+#define TAO_ALGORITHM_RUN_LENGTH_HPP_
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/find.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao { namespace algorithm {
+
+//Complexity:
+//      Runtime:
+//          n - 1 applications of r
+//      Space:
+//          O(1)
+//
+// Writes {x, k} to out for every maximal run of k elements of [f, l) that
+// are r-equivalent to their predecessors, x being the first one of the
+// run. The ends of the runs come from find_adjacent_mismatch, which
+// compares whole vectors at a time on contiguous ranges of integers, float
+// or double with std::equal_to.
+template <ForwardIterator I, Iterator O, Relation R>
+    requires(Readable<I> && Writable<O> && Domain<R, ValueType<I>>)
+O run_length_encode(I f, I l, O out, R r) {
+    //precondition: readable_bounded_range(f, l)
+    while (f != l) {
+        I const m = tao::algorithm::find_adjacent_mismatch(f, l, r);
+        *out = std::make_pair(*f, std::distance(f, m));
+        ++out;
+        f = m;
+    }
+    return out;
+}
+
+template <ForwardIterator I, Iterator O>
+    requires(Readable<I> && Writable<O> && Regular<ValueType<I>>)
+inline
+O run_length_encode(I f, I l, O out) {
+    //precondition: readable_bounded_range(f, l)
+    return tao::algorithm::run_length_encode(f, l, out, std::equal_to<>{});
+}
+
+// The inverse of run_length_encode: k copies of x for every {x, k} of
+// [f, l).
+template <Iterator I, Iterator O>
+    requires(Readable<I> && Writable<O>)
+O run_length_decode(I f, I l, O out) {
+    //precondition: readable_bounded_range(f, l)
+    while (f != l) {
+        auto const& run = *f;
+        out = std::fill_n(out, run.second, run.first);
+        ++f;
+    }
+    return out;
+}
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_RUN_LENGTH_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <cstdint>
+#include <forward_list>
+#include <iterator>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST_CASE("[run_length] testing run_length_encode and run_length_decode") {
+    using namespace tao::algorithm;
+
+    std::string const s = "aaabccddddde";
+    std::vector<std::pair<char, std::ptrdiff_t>> runs;
+    run_length_encode(s.begin(), s.end(), std::back_inserter(runs));
+    std::vector<std::pair<char, std::ptrdiff_t>> const expected {{'a', 3}, {'b', 1}, {'c', 2}, {'d', 5}, {'e', 1}};
+    CHECK(runs == expected);
+    std::string decoded;
+    run_length_decode(runs.begin(), runs.end(), std::back_inserter(decoded));
+    CHECK(decoded == s);
+
+    std::string const empty;
+    runs.clear();
+    CHECK(run_length_encode(empty.begin(), empty.end(), runs.begin()) == runs.begin());
+
+    // Contiguous and vectorized, against a forward list.
+    std::mt19937 gen(50);
+    std::vector<std::int32_t> v;
+    while (v.size() < 5000) v.insert(v.end(), gen() % 200 + 1, std::int32_t(gen() % 3));
+    std::forward_list<std::int32_t> const l(v.begin(), v.end());
+    std::vector<std::pair<std::int32_t, std::ptrdiff_t>> rv;
+    std::vector<std::pair<std::int32_t, std::ptrdiff_t>> rl;
+    run_length_encode(v.begin(), v.end(), std::back_inserter(rv));
+    run_length_encode(l.begin(), l.end(), std::back_inserter(rl));
+    CHECK(rv == rl);
+    std::vector<std::int32_t> w;
+    run_length_decode(rv.begin(), rv.end(), std::back_inserter(w));
+    CHECK(w == v);
+
+    // Runs of elements in the same bucket of ten.
+    std::vector<int> const b {1, 5, 9, 10, 19, 25, 3};
+    std::vector<std::pair<int, std::ptrdiff_t>> rb;
+    run_length_encode(b.begin(), b.end(), std::back_inserter(rb), [](int x, int y) { return x / 10 == y / 10; });
+    std::vector<std::pair<int, std::ptrdiff_t>> const eb {{1, 3}, {10, 2}, {25, 1}, {3, 1}};
+    CHECK(rb == eb);
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
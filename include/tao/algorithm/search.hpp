@@ -10,17 +10,360 @@
 #define TAO_ALGORITHM_SEARCH_HPP
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iterator>
+#include <type_traits>
 #include <utility>
 
 #include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/integers.hpp>
+#include <tao/algorithm/simd.hpp>
 #include <tao/algorithm/type_attributes.hpp>
 
 namespace tao { namespace algorithm {
 
 
 //Note: std::search is wrong, because, in some cases we will need the last iterator.
-//TODO: Implement another search algorithms, like Boyer-Moore, ...
+
+// ------------------------------------------------------------------------
+// Byte search with a SIMD prefilter
+// ------------------------------------------------------------------------
+// For contiguous ranges of bytes. The first and the last byte of the
+// pattern are compared against 16 or 32 consecutive positions of the text
+// at once; only the positions where both match are verified with memcmp
+// (W. Mula, SIMD-friendly algorithms for substring searching).
+
+namespace detail {
+
+template <typename T>
+constexpr bool is_search_byte_v = (std::is_integral<T>::value && sizeof(T) == 1 &&
+                                   ! std::is_same<T, bool>::value) ||
+                                  std::is_same<T, std::byte>::value;
+
+template <Iterator I1, Iterator I2>
+constexpr bool byte_searchable() {
+    if constexpr (is_contiguous_iterator_v<I1> && is_contiguous_iterator_v<I2>) {
+        return is_search_byte_v<ValueType<I1>> &&
+               std::is_same<std::remove_cv_t<ValueType<I1>>, std::remove_cv_t<ValueType<I2>>>::value;
+    } else {
+        return false;
+    }
+}
+
+// Position of the first occurrence at or after i, n if none.
+inline
+std::size_t search_bytes_scalar(unsigned char const* s, std::size_t n,
+                                unsigned char const* p, std::size_t m, std::size_t i) {
+    // precondition: m >= 2
+    for (; i + m <= n; ++i) {
+        if (s[i] == p[0] && s[i + m - 1] == p[m - 1] && std::memcmp(s + i + 1, p + 1, m - 2) == 0) return i;
+    }
+    return n;
+}
+
+#if defined(TAO_ALGORITHM_SIMD_X86)
+TAO_ALGORITHM_TARGET_AVX2
+inline
+std::size_t search_bytes_avx2(unsigned char const* s, std::size_t n, unsigned char const* p, std::size_t m) {
+    // precondition: m >= 2
+    __m256i const first = _mm256_set1_epi8(char(p[0]));
+    __m256i const last = _mm256_set1_epi8(char(p[m - 1]));
+    std::size_t i = 0;
+    for (; i + m + 31 <= n; i += 32) {
+        __m256i const bf = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(s + i));
+        __m256i const bl = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(s + i + m - 1));
+        auto mask = std::uint32_t(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(last, bl))));
+        while (mask != 0) {
+            std::size_t const j = i + std::size_t(count_trailing_zeros(mask));
+            if (std::memcmp(s + j + 1, p + 1, m - 2) == 0) return j;
+            mask &= mask - 1;
+        }
+    }
+    return search_bytes_scalar(s, n, p, m, i);
+}
+
+TAO_ALGORITHM_TARGET_SSE2
+inline
+std::size_t search_bytes_sse2(unsigned char const* s, std::size_t n, unsigned char const* p, std::size_t m) {
+    // precondition: m >= 2
+    __m128i const first = _mm_set1_epi8(char(p[0]));
+    __m128i const last = _mm_set1_epi8(char(p[m - 1]));
+    std::size_t i = 0;
+    for (; i + m + 15 <= n; i += 16) {
+        __m128i const bf = _mm_loadu_si128(reinterpret_cast<__m128i const*>(s + i));
+        __m128i const bl = _mm_loadu_si128(reinterpret_cast<__m128i const*>(s + i + m - 1));
+        auto mask = std::uint32_t(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(last, bl))));
+        while (mask != 0) {
+            std::size_t const j = i + std::size_t(count_trailing_zeros(mask));
+            if (std::memcmp(s + j + 1, p + 1, m - 2) == 0) return j;
+            mask &= mask - 1;
+        }
+    }
+    return search_bytes_scalar(s, n, p, m, i);
+}
+#endif
+
+// Position of the first occurrence of [p, p + m) in [s, s + n), n if none.
+inline
+std::size_t search_bytes(void const* text, std::size_t n, void const* pattern, std::size_t m) {
+    auto const s = static_cast<unsigned char const*>(text);
+    auto const p = static_cast<unsigned char const*>(pattern);
+    if (m == 0) return 0;
+    if (m > n) return n;
+    if (m == 1) {
+        auto const r = static_cast<unsigned char const*>(std::memchr(s, p[0], n));
+        return r == nullptr ? n : std::size_t(r - s);
+    }
+#if defined(TAO_ALGORITHM_SIMD_X86)
+    switch (simd_isa_level()) {
+        case simd_isa::avx512:
+        case simd_isa::avx2: return search_bytes_avx2(s, n, p, m);
+        case simd_isa::sse2: return search_bytes_sse2(s, n, p, m);
+        default: break;
+    }
+#endif
+    return search_bytes_scalar(s, n, p, m, 0);
+}
+
+template <RandomAccessIterator I>
+inline
+void const* search_address(I f) {
+    return static_cast<void const*>(std::addressof(*f));
+}
+
+} // namespace detail
+
+// ------------------------------------------------------------------------
+// Searchers
+// ------------------------------------------------------------------------
+// A searcher is built once from the pattern [fs, ls), which it does not
+// copy, and is then applied to any number of texts: s(f, l) returns
+// {match_first, match_last} of the first occurrence in [f, l), or {l, l}
+// if there is none, as search() does.
+
+// Contiguous ranges of bytes, with the SIMD prefilter.
+template <RandomAccessIterator I>
+    requires(Readable<I>)
+struct byte_searcher {
+    static_assert(is_contiguous_iterator_v<I> && detail::is_search_byte_v<ValueType<I>>,
+                  "byte_searcher needs a contiguous range of bytes");
+
+    byte_searcher(I fs, I ls) : fs(fs), m(std::size_t(ls - fs)) {}
+
+    //Complexity:
+    //      Runtime:
+    //          O(n) (n / 32 vector steps) plus O(m) per position where the
+    //          first and the last byte of the pattern match
+    //      Space:
+    //          O(1)
+    template <RandomAccessIterator J>
+        requires(Readable<J>)
+    std::pair<J, J> operator()(J f, J l) const {
+        static_assert(detail::byte_searchable<J, I>(), "byte_searcher needs a contiguous range of bytes");
+        if (m == 0) return {f, f};
+        auto const n = std::size_t(l - f);
+        if (n < m) return {l, l};
+        std::size_t const i = detail::search_bytes(detail::search_address(f), n, detail::search_address(fs), m);
+        if (i == n) return {l, l};
+        return {f + i, f + (i + m)};
+    }
+
+    I fs;
+    std::size_t m;
+};
+
+namespace detail {
+
+// Shifts of Horspool's algorithm, indexed by the text element aligned with
+// the last one of the pattern: a direct table for bytes, the low byte of
+// std::hash for anything else. Elements that share a slot keep the
+// smallest shift, which is still safe.
+template <Regular T, Integer D>
+struct horspool_table {
+    explicit
+    horspool_table(D m) { table.fill(m); }
+
+    // The shifts are set by increasing position, the last one is the smallest.
+    void set(T const& x, D s) { table[slot(x)] = s; }
+    D operator[](T const& x) const { return table[slot(x)]; }
+
+    static
+    std::uint8_t slot(T const& x) {
+        if constexpr (is_search_byte_v<T>) {
+            return std::uint8_t(x);
+        } else {
+            return std::uint8_t(std::hash<T>{}(x));
+        }
+    }
+
+    std::array<D, 256> table;
+};
+
+} // namespace detail
+
+// Boyer-Moore-Horspool: the pattern is compared from its last element and
+// shifted by the distance from the last occurrence, in the pattern
+// without its last element, of the text element under that last element.
+template <RandomAccessIterator I>
+    requires(Readable<I>)
+struct horspool_searcher {
+    using D = DistanceType<I>;
+
+    horspool_searcher(I fs, I ls)
+        : fs(fs)
+        , m(ls - fs)
+        , skip(ls - fs)
+    {
+        // precondition: readable_bounded_range(fs, ls)
+        for (D i = 0; i + 1 < m; ++i) skip.set(fs[i], m - 1 - i);
+    }
+
+    //Complexity:
+    //      Runtime:
+    //          O(n m) worst case, O(n / m) steps on random texts
+    //      Space:
+    //          O(1), the table is built by the constructor
+    template <RandomAccessIterator J>
+        requires(Readable<J>)
+    std::pair<J, J> operator()(J f, J l) const {
+        if (m == 0) return {f, f};
+        auto const& last = fs[m - 1];
+        while (l - f >= m) {
+            auto const& x = f[m - 1];
+            if (x == last && std::equal(fs, fs + (m - 1), f)) return {f, f + m};
+            f += skip[x];
+        }
+        return {l, l};
+    }
+
+    I fs;
+    D m;
+    detail::horspool_table<std::remove_cv_t<ValueType<I>>, D> skip;
+};
+
+namespace detail {
+
+// Maximal suffix of [x, x + m) for the order r, and its period
+// (Crochemore and Perrin). The suffix starts at position ms + 1.
+template <RandomAccessIterator I, Relation R>
+std::pair<DistanceType<I>, DistanceType<I>> maximal_suffix(I x, DistanceType<I> m, R r) {
+    using D = DistanceType<I>;
+    D ms = -1;
+    D j = 0;
+    D k = 1;
+    D p = 1;
+    while (j + k < m) {
+        auto const& a = x[j + k];
+        auto const& b = x[ms + k];
+        if (r(a, b)) {
+            j += k;
+            k = 1;
+            p = j - ms;
+        } else if (a == b) {
+            if (k != p) {
+                ++k;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            ms = j;
+            j = ms + 1;
+            k = 1;
+            p = 1;
+        }
+    }
+    return {ms, p};
+}
+
+} // namespace detail
+
+// Crochemore-Perrin Two-Way: the pattern is split at a critical
+// factorization x = u v; v is matched left to right, then u right to
+// left, and the shifts use the period of the pattern. Linear in the worst
+// case with constant extra space; needs an order on the elements.
+template <RandomAccessIterator I>
+    requires(Readable<I> && TotallyOrdered<ValueType<I>>)
+struct two_way_searcher {
+    using D = DistanceType<I>;
+
+    two_way_searcher(I fs, I ls)
+        : fs(fs)
+        , m(ls - fs)
+    {
+        // precondition: readable_bounded_range(fs, ls)
+        if (m == 0) return;
+        auto const a = detail::maximal_suffix(fs, m, [](auto const& x, auto const& y) { return x < y; });
+        auto const b = detail::maximal_suffix(fs, m, [](auto const& x, auto const& y) { return y < x; });
+        ell = a.first > b.first ? a.first : b.first;
+        period = a.first > b.first ? a.second : b.second;
+        periodic = ell + 1 + period <= m && std::equal(fs, fs + (ell + 1), fs + period);
+        if ( ! periodic) period = (std::max)(ell + 1, m - ell - 1) + 1;
+    }
+
+    //Complexity:
+    //      Runtime:
+    //          at most 2 n comparisons
+    //      Space:
+    //          O(1)
+    template <RandomAccessIterator J>
+        requires(Readable<J>)
+    std::pair<J, J> operator()(J f, J l) const {
+        if (m == 0) return {f, f};
+        D const n = D(l - f);
+        D j = 0;
+        if (periodic) {
+            D memory = -1;
+            while (j <= n - m) {
+                D i = (std::max)(ell, memory) + 1;
+                while (i < m && fs[i] == f[i + j]) ++i;
+                if (i >= m) {
+                    i = ell;
+                    while (i > memory && fs[i] == f[i + j]) --i;
+                    if (i <= memory) return {f + j, f + (j + m)};
+                    j += period;
+                    memory = m - period - 1;
+                } else {
+                    j += i - ell;
+                    memory = -1;
+                }
+            }
+        } else {
+            while (j <= n - m) {
+                D i = ell + 1;
+                while (i < m && fs[i] == f[i + j]) ++i;
+                if (i >= m) {
+                    i = ell;
+                    while (i >= 0 && fs[i] == f[i + j]) --i;
+                    if (i < 0) return {f + j, f + (j + m)};
+                    j += period;
+                } else {
+                    j += i - ell;
+                }
+            }
+        }
+        return {l, l};
+    }
+
+    I fs;
+    D m;
+    D ell = -1;         // the critical factorization is [fs, fs + ell + 1) [fs + ell + 1, ls)
+    D period = 1;
+    bool periodic = false;
+};
+
+template <ForwardIterator I, typename S>
+    requires(Readable<I>)
+inline
+std::pair<I, I> search(I f, I l, S const& searcher) {
+    return searcher(f, l);
+}
 
 //Complexity:
 //      Runtime:
@@ -32,6 +375,9 @@ template <ForwardIterator I1, ForwardIterator I2>
 // requires(Readable(I1) && Readable(I2) && ValueType(I1) == ValueType(I2) TODO???)
 std::pair<I1, I1> search(I1 f, I1 l, I2 fs, I2 ls) {
     // precondition: readable_weak_range(f, l) && readable_weak_range(fs, ls) TODO???
+    if constexpr (detail::byte_searchable<I1, I2>()) {
+        return byte_searcher<I2>(fs, ls)(f, l);
+    }
 
     while (true) {
         I1 it = f;
@@ -60,6 +406,15 @@ template <ForwardIterator I1, ForwardIterator I2>
 // requires(Readable(I1) && Readable(I2) && ValueType(I1) == ValueType(I2) TODO???)
 std::pair<I1, DistanceType<I1>> search_counted_range(I1 f, DistanceType<I1> n, I2 fs, DistanceType<I2> ns) {
     // Precondition: readable_weak_range(f, n) && readable_weak_range(fs, ns) TODO???
+    if constexpr (detail::byte_searchable<I1, I2>()) {
+        if (ns == 0) return std::make_pair(f, 0);
+        if (n < ns) return std::make_pair(f, 0);
+        std::size_t const i = detail::search_bytes(detail::search_address(f), std::size_t(n),
+                                                   detail::search_address(fs), std::size_t(ns));
+        // Not found: where the loop below stops, after the last candidate.
+        if (i == std::size_t(n)) return std::make_pair(f + (n - ns + 1), 0);
+        return std::make_pair(f + DistanceType<I1>(i), ns);
+    }
 
     while (n >= ns) {
         I1 it = f;
@@ -84,7 +439,248 @@ std::pair<I1, DistanceType<I1>> search_counted_range(I1 f, DistanceType<I1> n, I
     return std::make_pair(f, 0);
 }
 
+namespace detail {
+
+template <ForwardIterator I, Relation R>
+std::pair<I, I> search_n(I f, I l, DistanceType<I> k, ValueType<I> const& x, R r, std::forward_iterator_tag) {
+    DistanceType<I> run = 0;
+    I start = f;
+    while (f != l) {
+        if ( ! r(*f, x)) {
+            run = 0;
+        } else {
+            if (run == 0) start = f;
+            if (++run == k) return std::make_pair(start, std::next(f));
+        }
+        ++f;
+    }
+    return std::make_pair(l, l);
+}
+
+// The last element of the window [s, s + k) is tested first and the window
+// is scanned backwards. A mismatch at j rules out every window holding j,
+// so the next one starts at j + 1, and the matches already seen between j
+// and the end of the window are not tested again: when the elements that
+// end the windows do not match, k positions are skipped per test.
+template <RandomAccessIterator I, Relation R>
+std::pair<I, I> search_n(I f, I l, DistanceType<I> k, ValueType<I> const& x, R r, std::random_access_iterator_tag) {
+    using N = DistanceType<I>;
+    N const n = l - f;
+    N s = 0;
+    N known = 0;        // [s, s + known) is known to match
+    while (n - s >= k) {
+        N j = s + k;
+        N const stop = s + known;
+        while (j != stop && r(f[j - 1], x)) --j;
+        if (j == stop) return std::make_pair(f + s, f + (s + k));
+        known = s + k - j;
+        s = j;
+    }
+    return std::make_pair(l, l);
+}
+
+} // namespace detail
+
+//Complexity:
+//      Runtime:
+//          O(n) applications of r; on random access ranges about n / k
+//          when the matches are sparse
+//      Space:
+//          O(1)
+//
+// The first k consecutive elements y of [f, l) with r(y, x), as
+// {match_first, match_last}; {l, l} if there are none. Unlike
+// search_counted_range, the semantics of std::search_n.
+template <ForwardIterator I, Relation R>
+    requires(Readable<I> && Domain<R, ValueType<I>>)
+std::pair<I, I> search_n(I f, I l, DistanceType<I> k, ValueType<I> const& x, R r) {
+    //precondition: readable_bounded_range(f, l)
+    if (k <= 0) return std::make_pair(f, f);
+    return detail::search_n(f, l, k, x, r, IteratorCategory<I>{});
+}
+
+template <ForwardIterator I>
+    requires(Readable<I> && Regular<ValueType<I>>)
+inline
+std::pair<I, I> search_n(I f, I l, DistanceType<I> k, ValueType<I> const& x) {
+    //precondition: readable_bounded_range(f, l)
+    return tao::algorithm::search_n(f, l, k, x, std::equal_to<>{});
+}
+
+// search() as a searcher, for ForwardIterators.
+template <ForwardIterator I>
+    requires(Readable<I>)
+struct naive_searcher {
+    naive_searcher(I fs, I ls) : fs(fs), ls(ls) {}
+
+    template <ForwardIterator J>
+        requires(Readable<J>)
+    std::pair<J, J> operator()(J f, J l) const {
+        return tao::algorithm::search(f, l, fs, ls);
+    }
+
+    I fs;
+    I ls;
+};
+
+namespace detail {
+
+template <typename T, typename = void>
+struct is_hashable : std::false_type {};
+
+template <typename T>
+struct is_hashable<T, std::void_t<decltype(std::hash<T>{}(std::declval<T const&>()))>> : std::true_type {};
+
+} // namespace detail
+
+// The searcher for a text of I1 and a pattern of I2 that is applied many
+// times: search() itself on contiguous bytes, Horspool on other random
+// access ranges (bytes or hashable values), search() otherwise.
+template <ForwardIterator I1, ForwardIterator I2>
+    requires(Readable<I1> && Readable<I2>)
+auto make_searcher(I2 fs, I2 ls) {
+    using T = std::remove_cv_t<ValueType<I2>>;
+    if constexpr ( ! detail::byte_searchable<I1, I2>() &&
+                  std::is_base_of<std::random_access_iterator_tag, IteratorCategory<I1>>::value &&
+                  std::is_base_of<std::random_access_iterator_tag, IteratorCategory<I2>>::value &&
+                  (detail::is_search_byte_v<T> || detail::is_hashable<T>::value)) {
+        return horspool_searcher<I2>(fs, ls);
+    } else {
+        return naive_searcher<I2>(fs, ls);
+    }
+}
 
 }} /*tao::algorithm*/
 
 #endif /*TAO_ALGORITHM_SEARCH_HPP*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <cstdint>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("[search] testing searchers against std::search") {
+    using namespace tao::algorithm;
+
+    std::mt19937 gen(41);
+    for (int alphabet : {2, 4, 26}) {
+        std::uniform_int_distribution<int> dist(0, alphabet - 1);
+        for (int round = 0; round < 60; ++round) {
+            std::string text(std::size_t(gen() % 300), ' ');
+            for (auto& c : text) c = char('a' + dist(gen));
+            std::string pattern(std::size_t(gen() % 12), ' ');
+            for (auto& c : pattern) c = char('a' + dist(gen));
+            // Half of the patterns are taken from the text, so that they match.
+            if (round % 2 == 0 && pattern.size() <= text.size()) {
+                auto const p = gen() % (text.size() - pattern.size() + 1);
+                pattern = text.substr(p, pattern.size());
+            }
+
+            auto const expected = std::search(text.begin(), text.end(), pattern.begin(), pattern.end());
+            auto const expected_last = expected == text.end() ? text.end() : expected + pattern.size();
+            auto check = [&](std::pair<std::string::iterator, std::string::iterator> r) {
+                CHECK(r.first == expected);
+                CHECK(r.second == expected_last);
+            };
+            check(tao::algorithm::search(text.begin(), text.end(), horspool_searcher<std::string::iterator>(pattern.begin(), pattern.end())));
+            check(tao::algorithm::search(text.begin(), text.end(), two_way_searcher<std::string::iterator>(pattern.begin(), pattern.end())));
+            check(tao::algorithm::search(text.begin(), text.end(), byte_searcher<std::string::iterator>(pattern.begin(), pattern.end())));
+            check(tao::algorithm::search(text.begin(), text.end(), pattern.begin(), pattern.end()));
+        }
+    }
+}
+
+TEST_CASE("[search] testing searchers on periodic patterns and non-byte values") {
+    using namespace tao::algorithm;
+
+    for (std::string pattern : {"aaaa", "abab", "abaabaab", "aab", "ba"}) {
+        for (std::string text : {"aaaaaaaa", "aaabaaab", "abababab", "babaabaabaab", "abaababaab", "bbbbbb", "b"}) {
+            auto const expected = std::search(text.begin(), text.end(), pattern.begin(), pattern.end());
+            using It = std::string::iterator;
+            CHECK(two_way_searcher<It>(pattern.begin(), pattern.end())(text.begin(), text.end()).first == expected);
+            CHECK(horspool_searcher<It>(pattern.begin(), pattern.end())(text.begin(), text.end()).first == expected);
+        }
+    }
+
+    std::vector<int> v;
+    for (int i = 0; i < 500; ++i) v.push_back(i % 7 == 0 ? 1000000 + i % 3 : i % 5);
+    std::vector<int> p(v.begin() + 321, v.begin() + 340);
+    using It = std::vector<int>::iterator;
+    auto const expected = std::search(v.begin(), v.end(), p.begin(), p.end());
+    CHECK(horspool_searcher<It>(p.begin(), p.end())(v.begin(), v.end()).first == expected);
+    CHECK(two_way_searcher<It>(p.begin(), p.end())(v.begin(), v.end()).first == expected);
+    CHECK(tao::algorithm::search(v.begin(), v.end(), p.begin(), p.end()).first == expected);
+    p.back() = -1;
+    CHECK(horspool_searcher<It>(p.begin(), p.end())(v.begin(), v.end()).first == v.end());
+    CHECK(two_way_searcher<It>(p.begin(), p.end())(v.begin(), v.end()).first == v.end());
+
+    std::string const empty;
+    std::string text = "abc";
+    auto const r = two_way_searcher<std::string::const_iterator>(empty.begin(), empty.end())(text.begin(), text.end());
+    CHECK(r.first == text.begin());
+    CHECK(r.second == text.begin());
+}
+
+TEST_CASE("[search] testing the byte search at every ISA level") {
+    using namespace tao::algorithm;
+
+    std::mt19937 gen(7);
+    std::vector<std::uint8_t> text(1000);
+    for (auto& x : text) x = std::uint8_t(gen() % 3);
+    for (auto isa : {simd_isa::scalar, simd_isa::sse2, simd_isa::avx2, simd_isa::avx512}) {
+        set_simd_isa_limit(isa);
+        for (std::size_t m : {1, 2, 3, 5, 17, 33, 40}) {
+            for (int round = 0; round < 20; ++round) {
+                std::vector<std::uint8_t> pattern(m);
+                auto const p = gen() % (text.size() - m + 1);
+                std::copy(text.begin() + p, text.begin() + p + m, pattern.begin());
+                if (round % 3 == 0) pattern[m / 2] = 7;
+                auto const expected = std::search(text.begin(), text.end(), pattern.begin(), pattern.end());
+                CHECK(tao::algorithm::search(text.begin(), text.end(), pattern.begin(), pattern.end()).first == expected);
+
+                // search_counted_range keeps its not-found convention.
+                auto const n = std::ptrdiff_t(gen() % text.size());
+                auto const r = tao::algorithm::search_counted_range(text.data(), n, pattern.data(), std::ptrdiff_t(m));
+                std::list<std::uint8_t> const ts(text.begin(), text.end());
+                std::list<std::uint8_t> const ps(pattern.begin(), pattern.end());
+                auto const rs = tao::algorithm::search_counted_range(ts.begin(), n, ps.begin(), std::ptrdiff_t(m));
+                CHECK(r.first - text.data() == std::distance(ts.begin(), rs.first));
+                CHECK(r.second == rs.second);
+            }
+        }
+    }
+    set_simd_isa_limit(simd_isa::avx512);
+}
+
+TEST_CASE("[search] testing search_n against std::search_n") {
+    using namespace tao::algorithm;
+
+    std::mt19937 gen(50);
+    for (int round = 0; round < 200; ++round) {
+        std::vector<int> v(gen() % 200);
+        for (auto& x : v) x = gen() % 4 == 0 ? 2 : 1;
+        std::list<int> const l(v.begin(), v.end());
+        for (std::ptrdiff_t k : {0, 1, 2, 3, 5, 8}) {
+            for (int x : {1, 2}) {
+                auto const e = std::search_n(v.begin(), v.end(), k, x);
+                auto const e_last = e == v.end() ? v.end() : e + k;
+                auto const r = tao::algorithm::search_n(v.begin(), v.end(), k, x);
+                CHECK(r.first == e);
+                CHECK(r.second == e_last);
+                auto const rl = tao::algorithm::search_n(l.begin(), l.end(), k, x);
+                CHECK(std::distance(l.begin(), rl.first) == e - v.begin());
+                CHECK(std::distance(l.begin(), rl.second) == e_last - v.begin());
+            }
+        }
+        // A relation other than equality: k consecutive elements less than 2.
+        auto const lt = [](int y, int z) { return y < z; };
+        auto const e = std::search_n(v.begin(), v.end(), 4, 2, lt);
+        CHECK(tao::algorithm::search_n(v.begin(), v.end(), 4, 2, lt).first == e);
+    }
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
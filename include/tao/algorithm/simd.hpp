@@ -0,0 +1,172 @@
+//! \file tao/algorithm/simd.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_SIMD_HPP_
+#define TAO_ALGORITHM_SIMD_HPP_
+
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+// Runtime ISA dispatch is available with GCC and Clang on x86. Kernels are
+// compiled once per ISA through target attributes, the translation units
+// themselves do not need -mavx2 or similar flags.
+// Define TAO_ALGORITHM_NO_SIMD to force the portable code paths.
+#if ! defined(TAO_ALGORITHM_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TAO_ALGORITHM_SIMD_X86 1
+#define TAO_ALGORITHM_TARGET_SSE2   __attribute__((target("sse2")))
+#define TAO_ALGORITHM_TARGET_AVX2   __attribute__((target("avx2,bmi,bmi2,popcnt")))
+#define TAO_ALGORITHM_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl,avx2,bmi,bmi2,popcnt")))
+#define TAO_ALGORITHM_TARGET_AVX512_IFMA __attribute__((target("avx512ifma,avx512f,avx512bw,avx512dq,avx512vl,avx2,bmi,bmi2,popcnt")))
+#define TAO_ALGORITHM_ALWAYS_INLINE inline __attribute__((always_inline))
+// Kernels that read whole aligned vectors around the ends of a range (never
+// past the page of an element of the range) are exempt from AddressSanitizer.
+#define TAO_ALGORITHM_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#include <immintrin.h>
+#else
+#define TAO_ALGORITHM_ALWAYS_INLINE inline
+#define TAO_ALGORITHM_NO_SANITIZE_ADDRESS
+#endif
+
+// Read prefetch into all the cache levels, a hint only: any address is valid.
+#if defined(__GNUC__) || defined(__clang__)
+#define TAO_ALGORITHM_PREFETCH(p) __builtin_prefetch((p), 0, 3)
+#else
+#define TAO_ALGORITHM_PREFETCH(p) ((void)(p))
+#endif
+
+// Full unrolling of the fixed trip count lane loops keeps the accumulators in registers.
+#if defined(__clang__)
+#define TAO_ALGORITHM_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+#define TAO_ALGORITHM_UNROLL _Pragma("GCC unroll 64")
+#else
+#define TAO_ALGORITHM_UNROLL
+#endif
+
+namespace tao { namespace algorithm {
+
+// ------------------------------------------------------------------------
+// Instruction set detection
+// ------------------------------------------------------------------------
+
+enum class simd_isa { scalar = 0, sse2 = 1, avx2 = 2, avx512 = 3 };
+
+namespace detail {
+
+inline
+simd_isa detect_simd_isa() {
+#if defined(TAO_ALGORITHM_SIMD_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl")) {
+        return simd_isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2") &&
+        __builtin_cpu_supports("popcnt")) {
+        return simd_isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) return simd_isa::sse2;
+#endif
+    return simd_isa::scalar;
+}
+
+inline
+std::atomic<int>& simd_isa_limit_storage() {
+    static std::atomic<int> limit{int(simd_isa::avx512)};
+    return limit;
+}
+
+} // namespace detail
+
+// Best instruction set supported by the running CPU.
+inline
+simd_isa simd_isa_supported() {
+    static simd_isa const isa = detail::detect_simd_isa();
+    return isa;
+}
+
+// Caps the instruction set used by the dispatched kernels (testing, benchmarking).
+inline
+void set_simd_isa_limit(simd_isa isa) {
+    detail::simd_isa_limit_storage().store(int(isa), std::memory_order_relaxed);
+}
+
+// Instruction set the dispatched kernels use.
+inline
+simd_isa simd_isa_level() {
+    int limit = detail::simd_isa_limit_storage().load(std::memory_order_relaxed);
+    int supported = int(simd_isa_supported());
+    return simd_isa(limit < supported ? limit : supported);
+}
+
+// AVX-512 IFMA (52-bit integer multiply-add) on top of the AVX-512 level.
+inline
+bool simd_ifma_available() {
+#if defined(TAO_ALGORITHM_SIMD_X86)
+    static bool const ifma = __builtin_cpu_supports("avx512ifma");
+    return ifma && simd_isa_level() == simd_isa::avx512;
+#else
+    return false;
+#endif
+}
+
+// ------------------------------------------------------------------------
+// Contiguous iterators
+// ------------------------------------------------------------------------
+// C++17 has no contiguous_iterator_tag; pointers and the iterators of
+// std::vector (but not std::vector<bool>) and std::basic_string are
+// recognized.
+
+namespace detail {
+
+template <Iterator I, bool = std::is_object<ValueType<I>>::value &&
+                             ! std::is_same<ValueType<I>, bool>::value>
+struct is_vector_iterator : std::false_type {};
+
+template <Iterator I>
+struct is_vector_iterator<I, true>
+    : std::integral_constant<bool,
+        std::is_same<I, typename std::vector<ValueType<I>>::iterator>::value ||
+        std::is_same<I, typename std::vector<ValueType<I>>::const_iterator>::value>
+{};
+
+template <Iterator I>
+struct is_string_iterator
+    : std::integral_constant<bool,
+        std::is_same<I, std::string::iterator>::value ||
+        std::is_same<I, std::string::const_iterator>::value>
+{};
+
+} // namespace detail
+
+template <Iterator I>
+struct is_contiguous_iterator
+    : std::integral_constant<bool,
+        std::is_pointer<I>::value ||
+        detail::is_vector_iterator<I>::value ||
+        detail::is_string_iterator<I>::value>
+{};
+
+template <Iterator I>
+constexpr bool is_contiguous_iterator_v = is_contiguous_iterator<I>::value;
+
+// Arithmetic types the SIMD kernels handle: integers of 1 to 8 bytes, float and double.
+template <typename T>
+constexpr bool is_simd_arithmetic_v = (std::is_integral<T>::value && ! std::is_same<T, bool>::value) ||
+                                      std::is_same<T, float>::value ||
+                                      std::is_same<T, double>::value;
+
+}} /*tao::algorithm*/
+
+#endif /*TAO_ALGORITHM_SIMD_HPP_*/
@@ -0,0 +1,154 @@
+//! \file tao/algorithm/sorting/counter_merge_sort.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// C++ Standard used: C++17
+
+#ifndef TAO_ALGORITHM_SORTING_COUNTER_MERGE_SORT_HPP_
+#define TAO_ALGORITHM_SORTING_COUNTER_MERGE_SORT_HPP_
+
+#include <cstddef>
+#include <forward_list>
+#include <functional>
+#include <list>
+#include <utility>
+
+#include <tao/algorithm/binary_counter/add_to_counter.hpp>
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/type_attributes.hpp>
+
+namespace tao { namespace algorithm {
+
+namespace detail {
+
+template <Regular T, typename A>
+inline
+void splice_front(std::forward_list<T, A>& to, std::forward_list<T, A>& from) {
+    //precondition: !from.empty()
+    to.splice_after(to.before_begin(), from, from.before_begin());
+}
+
+template <Regular T, typename A>
+inline
+void splice_front(std::list<T, A>& to, std::list<T, A>& from) {
+    //precondition: !from.empty()
+    to.splice(to.begin(), from, from.begin());
+}
+
+// Binary operation of the counter: merges two sorted lists by relinking
+// their nodes. a holds the earlier elements, so the merge is stable.
+template <Sequence L, StrictWeakOrdering R>
+struct merge_lists {
+    R r;
+
+    L operator()(L& a, L& b) const {
+        a.merge(b, r);
+        return std::move(a);
+    }
+};
+
+} // namespace detail
+
+//Complexity:
+//      Runtime:
+//          Exact:     at most n * ceil(log2(n)) comparisons
+//      Space:
+//          O(1) (Size empty lists), no node is allocated, copied or moved
+//
+// Stepanov's binary counter merge sort (From Mathematics to Generic
+// Programming, 12.4): every node enters the counter as a one element list
+// and add_to_counter merges equal sized runs, so only O(log n) sorted runs
+// exist at any time. The sort is stable.
+template <Sequence L, StrictWeakOrdering R, std::size_t Size = 64>
+    requires(Domain<R, ValueType<IteratorType<L>>>)
+void counter_merge_sort(L& s, R r) {
+    //precondition: s.size() < 2^Size
+    using op_t = detail::merge_lists<L, R>;
+
+    L counter[Size];
+    L* l = counter;
+    L const z;
+    op_t op{r};
+
+    while ( ! s.empty()) {
+        L x;
+        detail::splice_front(x, s);
+        x = add_to_counter(counter, l, op, std::move(x), z);
+        if ( ! x.empty()) {
+            *l = std::move(x);
+            ++l;
+        }
+    }
+
+    // counter[0] holds the latest elements: reduce_counter order.
+    L x;
+    for (L* f = counter; f != l; ++f) {
+        if ( ! f->empty()) x = op(*f, x);
+    }
+    s.swap(x);
+}
+
+template <Sequence L>
+inline
+void counter_merge_sort(L& s) {
+    counter_merge_sort(s, std::less<>());
+}
+
+}} /*tao::algorithm*/
+
+#include <tao/algorithm/concepts_undef.hpp>
+
+#endif /*TAO_ALGORITHM_SORTING_COUNTER_MERGE_SORT_HPP_*/
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <algorithm>
+#include <vector>
+
+TEST_CASE("[counter_merge_sort] testing counter_merge_sort forward_list") {
+    using namespace tao::algorithm;
+    std::forward_list<int> a;
+    counter_merge_sort(a);
+    CHECK(a.empty());
+
+    a = {5};
+    counter_merge_sort(a);
+    CHECK(a == std::forward_list<int>{5});
+
+    a = {3, 6, 2, 1, 4, 5, 1, 6, 2, 3};
+    counter_merge_sort(a);
+    CHECK(a == std::forward_list<int>{1, 1, 2, 2, 3, 3, 4, 5, 6, 6});
+
+    counter_merge_sort(a, std::greater<>());
+    CHECK(a == std::forward_list<int>{6, 6, 5, 4, 3, 3, 2, 2, 1, 1});
+}
+
+TEST_CASE("[counter_merge_sort] testing counter_merge_sort list is stable and relinks nodes") {
+    using namespace tao::algorithm;
+    using T = std::pair<int, int>;
+
+    std::list<T> a;
+    for (int i = 0; i < 1000; ++i) a.emplace_back((i * 7919) % 31, i);
+
+    std::vector<T const*> before;
+    for (auto const& x : a) before.push_back(&x);
+
+    auto by_first = [](T const& x, T const& y) { return x.first < y.first; };
+    std::vector<T> expected(a.begin(), a.end());
+    std::stable_sort(expected.begin(), expected.end(), by_first);
+
+    counter_merge_sort(a, by_first);
+    CHECK(std::equal(a.begin(), a.end(), expected.begin(), expected.end()));
+
+    std::vector<T const*> after;
+    for (auto const& x : a) after.push_back(&x);
+    std::sort(before.begin(), before.end());
+    std::sort(after.begin(), after.end());
+    CHECK(before == after);
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
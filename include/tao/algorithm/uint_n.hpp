@@ -0,0 +1,656 @@
+//! \file tao/algorithm/uint_n.hpp
+// Tao.Algorithm
+//
+// Copyright (c) 2016-2021 Fernando Pelliccioni.
+//
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef TAO_ALGORITHM_UINT_N_HPP_
+#define TAO_ALGORITHM_UINT_N_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <tao/algorithm/concepts.hpp>
+#include <tao/algorithm/integers.hpp>
+#include <tao/algorithm/simd.hpp>
+
+namespace tao { namespace algorithm {
+
+// ------------------------------------------------------------------------
+// Fixed width unsigned integers
+// ------------------------------------------------------------------------
+// uint_n<Bits> is an unsigned integer of Bits bits, Bits a multiple of 64,
+// with the arithmetic modulo 2^Bits of the built-in unsigned types. It
+// models Integer: the arithmetic, bit and comparison operators, even, odd
+// and half, conversions from and to the built-in integers and
+// std::numeric_limits. The value is kept in 64-bit limbs, the least
+// significant first. Limb products are unsigned __int128 products (one
+// mul or mulx), quotients use Knuth's algorithm D with 128 by 64-bit
+// divisions.
+
+namespace detail {
+
+// a * b == hi * 2^64 + the returned low word.
+inline constexpr
+std::uint64_t multiply_64(std::uint64_t a, std::uint64_t b, std::uint64_t& hi) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 const p = (unsigned __int128)a * b;
+    hi = std::uint64_t(p >> 64);
+    return std::uint64_t(p);
+#else
+    std::uint64_t const a0 = a & 0xffffffff;
+    std::uint64_t const a1 = a >> 32;
+    std::uint64_t const b0 = b & 0xffffffff;
+    std::uint64_t const b1 = b >> 32;
+    std::uint64_t const p00 = a0 * b0;
+    std::uint64_t const p01 = a0 * b1;
+    std::uint64_t const p10 = a1 * b0;
+    std::uint64_t const mid = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+    hi = a1 * b1 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (p00 & 0xffffffff);
+#endif
+}
+
+// (hi * 2^64 + lo) / d, the remainder goes to r.
+inline constexpr
+std::uint64_t divide_128(std::uint64_t hi, std::uint64_t lo, std::uint64_t d, std::uint64_t& r) {
+    // precondition: hi < d
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 const n = ((unsigned __int128)hi << 64) | lo;
+    r = std::uint64_t(n % d);
+    return std::uint64_t(n / d);
+#else
+    std::uint64_t q = 0;
+    for (int i = 63; i >= 0; --i) {
+        bool const carry = (hi >> 63) != 0;
+        hi = (hi << 1) | ((lo >> i) & 1);
+        q <<= 1;
+        if (carry || hi >= d) {
+            hi -= d;
+            q |= 1;
+        }
+    }
+    r = hi;
+    return q;
+#endif
+}
+
+inline constexpr
+std::uint64_t add_carry(std::uint64_t a, std::uint64_t b, std::uint64_t& carry) {
+    std::uint64_t const s = a + carry;
+    std::uint64_t const c = s < carry;
+    std::uint64_t const t = s + b;
+    carry = c + (t < b);
+    return t;
+}
+
+inline constexpr
+std::uint64_t subtract_borrow(std::uint64_t a, std::uint64_t b, std::uint64_t& borrow) {
+    std::uint64_t const t = a - b - borrow;
+    borrow = std::uint64_t(a < b) | std::uint64_t(a - b < borrow);     // no branches
+    return t;
+}
+
+// r = a * b mod 2^(64 R); r does not overlap a or b.
+template <std::size_t N, std::size_t M, std::size_t R>
+constexpr
+void multiply_limbs(std::uint64_t const (&a)[N], std::uint64_t const (&b)[M], std::uint64_t (&r)[R]) {
+    constexpr std::size_t rows = N < R ? N : R;
+    for (auto& x : r) x = 0;
+    TAO_ALGORITHM_UNROLL
+    for (std::size_t i = 0; i < rows; ++i) {
+        if (a[i] == 0) continue;        // zero extended operands are common
+        std::uint64_t carry = 0;
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t j = 0; j < M; ++j) {
+            if (i + j >= R) continue;       // constant once the loops are unrolled
+            std::uint64_t hi = 0;
+            std::uint64_t lo = multiply_64(a[i], b[j], hi);
+            lo += carry;
+            hi += lo < carry;
+            std::uint64_t const t = r[i + j];
+            lo += t;
+            hi += lo < t;
+            r[i + j] = lo;
+            carry = hi;
+        }
+        if (i + M < R) r[i + M] = carry;    // not written by the previous rows
+    }
+}
+
+// Knuth's algorithm D (TAOCP 4.3.1), the divisor has n >= 2 limbs and u
+// has m >= n.
+template <std::size_t L>
+constexpr
+void divide_limbs_normalized(std::uint64_t const (&u)[L], std::uint64_t const (&v)[L],
+                             std::uint64_t (&q)[L], std::uint64_t (&r)[L],
+                             std::size_t m, std::size_t n) {
+    if constexpr (L > 1) {
+        // Normalize so that the top limb of the divisor has its high bit set,
+        // then the estimate of every quotient limb is at most 2 too large.
+        int const s = count_leading_zeros(v[n - 1]);
+        auto shl = [s](std::uint64_t hi, std::uint64_t lo) {
+            return s == 0 ? hi : (hi << s) | (lo >> (64 - s));
+        };
+        std::uint64_t vn[L] = {};
+        std::uint64_t un[L + 1] = {};
+        for (std::size_t i = n - 1; i > 0; --i) vn[i] = shl(v[i], v[i - 1]);
+        vn[0] = v[0] << s;
+        un[m] = shl(0, u[m - 1]);
+        for (std::size_t i = m - 1; i > 0; --i) un[i] = shl(u[i], u[i - 1]);
+        un[0] = u[0] << s;
+
+        std::uint64_t const top = vn[n - 1];
+        std::uint64_t const next = vn[n - 2];
+        for (std::size_t j = m - n + 1; j-- > 0; ) {
+            // qhat = (un[j + n] un[j + n - 1]) / top, refined with the next limb.
+            std::uint64_t qhat = 0;
+            std::uint64_t rhat = 0;
+            bool rhat_overflow = false;
+            if (un[j + n] >= top) {         // un[j + n] == top, the quotient limb is at most 2^64 - 1
+                qhat = ~std::uint64_t(0);
+                rhat = un[j + n - 1] + top;
+                rhat_overflow = rhat < top;
+            } else {
+                qhat = divide_128(un[j + n], un[j + n - 1], top, rhat);
+            }
+            while ( ! rhat_overflow) {
+                std::uint64_t hi = 0;
+                std::uint64_t const lo = multiply_64(qhat, next, hi);
+                if (hi < rhat || (hi == rhat && lo <= un[j + n - 2])) break;
+                --qhat;
+                rhat += top;
+                rhat_overflow = rhat < top;
+            }
+
+            // un[j, j + n] -= qhat * vn, add back once if it went negative.
+            std::uint64_t carry = 0;
+            std::uint64_t borrow = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                std::uint64_t hi = 0;
+                std::uint64_t lo = multiply_64(qhat, vn[i], hi);
+                lo += carry;
+                hi += lo < carry;
+                carry = hi;
+                un[i + j] = subtract_borrow(un[i + j], lo, borrow);
+            }
+            un[j + n] = subtract_borrow(un[j + n], carry, borrow);
+            if (borrow != 0) {
+                --qhat;
+                std::uint64_t c = 0;
+                for (std::size_t i = 0; i < n; ++i) un[i + j] = add_carry(un[i + j], vn[i], c);
+                un[j + n] += c;
+            }
+            q[j] = qhat;
+        }
+
+        for (std::size_t i = 0; i < n; ++i) {
+            r[i] = s == 0 ? un[i] : (un[i] >> s) | (un[i + 1] << (64 - s));
+        }
+    }
+}
+
+// q = u / v, r = u % v. One limb divisors need one 128 by 64-bit division
+// per limb of u.
+template <std::size_t L>
+constexpr
+void divide_limbs(std::uint64_t const (&u)[L], std::uint64_t const (&v)[L],
+                  std::uint64_t (&q)[L], std::uint64_t (&r)[L]) {
+    // precondition: v != 0
+    for (auto& x : q) x = 0;
+    for (auto& x : r) x = 0;
+    std::size_t n = L;
+    while (n > 1 && v[n - 1] == 0) --n;
+    std::size_t m = L;
+    while (m > 0 && u[m - 1] == 0) --m;
+
+    if (m < n) {
+        for (std::size_t i = 0; i < L; ++i) r[i] = u[i];
+        return;
+    }
+    if (L == 1 || n == 1) {
+        std::uint64_t rem = 0;
+        for (std::size_t i = m; i-- > 0; ) q[i] = divide_128(rem, u[i], v[0], rem);
+        r[0] = rem;
+        return;
+    }
+    divide_limbs_normalized(u, v, q, r, m, n);
+}
+
+} // namespace detail
+
+template <std::size_t Bits>
+struct uint_n {
+    static_assert(Bits > 0 && Bits % 64 == 0, "uint_n is made of 64-bit limbs");
+    static constexpr std::size_t limbs = Bits / 64;
+
+    constexpr
+    uint_n() = default;
+
+    // Negative values wrap around, as in the conversions to the built-in unsigned types.
+    // The 128-bit integers, integral in the gnu++ modes, have their own constructors.
+    template <typename T, typename std::enable_if<std::is_integral<T>::value && sizeof(T) <= 8, int>::type = 0>
+    constexpr
+    uint_n(T x) : limb{} {
+        limb[0] = std::uint64_t(x);
+        bool const negative = std::is_signed<T>::value && x < T(0);
+        for (std::size_t i = 1; i < limbs; ++i) limb[i] = negative ? ~std::uint64_t(0) : 0;
+    }
+
+#if defined(__SIZEOF_INT128__)
+    constexpr
+    uint_n(unsigned __int128 x) : limb{} {
+        limb[0] = std::uint64_t(x);
+        if (limbs > 1) limb[limbs > 1 ? 1 : 0] = std::uint64_t(x >> 64);
+    }
+
+    constexpr
+    uint_n(__int128 x) : uint_n((unsigned __int128)x) {
+        for (std::size_t i = 2; i < limbs; ++i) limb[i] = x < 0 ? ~std::uint64_t(0) : 0;
+    }
+
+    explicit constexpr
+    operator unsigned __int128() const {
+        return limbs > 1 ? ((unsigned __int128)limb[limbs > 1 ? 1 : 0] << 64) | limb[0] : limb[0];
+    }
+#endif
+
+    // Zero extension or truncation.
+    template <std::size_t B>
+    explicit constexpr
+    uint_n(uint_n<B> const& x) : limb{} {
+        for (std::size_t i = 0; i < limbs && i < uint_n<B>::limbs; ++i) limb[i] = x.limb[i];
+    }
+
+    // The low bits, as the conversions between built-in integers.
+    template <typename T, typename std::enable_if<std::is_integral<T>::value && ! std::is_same<T, bool>::value, int>::type = 0>
+    explicit constexpr
+    operator T() const { return T(limb[0]); }
+
+    explicit constexpr
+    operator bool() const { return ! is_zero(); }
+
+    constexpr
+    bool is_zero() const {
+        for (auto x : limb) if (x != 0) return false;
+        return true;
+    }
+
+    // Decimal digits, no sign or spaces.
+    static constexpr
+    uint_n from_decimal(char const* s) {
+        uint_n r;
+        for (; *s >= '0' && *s <= '9'; ++s) r = r * uint_n(10) + uint_n(*s - '0');
+        return r;
+    }
+
+    // Arithmetic ----------------------
+
+    friend constexpr
+    uint_n operator+(uint_n const& a, uint_n const& b) {
+        uint_n r;
+        std::uint64_t carry = 0;
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t i = 0; i < limbs; ++i) r.limb[i] = detail::add_carry(a.limb[i], b.limb[i], carry);
+        return r;
+    }
+
+    friend constexpr
+    uint_n operator-(uint_n const& a, uint_n const& b) {
+        uint_n r;
+        std::uint64_t borrow = 0;
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t i = 0; i < limbs; ++i) r.limb[i] = detail::subtract_borrow(a.limb[i], b.limb[i], borrow);
+        return r;
+    }
+
+    friend constexpr
+    uint_n operator-(uint_n const& a) { return uint_n() - a; }
+
+    friend constexpr
+    uint_n operator*(uint_n const& a, uint_n const& b) {
+        uint_n r;
+        detail::multiply_limbs(a.limb, b.limb, r.limb);
+        return r;
+    }
+
+    // {a / b, a % b}
+    friend constexpr
+    std::pair<uint_n, uint_n> quotient_remainder(uint_n const& a, uint_n const& b) {
+        // precondition: b != 0
+        std::pair<uint_n, uint_n> r;
+        detail::divide_limbs(a.limb, b.limb, r.first.limb, r.second.limb);
+        return r;
+    }
+
+    friend constexpr
+    uint_n operator/(uint_n const& a, uint_n const& b) { return quotient_remainder(a, b).first; }
+
+    friend constexpr
+    uint_n operator%(uint_n const& a, uint_n const& b) { return quotient_remainder(a, b).second; }
+
+    // Bit operations ----------------------
+
+    friend constexpr
+    uint_n operator&(uint_n const& a, uint_n const& b) {
+        uint_n r;
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t i = 0; i < limbs; ++i) r.limb[i] = a.limb[i] & b.limb[i];
+        return r;
+    }
+
+    friend constexpr
+    uint_n operator|(uint_n const& a, uint_n const& b) {
+        uint_n r;
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t i = 0; i < limbs; ++i) r.limb[i] = a.limb[i] | b.limb[i];
+        return r;
+    }
+
+    friend constexpr
+    uint_n operator^(uint_n const& a, uint_n const& b) {
+        uint_n r;
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t i = 0; i < limbs; ++i) r.limb[i] = a.limb[i] ^ b.limb[i];
+        return r;
+    }
+
+    friend constexpr
+    uint_n operator~(uint_n const& a) {
+        uint_n r;
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t i = 0; i < limbs; ++i) r.limb[i] = ~a.limb[i];
+        return r;
+    }
+
+    friend constexpr
+    uint_n operator<<(uint_n const& a, int s) {
+        // precondition: s >= 0
+        uint_n r;
+        if (std::size_t(s) >= Bits) return r;
+        std::size_t const w = std::size_t(s) / 64;
+        int const b = s % 64;
+        for (std::size_t i = limbs; i-- > w; ) {
+            std::uint64_t const lo = i > w ? a.limb[i - w - 1] : 0;
+            r.limb[i] = b == 0 ? a.limb[i - w] : (a.limb[i - w] << b) | (lo >> (64 - b));
+        }
+        return r;
+    }
+
+    friend constexpr
+    uint_n operator>>(uint_n const& a, int s) {
+        // precondition: s >= 0
+        uint_n r;
+        if (std::size_t(s) >= Bits) return r;
+        std::size_t const w = std::size_t(s) / 64;
+        int const b = s % 64;
+        for (std::size_t i = 0; i + w < limbs; ++i) {
+            std::uint64_t const hi = i + w + 1 < limbs ? a.limb[i + w + 1] : 0;
+            r.limb[i] = b == 0 ? a.limb[i + w] : (a.limb[i + w] >> b) | (hi << (64 - b));
+        }
+        return r;
+    }
+
+    // Comparisons ----------------------
+
+    friend constexpr
+    bool operator==(uint_n const& a, uint_n const& b) {
+        std::uint64_t d = 0;
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t i = 0; i < limbs; ++i) d |= a.limb[i] ^ b.limb[i];
+        return d == 0;
+    }
+
+    friend constexpr
+    bool operator!=(uint_n const& a, uint_n const& b) { return !(a == b); }
+
+    // The borrow of a - b, no branches.
+    friend constexpr
+    bool operator<(uint_n const& a, uint_n const& b) {
+        std::uint64_t borrow = 0;
+        TAO_ALGORITHM_UNROLL
+        for (std::size_t i = 0; i < limbs; ++i) detail::subtract_borrow(a.limb[i], b.limb[i], borrow);
+        return borrow != 0;
+    }
+
+    friend constexpr
+    bool operator>(uint_n const& a, uint_n const& b) { return b < a; }
+
+    friend constexpr
+    bool operator<=(uint_n const& a, uint_n const& b) { return !(b < a); }
+
+    friend constexpr
+    bool operator>=(uint_n const& a, uint_n const& b) { return !(a < b); }
+
+    // Assignments ----------------------
+
+    constexpr uint_n& operator+=(uint_n const& x) { return *this = *this + x; }
+    constexpr uint_n& operator-=(uint_n const& x) { return *this = *this - x; }
+    constexpr uint_n& operator*=(uint_n const& x) { return *this = *this * x; }
+    constexpr uint_n& operator/=(uint_n const& x) { return *this = *this / x; }
+    constexpr uint_n& operator%=(uint_n const& x) { return *this = *this % x; }
+    constexpr uint_n& operator&=(uint_n const& x) { return *this = *this & x; }
+    constexpr uint_n& operator|=(uint_n const& x) { return *this = *this | x; }
+    constexpr uint_n& operator^=(uint_n const& x) { return *this = *this ^ x; }
+    constexpr uint_n& operator<<=(int s) { return *this = *this << s; }
+    constexpr uint_n& operator>>=(int s) { return *this = *this >> s; }
+
+    constexpr
+    uint_n& operator++() {
+        for (auto& x : limb) if (++x != 0) break;
+        return *this;
+    }
+
+    constexpr
+    uint_n& operator--() {
+        for (auto& x : limb) if (x-- != 0) break;
+        return *this;
+    }
+
+    constexpr
+    uint_n operator++(int) {
+        uint_n r = *this;
+        ++*this;
+        return r;
+    }
+
+    constexpr
+    uint_n operator--(int) {
+        uint_n r = *this;
+        --*this;
+        return r;
+    }
+
+    std::uint64_t limb[limbs] = {};
+};
+
+// The full product, no bits are lost.
+template <std::size_t A, std::size_t B>
+constexpr
+uint_n<A + B> wide_multiply(uint_n<A> const& a, uint_n<B> const& b) {
+    uint_n<A + B> r;
+    detail::multiply_limbs(a.limb, b.limb, r.limb);
+    return r;
+}
+
+template <std::size_t Bits>
+inline constexpr
+bool even(uint_n<Bits> const& a) { return (a.limb[0] & 1) == 0; }
+
+template <std::size_t Bits>
+inline constexpr
+bool odd(uint_n<Bits> const& a) { return (a.limb[0] & 1) != 0; }
+
+template <std::size_t Bits>
+inline constexpr
+uint_n<Bits> half(uint_n<Bits> const& n) { return n >> 1; }
+
+template <std::size_t Bits>
+inline constexpr
+bool zero(uint_n<Bits> const& a) { return a.is_zero(); }
+
+template <std::size_t Bits>
+std::string to_string(uint_n<Bits> x) {
+    // Base 10^19 digits, the largest power of ten in a limb.
+    std::uint64_t const base = 10000000000000000000ull;
+    std::string r;
+    do {
+        std::uint64_t rem = 0;
+        for (std::size_t i = uint_n<Bits>::limbs; i-- > 0; ) {
+            x.limb[i] = detail::divide_128(rem, x.limb[i], base, rem);
+        }
+        bool const last = x.is_zero();
+        for (int i = 0; i < 19 && ( ! last || rem != 0 || i == 0); ++i) {
+            r.push_back(char('0' + rem % 10));
+            rem /= 10;
+        }
+    } while ( ! x.is_zero());
+    return std::string(r.rbegin(), r.rend());
+}
+
+template <std::size_t Bits>
+std::ostream& operator<<(std::ostream& os, uint_n<Bits> const& x) {
+    return os << to_string(x);
+}
+
+using uint128_t = uint_n<128>;
+using uint256_t = uint_n<256>;
+
+namespace detail {
+
+template <std::size_t Bits>
+struct wider_unsigned<uint_n<Bits>> { using type = uint_n<2 * Bits>; };
+
+} // namespace detail
+
+}} /*tao::algorithm*/
+
+namespace std {
+
+template <std::size_t Bits>
+class numeric_limits<tao::algorithm::uint_n<Bits>> {
+public:
+    using type = tao::algorithm::uint_n<Bits>;
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = false;
+    static constexpr bool is_integer = true;
+    static constexpr bool is_exact = true;
+    static constexpr bool is_bounded = true;
+    static constexpr bool is_modulo = true;
+    static constexpr int radix = 2;
+    static constexpr int digits = int(Bits);
+    static constexpr int digits10 = int(Bits * 643 / 2136);     // floor(Bits log10(2))
+    static constexpr type min() noexcept { return type(); }
+    static constexpr type lowest() noexcept { return type(); }
+    static constexpr type max() noexcept { return ~type(); }
+};
+
+} // namespace std
+
+#endif /*TAO_ALGORITHM_UINT_N_HPP_*/
+
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+
+#include <cstdint>
+#include <random>
+#include <sstream>
+
+TEST_CASE("[uint_n] testing uint_n<128> against unsigned __int128") {
+    using namespace tao::algorithm;
+    using U = uint_n<128>;
+    using W = unsigned __int128;
+
+    std::mt19937_64 eng(7);
+    auto random = [&]() -> W {
+        // Mix of small, large and sparse limbs, the corner cases of algorithm D.
+        W const x = (W(eng()) << 64) | eng();
+        switch (eng() % 5) {
+            case 0: return x >> (eng() % 128);
+            case 1: return W(eng() % 3) << 64 | eng() % 3;
+            case 2: return ~W(0) - eng() % 3;
+            case 3: return W(~std::uint64_t(0)) << 64 | (eng() % 2);
+            default: return x;
+        }
+    };
+
+    for (int i = 0; i < 20000; ++i) {
+        W const a = random();
+        W const b = random();
+        int const s = int(eng() % 128);
+        CHECK((W(U(a) + U(b)) == W(a + b)));
+        CHECK((W(U(a) - U(b)) == W(a - b)));
+        CHECK((W(U(a) * U(b)) == W(a * b)));
+        CHECK((W(U(a) << s) == W(a << s)));
+        CHECK((W(U(a) >> s) == W(a >> s)));
+        CHECK((W(U(a) & U(b)) == W(a & b)));
+        CHECK((W(U(a) ^ U(b)) == W(a ^ b)));
+        CHECK((U(a) < U(b)) == (a < b));
+        CHECK((U(a) == U(b)) == (a == b));
+        if (b != 0) {
+            auto const qr = quotient_remainder(U(a), U(b));
+            CHECK((W(qr.first) == a / b));
+            CHECK((W(qr.second) == a % b));
+        }
+    }
+
+    CHECK(U(-1) == std::numeric_limits<U>::max());
+    // Signed 128-bit values keep their high limb and are sign extended.
+    __int128 const big = (__int128(3) << 64) + 5;
+    CHECK((W(U(big)) == W(big)));
+    CHECK((W(U(-big)) == W(-big)));
+    CHECK(uint_n<256>(big) == (uint_n<256>(3) << 64) + uint_n<256>(5));
+    CHECK(uint_n<256>(-big) == uint_n<256>(0) - uint_n<256>(big));
+    CHECK(uint_n<64>(big) == uint_n<64>(5));
+    CHECK(odd(U(7)));
+    CHECK(even(U(1) << 100));
+    CHECK(half(U(1) << 100) == U(1) << 99);
+    U x = 0;
+    --x;
+    CHECK(x == ~U(0));
+    ++x;
+    CHECK(x == U(0));
+}
+
+TEST_CASE("[uint_n] testing uint_n<256> identities, division and decimal strings") {
+    using namespace tao::algorithm;
+    using U = uint_n<256>;
+
+    char const* const p = "115792089237316195423570985008687907853269984665640564039457584007913129639747";
+    U const big = U::from_decimal(p);                   // 2^256 - 189
+    CHECK(big == ~U(0) - U(188));
+    CHECK(to_string(big) == p);
+    CHECK(to_string(U(0)) == "0");
+    CHECK(to_string(U(10000000000000000000ull)) == "10000000000000000000");
+    std::ostringstream os;
+    os << (U(1) << 128);
+    CHECK(os.str() == "340282366920938463463374607431768211456");
+
+    std::mt19937_64 eng(11);
+    for (int i = 0; i < 5000; ++i) {
+        U a;
+        U b;
+        for (auto& x : a.limb) x = eng();
+        for (auto& x : b.limb) x = eng();
+        b = b >> int(eng() % 256);
+        if (b == U(0)) continue;
+        auto const qr = quotient_remainder(a, b);
+        CHECK(qr.second < b);
+        CHECK(qr.first * b + qr.second == a);
+        auto const w = wide_multiply(qr.first, b);
+        CHECK(uint_n<256>(w >> 256) == U(0));
+        CHECK((a - b) + b == a);
+        CHECK(a * (b + U(1)) == a * b + a);
+    }
+    CHECK(U(3) * U(5) % U(7) == U(1));
+    CHECK(wide_multiply(~U(0), ~U(0)) == (~uint_n<512>(0) << 257) + uint_n<512>(1));     // (2^256 - 1)^2
+}
+
+#endif /*DOCTEST_LIBRARY_INCLUDED*/
@@ -5,6 +5,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_NO_POSIX_SIGNALS
 #include "doctest.h"
 
 // struct no_natural_order {
@@ -13,8 +14,8 @@
 // };
 
 // #include <tao/algorithm/copy.hpp>
-// #include <tao/algorithm/count.hpp>
-// #include <tao/algorithm/primes.hpp>
+#include <tao/algorithm/count.hpp>
+#include <tao/algorithm/primes.hpp>
 
 // #include <tao/algorithm/rotate.hpp>
 // #include <tao/algorithm/rotate_one.hpp>
@@ -38,3 +39,23 @@
 // #include <tao/algorithm/toys/palindrome.hpp>
 
 #include <tao/algorithm/adjacent_swap.hpp>
+#include <tao/algorithm/histogram.hpp>
+#include <tao/algorithm/rolling_statistics.hpp>
+#include <tao/algorithm/parallel/reduce.hpp>
+#include <tao/algorithm/sorting/counter_merge_sort.hpp>
+#include <tao/algorithm/accumulate.hpp>
+#include <tao/algorithm/parallel/sieve.hpp>
+#include <tao/algorithm/prime_batch.hpp>
+#include <tao/algorithm/parallel/prime_batch.hpp>
+#include <tao/algorithm/factorize.hpp>
+#include <tao/algorithm/power.hpp>
+#include <tao/algorithm/matrix.hpp>
+#include <tao/algorithm/uint_n.hpp>
+#include <tao/algorithm/search.hpp>
+#include <tao/algorithm/multi_search.hpp>
+#include <tao/algorithm/run_length.hpp>
+#include <tao/algorithm/remove_range.hpp>
+#include <tao/algorithm/find.hpp>
+#include <tao/algorithm/parallel/find.hpp>
+#include <tao/algorithm/partition/partition_point.hpp>
+#include <tao/algorithm/partition/static_index.hpp>